@@ -1,8 +1,15 @@
 #include "Application.h"
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstring>
 #include "Window.h"
 #include "GfxDevice.h"
 #include "FileLoader.h"
+#include "VkObjectTracker.h"
+#include "StartupProfiler.h"
+#include "PipelineFeedback.h"
+#include "ShaderSource.h"
 
 #include "imgui.h"
 #include "GLFW/glfw3.h"
@@ -14,6 +21,10 @@
 
 #define USE_RENDERPASS (1)
 
+static_assert(OverdrawView::sFrameCount == sInflightFrames);
+static_assert(PresentLatencyTracker::sFrameCount == sInflightFrames);
+static_assert(PipelineManager::sRetireFrameDelay > sInflightFrames);
+
 
 //---------------------------------------------------------------------------
 VkResult CreateDebugUtilsMessengerEXT(VkInstance instance, const VkDebugUtilsMessengerCreateInfoEXT* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkDebugUtilsMessengerEXT* pDebugMessenger) {
@@ -35,12 +46,21 @@ void DestroyDebugUtilsMessengerEXT(VkInstance instance, VkDebugUtilsMessengerEXT
 //---------------------------------------------------------------------------
 void Application::Initialize()
 {
+    // N̊etF[Yv
+    auto& profiler = getStartupProfiler();
+
+    profiler->beginPhase("window");
     initializeWindow_();
+    profiler->endPhase();
+
+    profiler->beginPhase("gfx_device");
     initializeGfxDevice_();
+    profiler->endPhase();
 
     mIsInitialized = true;
 
     // ImGui
+    profiler->beginPhase("imgui_context");
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGui::StyleColorsDark();
@@ -50,19 +70,62 @@ void Application::Initialize()
         GLFWwindow* glfw_window = window->getPlatformHandle()->window;
         ImGui_ImplGlfw_InitForVulkan(glfw_window, true);
     }
+    profiler->endPhase();
 
+    profiler->beginPhase("swapchain");
     createSwapchain_();
     createImageViews_();
+    mPresentLatency.initialize(getGfxDevice().get());
+    mPresentLatency.start(mSwapchain);
+    profiler->endPhase();
 #ifdef USE_RENDERPASS
     // Dynamic RenderinggȂꍇAVkRenderPass̏Kv
+    profiler->beginPhase("render_pass");
     createRenderPass_();
+    profiler->endPhase();
 #endif
+    profiler->beginPhase("descriptor_set_layout");
+    getBindlessDescriptors()->initialize(getGfxDevice().get(),
+        mIsDescriptorBufferRequested ? DescriptorBackend::DescriptorBuffer : DescriptorBackend::Pool);
+    mUseBindless = getBindlessDescriptors()->isEnabled();
     createDescriptorSetLayout_();
+    mFrameDescriptors.initialize(getGfxDevice().get(), static_cast<uint32_t>(sInflightFrames), mShaderLayout->getPoolSizes(0, 1), "FrameDescriptors");
+    profiler->endPhase();
+
+    profiler->beginPhase("geometry_pool");
+    // bV̒_ƃCfbNX͑S1̒_obt@1̃CfbNXobt@ɒu
+    getGeometryPool()->initialize(getGfxDevice().get());
+    profiler->endPhase();
+
+    auto& gfx_device = getGfxDevice();
+    profiler->beginPhase("overdraw_view");
+    // descriptor buffer ̃Zbg͒ʏ̃fBXNv^Zbg (I[o[h[̃JE^) ƓpCvCCAEgɒuȂ
+    // ȂΔΉƂĈ
+    if (getBindlessDescriptors()->getBackend() != DescriptorBackend::DescriptorBuffer)
+    {
+        mOverdrawView.initialize(gfx_device.get(), mRenderPass, mSwapchainExtent);
+    }
+    profiler->endPhase();
+
+    profiler->beginPhase("pipeline");
+    getPipelineManager()->initialize(gfx_device.get());
     createGraphicsPipeline_();
+    updateMainPermutation_();
+    profiler->endPhase();
+
+#ifndef NDEBUG
+    // VF[_[ҏWƍăRpCăpCvCւ
+    // JÕRs[gpCvC PipelineManager ̊ǗOȂ̂Ōʂɒm点
+    mShaderHotReload.addReloadCallback([this](const std::string& spvPath) { mGpuDrivenScene.reloadShader(spvPath); });
+    mShaderHotReload.start();
+#endif
+
+    profiler->beginPhase("framebuffers");
     createFramebuffers_();
     createCommandPool_();
+    profiler->endPhase();
 
-    auto& gfx_device = getGfxDevice();
+    profiler->beginPhase("imgui_vulkan");
     ImGui_ImplVulkan_LoadFunctions(
         [](const char* functionName, void* userArgs) {
             auto& dev = getGfxDevice();
@@ -104,24 +167,37 @@ void Application::Initialize()
 #endif
 
     ImGui_ImplVulkan_Init(&impl_vulkakn_init_info);
+    profiler->endPhase();
+
+    profiler->beginPhase("imgui_fonts");
     ImGui_ImplVulkan_CreateFontsTexture();
+    profiler->endPhase();
 
     // AvP[VR[h
+    profiler->beginPhase("texture_load");
     prepareTriangle_();
+    profiler->endPhase();
+
+    registerMetrics_();
 }
 //---------------------------------------------------------------------------
 void Application::Shutdown()
 {
     auto& gfx_device = getGfxDevice();
+    mShaderHotReload.stop();
     gfx_device->waitForIdle();
 
     auto vkDevice = gfx_device->getVkDevice();
 
     // _obt@j
 	rect.destroy(gfx_device.get());
+    mOverdrawView.destroy(gfx_device.get());
 
     cleanup_();
 
+    // R̃IuWFNgo
+    getVkObjectTracker()->reportLiveObjects();
+
     // ImGuiI
     ImGui_ImplVulkan_Shutdown();
     ImGui_ImplGlfw_Shutdown();
@@ -135,6 +211,23 @@ void Application::Shutdown()
     mIsInitialized = false;
 }
 //---------------------------------------------------------------------------
+void Application::registerMetrics_()
+{
+    auto& metrics = getMetricsRegistry();
+    mFrameCountMetric = metrics->counter("frames_total", "Number of frames rendered");
+    mFrameTimeMetric = metrics->histogram("frame_time_ms", "CPU frame interval in milliseconds",
+        { 2.0, 4.0, 8.0, 12.0, 16.7, 20.0, 25.0, 33.3, 50.0, 100.0, 250.0 });
+
+    // gpʂ͏o͂̃^C~OŏWvΏ\
+    auto* device_memory = metrics->gauge("device_memory_bytes", "Live VkDeviceMemory allocations in bytes");
+    auto* live_objects = metrics->gauge("vk_live_objects", "Number of live tracked Vulkan objects");
+    metrics->addCollector([device_memory, live_objects]() {
+        auto& tracker = getVkObjectTracker();
+        device_memory->set(double(tracker->getLiveBytes(VK_OBJECT_TYPE_DEVICE_MEMORY)));
+        live_objects->set(double(tracker->getLiveCount()));
+    });
+}
+//---------------------------------------------------------------------------
 void Application::initializeWindow_()
 {
     auto& window = getAppWindow();
@@ -151,8 +244,12 @@ void Application::initializeGfxDevice_()
     auto& window = getAppWindow();
     device_init_params.glfwWindow = window->getPlatformHandle()->window;
 
+    device_init_params.requestShaderObject = mIsShaderObjectRequested;
+    device_init_params.requestDescriptorBuffer = mIsDescriptorBufferRequested;
+
     auto& gfx_device = getGfxDevice();
     gfx_device->Initialize(device_init_params);
+    mUseShaderObject = gfx_device->isShaderObjectEnabled();
 }
 //---------------------------------------------------------------------------
 void Application::process()
@@ -170,6 +267,11 @@ void Application::prepareTriangle_()
 
     // _obt@̍쐬
     rect.initialize(gfx_device.get());
+    // בւ̃f̓eNX`̔ԍ܂ɍ
+    if (mSpriteBatcher.isInitialized())
+    {
+        createDrawQueueDemo_();
+    }
 }
 //---------------------------------------------------------------------------
 void Application::createSwapchain_()
@@ -217,6 +319,7 @@ void Application::createSwapchain_()
     if (vkCreateSwapchainKHR(getGfxDevice()->getVkDevice(), &createInfo, nullptr, &mSwapchain) != VK_SUCCESS) {
         throw std::runtime_error("failed to create swap chain!");
     }
+    getVkObjectTracker()->onCreate(mSwapchain, VK_OBJECT_TYPE_SWAPCHAIN_KHR);
 
     vkGetSwapchainImagesKHR(getGfxDevice()->getVkDevice(), mSwapchain, &image_count, nullptr);
     mSwapchainImages.resize(image_count);
@@ -329,6 +432,7 @@ VkImageView Application::createImageView_(VkImage image, VkFormat format)
     if (vkCreateImageView(device, &create_info, nullptr, &image_view) != VK_SUCCESS) {
         throw std::runtime_error("failed to create image view!");
     }
+    getVkObjectTracker()->onCreate(image_view, VK_OBJECT_TYPE_IMAGE_VIEW);
 	return image_view;
 }
 //---------------------------------------------------------------------------
@@ -348,6 +452,7 @@ void Application::createRenderPass_()
       .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
       .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
     };
+    VkAttachmentDescription load_color_attachment = color_attachment;
     VkAttachmentReference color_attachment_reference{
       .attachment = 0,
       .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
@@ -359,13 +464,25 @@ void Application::createRenderPass_()
       .pColorAttachments = &color_attachment_reference,
     };
 
-    VkSubpassDependency dependency{
-      .srcSubpass = VK_SUBPASS_EXTERNAL,
-	  .dstSubpass = 0,
-	  .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-	  .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-	  .srcAccessMask = 0,
-	  .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+    std::array<VkSubpassDependency, 2> dependencies{
+      VkSubpassDependency{
+        .srcSubpass = VK_SUBPASS_EXTERNAL,
+        .dstSubpass = 0,
+        .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        .srcAccessMask = 0,
+        .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+      },
+      // I[o[h[\: V[`ŉZJE^q[g}bvœǂނ߂̎Ȉˑ
+      VkSubpassDependency{
+        .srcSubpass = 0,
+        .dstSubpass = 0,
+        .srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        .dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+        .dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT,
+      },
     };
 
     VkRenderPassCreateInfo render_pass_create_info{
@@ -374,182 +491,265 @@ void Application::createRenderPass_()
       .pAttachments = &color_attachment,
       .subpassCount = 1,
       .pSubpasses = &subpass,
-	  .dependencyCount = 1,
-	  .pDependencies = &dependency,
+	  .dependencyCount = static_cast<uint32_t>(dependencies.size()),
+	  .pDependencies = dependencies.data(),
     };
 
     if(vkCreateRenderPass(device, &render_pass_create_info, nullptr, &mRenderPass) != VK_SUCCESS)
     {
         throw std::runtime_error("failed to create render pass!");
 	}
+    getVkObjectTracker()->onCreate(mRenderPass, VK_OBJECT_TYPE_RENDER_PASS);
+    gfx_device->setObjectName(uint64_t(mRenderPass), "MainRenderPass", VK_OBJECT_TYPE_RENDER_PASS);
+
+    if (!mUseShaderObject)
+    {
+        return;
+    }
+
+    // VF[_[IuWFNgŕ`悵V[̏ɑĕ`߂̂
+    // [h/XgAƃCAEgȊO͓Ȃ̂ mRenderPass ƌ݊At[obt@pCvCLł
+    load_color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    load_color_attachment.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    // V[̃J[o͂ƃI[o[h[JE^݂̏҂
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[0].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+    render_pass_create_info.pAttachments = &load_color_attachment;
+
+    if (vkCreateRenderPass(device, &render_pass_create_info, nullptr, &mRenderPassLoad) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create render pass!");
+    }
+    getVkObjectTracker()->onCreate(mRenderPassLoad, VK_OBJECT_TYPE_RENDER_PASS);
+    gfx_device->setObjectName(uint64_t(mRenderPassLoad), "LoadRenderPass", VK_OBJECT_TYPE_RENDER_PASS);
 }
 //---------------------------------------------------------------------------
 void Application::createDescriptorSetLayout_()
 {
-    auto& gfx_device = getGfxDevice();
-    auto device = gfx_device->getVkDevice();
-
-    VkDescriptorSetLayoutBinding ubo{
-      .binding = 0,
-      .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-      .descriptorCount = 1,
-      .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
-	  .pImmutableSamplers = nullptr,
-    };
-
-    VkDescriptorSetLayoutBinding sampler{
-      .binding = 1,
-      .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-      .descriptorCount = 1,
-      .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
-      .pImmutableSamplers = nullptr,
-    };
+    // oCfBO̓VF[_[ SPIR-V ǂݎ
+    auto& layout_cache = getPipelineLayoutCache();
+    layout_cache->initialize(getGfxDevice().get());
+    mShaderLayout = &layout_cache->getShaderLayout({ "res/shader.vert.spv", "res/shader.frag.spv" });
+    mDescriptorSetLayout = mShaderLayout->setLayouts.empty()
+        ? layout_cache->getDescriptorSetLayout({})
+        : mShaderLayout->setLayouts[0];
+
+    // oChX̏ꍇAZbg 0 ͑SẴ\[X܂ދʂ̃Zbg
+    if (mUseBindless)
+    {
+        mDescriptorSetLayout = getBindlessDescriptors()->getDescriptorSetLayout();
+        return;
+    }
 
-	std::array<VkDescriptorSetLayoutBinding, 2> bindings = { ubo, sampler };
-    VkDescriptorSetLayoutCreateInfo layout_create_info{
-      .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-      .bindingCount = static_cast<uint32_t>(bindings.size()),
-      .pBindings = bindings.data(),
-	};
+    // XVev[gɓnzł̈ʒu߂Ă (ނ̂̓eNX`)
+    mSceneDescriptorData.assign(mShaderLayout->getDescriptorDataCount(0), DescriptorData{});
+    mSceneTextureIndex = UINT32_MAX;
+    std::vector<ReflectedBinding> set_bindings;
+    for (const auto& binding : mShaderLayout->bindings)
+    {
+        if (binding.set != 0)
+        {
+            continue;
+        }
+        set_bindings.push_back(binding);
+        if (binding.type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
+        {
+            mSceneTextureIndex = mShaderLayout->getDescriptorDataIndex(0, binding.binding);
+        }
+        else
+        {
+            // ܂ȂoCfBOcƕsȃfBXNv^ŕ`悷邱ƂɂȂ
+            // (UBO ̃obt@͂̃Avł͍ĂȂ̂ŁAVF[_[ UBO 錾ꍇŒe)
+            fprintf(stderr, "[Application] set 0 binding %u has an unsupported descriptor type %d\n", binding.binding, binding.type);
+            throw std::runtime_error("unsupported descriptor type in scene shader!");
+        }
+    }
 
-    if(vkCreateDescriptorSetLayout(device, &layout_create_info, nullptr, &mDescriptorSetLayout) != VK_SUCCESS)
+    // `斈ɕςZbgȂ̂ŁAvbVfBXNv^g΃Zbg̊蓖Ă߂ăR}hobt@ɒڏ
+    auto& gfx_device = getGfxDevice();
+    mUsePushDescriptor =
+        gfx_device->isPushDescriptorEnabled() &&
+        !set_bindings.empty() &&
+        mSceneDescriptorData.size() <= gfx_device->getMaxPushDescriptors();
+    if (mUsePushDescriptor)
     {
-        throw std::runtime_error("failed to create descriptor set layout!");
-	}
+        mDescriptorSetLayout = layout_cache->getDescriptorSetLayout(set_bindings, VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR);
+    }
 }
 //---------------------------------------------------------------------------
 void Application::createGraphicsPipeline_()
 {
-    auto createShaderModule_ = [this](const std::vector<char>& code) -> const VkShaderModule {
-        VkShaderModuleCreateInfo create_info{
-            .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-            .codeSize = code.size(),
-            .pCode = reinterpret_cast<const uint32_t*>(code.data()),
-		};
+    auto& layout_cache = getPipelineLayoutCache();
+    const std::vector<VkPushConstantRange> push_constant_ranges = mUseBindless
+        ? std::vector<VkPushConstantRange>{ BindlessDescriptors::getPushConstantRange() }
+        : mShaderLayout->pushConstantRanges;
+    mPipelineLayout = layout_cache->getPipelineLayout({ mDescriptorSetLayout }, push_constant_ranges);
+    if (!mUseBindless)
+    {
+        // vbVfBXNv^̃ev[g̓vbṼpCvCCAEgƌѕt
+        mSceneUpdateTemplate = layout_cache->getDescriptorUpdateTemplate(mDescriptorSetLayout, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout, 0);
+    }
 
-        VkShaderModule shader_module;
-        if (vkCreateShaderModule(getGfxDevice()->getVkDevice(), &create_info, nullptr, &shader_module) != VK_SUCCESS)
+    // _obt@̃zu Vertex ߂̂ŁAVF[_[̓͂ƐHĂȂmF
+    auto binding_description = Vertex::getBindingDescription();
+    auto attribute_descriptions = Vertex::getAttributeDescriptions();
+    for (const auto& input : mShaderLayout->vertexInputs)
+    {
+        auto it = std::find_if(attribute_descriptions.begin(), attribute_descriptions.end(), [&](const VkVertexInputAttributeDescription& attribute) {
+            return attribute.location == input.location;
+        });
+        if (it == attribute_descriptions.end() || it->format != input.format)
         {
-            throw std::runtime_error("failed to create shader module!");
+            fprintf(stderr, "[Application] vertex input location %u does not match Vertex attributes\n", input.location);
         }
-		return shader_module;
-    };
-
-    std::vector<char> vert_shader_code, frag_shader_code;
-    getFileLoader()->Load("res/shader.vert.spv", vert_shader_code);
-    getFileLoader()->Load("res/shader.frag.spv", frag_shader_code);
-
-	auto vert_shader_module = createShaderModule_(vert_shader_code);
-    auto frag_shader_module = createShaderModule_(frag_shader_code);
-    
-    VkPipelineShaderStageCreateInfo vert_shader_stage_info{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-        .stage = VK_SHADER_STAGE_VERTEX_BIT,
-        .module = vert_shader_module,
-        .pName = "main",
-    };
-    VkPipelineShaderStageCreateInfo frag_shader_stage_info{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-        .stage = VK_SHADER_STAGE_FRAGMENT_BIT,
-        .module = frag_shader_module,
-        .pName = "main",
-    };
+    }
 
-    std::array<VkPipelineShaderStageCreateInfo, 2> shader_stages = { vert_shader_stage_info, frag_shader_stage_info };
-    
-	auto binding_description = Vertex::getBindingDescription();
-	auto attribute_descriptions = Vertex::getAttributeDescriptions();
-    VkPipelineVertexInputStateCreateInfo vertex_input_info{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-		.vertexBindingDescriptionCount = 1,
-		.pVertexBindingDescriptions = &binding_description,
-		.vertexAttributeDescriptionCount = static_cast<uint32_t>(attribute_descriptions.size()),
-		.pVertexAttributeDescriptions = attribute_descriptions.data(),
-	};
-
-    VkPipelineInputAssemblyStateCreateInfo input_assembly_info{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+    GraphicsPipelineDesc desc{
+        .vertexShader = "res/shader.vert.spv",
+        .fragmentShader = mUseBindless ? "res/bindless.frag.spv" : "res/shader.frag.spv",
+        .vertexBindings = { binding_description },
+        .vertexAttributes = { attribute_descriptions.begin(), attribute_descriptions.end() },
         .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
-        .primitiveRestartEnable = VK_FALSE,
-	};
-
-    VkPipelineViewportStateCreateInfo viewport_state_info{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
-        .viewportCount = 1,
-        .scissorCount = 1,
-    };
-
-    VkPipelineRasterizationStateCreateInfo rasterizer_info{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
-        .depthClampEnable = VK_FALSE,
-        .rasterizerDiscardEnable = VK_FALSE,
-        .polygonMode = VK_POLYGON_MODE_FILL,
         .cullMode = VK_CULL_MODE_BACK_BIT,
         .frontFace = VK_FRONT_FACE_CLOCKWISE,
-        .depthBiasEnable = VK_FALSE,
-		.lineWidth = 1.0f,
-	};
-
-    VkPipelineMultisampleStateCreateInfo multisampling_info{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
-        .sampleShadingEnable = VK_FALSE,
+#ifdef USE_RENDERPASS
+        .renderPass = mRenderPass,
+#endif
+        .colorFormat = mSwapchainImageFormat,
+        .layout = mPipelineLayout,
+        .flags = getBindlessDescriptors()->getPipelineCreateFlags(),
+        .debugName = "MainPipeline",
     };
+    desc.permutation = MainShaderPermutation{}.build();
+    // oAg̓ꉻ萔͎ۂɎgtOgVF[_[ (oChX̏ꍇ bindless.frag) Ŋm߂
+    // oChX̃VF[_[̓Zbg 0 ̍\ shader.vert ƈقȂ ShaderLayout ɂ܂Ƃ߂Ȃ̂ŁAPƂœǂ
+    ShaderReflection fragment_reflection;
+    const bool is_permutation_supported = fragment_reflection.loadFromFile(desc.fragmentShader) &&
+        std::all_of(desc.permutation.getConstants().begin(), desc.permutation.getConstants().end(), [&](const SpecializationConstant& constant) {
+            const auto& ids = fragment_reflection.getSpecializationConstantIds();
+            return std::binary_search(ids.begin(), ids.end(), constant.constantId);
+        });
+    if (!is_permutation_supported)
+    {
+        fprintf(stderr, "[Application] main shader has no specialization constants, recompile res/ with compileShader.bat\n");
+    }
+    mMainPipelineDesc = desc;
 
-    VkPipelineColorBlendAttachmentState color_blend_attachment{
-        .blendEnable = VK_FALSE,
-        .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
-    };
+    GraphicsPipelineDesc overdraw_desc = desc;
+    if (mOverdrawView.isSupported())
+    {
+        // set 0 ƃvbV萔 mPipelineLayout ƓȂ̂ŁAob`ނ̃oAg̃CAEgg
+        mOverdrawPipelineLayout = layout_cache->getPipelineLayout({ mDescriptorSetLayout, mOverdrawView.getDescriptorSetLayout() }, push_constant_ranges);
+        overdraw_desc = OverdrawView::makePipelineDesc(desc, mOverdrawPipelineLayout);
+        overdraw_desc.debugName = "OverdrawPipeline";
+        mOverdrawPipelineDesc = overdraw_desc;
+    }
 
-    VkPipelineColorBlendStateCreateInfo color_blending_info{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
-        .logicOpEnable = VK_FALSE,
-        .attachmentCount = 1,
-        .pAttachments = &color_blend_attachment,
-        .blendConstants = {0.0f},
-    };
+    // VF[_[IuWFNggꍇAV[̃pCvC͍Ȃ (NԂ̔r̂)
+    if (mUseShaderObject)
+    {
+        auto& shader_object_renderer = getShaderObjectRenderer();
+        shader_object_renderer->initialize(getGfxDevice().get());
+        if (!shader_object_renderer->prepare(desc))
+        {
+            throw std::runtime_error("failed to create shader objects!");
+        }
+        if (mOverdrawView.isSupported())
+        {
+            shader_object_renderer->prepare(overdraw_desc);
+        }
+        return;
+    }
 
-    std::vector<VkDynamicState> dynamic_states = {
-        VK_DYNAMIC_STATE_VIEWPORT,
-        VK_DYNAMIC_STATE_SCISSOR,
-	};
-    VkPipelineDynamicStateCreateInfo dynamic_state_info{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-        .dynamicStateCount = static_cast<uint32_t>(dynamic_states.size()),
-        .pDynamicStates = dynamic_states.data(),
-	};
-
-    VkPipelineLayoutCreateInfo pipeline_layout_info{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        .setLayoutCount = 1,
-		.pSetLayouts = &mDescriptorSetLayout,
-	};
-
-    if(vkCreatePipelineLayout(getGfxDevice()->getVkDevice(), &pipeline_layout_info, nullptr, &mPipelineLayout) != VK_SUCCESS)
-    {
-        throw std::runtime_error("failed to create pipeline layout!");
-    }
-
-    VkGraphicsPipelineCreateInfo pipeline_info{
-        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-        .stageCount = static_cast<uint32_t>(shader_stages.size()),
-        .pStages = shader_stages.data(),
-        .pVertexInputState = &vertex_input_info,
-        .pInputAssemblyState = &input_assembly_info,
-        .pViewportState = &viewport_state_info,
-        .pRasterizationState = &rasterizer_info,
-        .pMultisampleState = &multisampling_info,
-        .pColorBlendState = &color_blending_info,
-        .layout = mPipelineLayout,
-        .renderPass = mRenderPass,
-        .subpass = 0,
-    };
-    if (vkCreateGraphicsPipelines(getGfxDevice()->getVkDevice(), VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &mPipeline) != VK_SUCCESS)
+    // C̃pCvC͍ŏ̃t[KvȂ̂Ŋ܂ő҂
+    auto& pipeline_manager = getPipelineManager();
+    mPipeline = pipeline_manager->requestPipeline(desc);
+    if (pipeline_manager->waitPipeline(mPipeline) == VK_NULL_HANDLE)
     {
         throw std::runtime_error("failed to create graphics pipeline!");
     }
-    vkDestroyShaderModule(getGfxDevice()->getVkDevice(), vert_shader_module, nullptr);
-	vkDestroyShaderModule(getGfxDevice()->getVkDevice(), frag_shader_module, nullptr);
+    mPermutationPipelines.emplace(desc.permutation.getKey(), mPipeline);
+
+    // I[o[h[\p̃oAg̓obNOEhŃRpCĂ
+    if (mOverdrawView.isSupported())
+    {
+        mOverdrawPipeline = pipeline_manager->requestPipeline(overdraw_desc);
+    }
+
+    // _VF[_[AhXœǂރoAg
+    // _͂Ȃ̂ŁA_̒u`ςĂpCvC1ōς (̃oAgpӂ)
+    if (mUseBindless && getGfxDevice()->isBufferDeviceAddressEnabled())
+    {
+        mVertexPullPipelineDesc = desc;
+        mVertexPullPipelineDesc.vertexShader = "res/vertex_pull.vert.spv";
+        mVertexPullPipelineDesc.vertexBindings.clear();
+        mVertexPullPipelineDesc.vertexAttributes.clear();
+        mVertexPullPipelineDesc.debugName = "VertexPullPipeline";
+        mVertexPullPipeline = pipeline_manager->requestPipeline(mVertexPullPipelineDesc);
+    }
+
+    // `̃ob`̓eNX`̔ԍ`Ɏ̂ŃoChXKv
+    if (mUseBindless)
+    {
+        const VkPipelineLayout overdraw_layout = mOverdrawView.isSupported() ? mOverdrawPipelineLayout : VK_NULL_HANDLE;
+        mRectBatch.initialize(getGfxDevice().get(), static_cast<uint32_t>(sInflightFrames));
+        GraphicsPipelineDesc batch_desc = desc;
+        batch_desc.permutation = ShaderPermutation{};
+        // ]`̕\͋CɂȂ
+        batch_desc.cullMode = VK_CULL_MODE_NONE;
+        batch_desc.colorBlend = VkPipelineColorBlendAttachmentState{
+            .blendEnable = VK_TRUE,
+            .srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+            .dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+            .colorBlendOp = VK_BLEND_OP_ADD,
+            .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+            .dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+            .alphaBlendOp = VK_BLEND_OP_ADD,
+            .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+        };
+        batch_desc.debugName = "RectBatchPipeline";
+        mRectBatchPipeline = mRectBatch.addPipeline(batch_desc, overdraw_layout);
+
+        mSpriteBatcher.initialize(getGfxDevice().get(), static_cast<uint32_t>(sInflightFrames), desc, overdraw_layout);
+        mSpriteWorkers.start(sSpriteChunkCount - 1);
+
+        if (GpuDrivenScene::isSupported(getGfxDevice().get()))
+        {
+            batch_desc.debugName = "GpuDrivenPipeline";
+            mGpuDrivenScene.initialize(getGfxDevice().get(), static_cast<uint32_t>(sInflightFrames), batch_desc, overdraw_layout);
+        }
+    }
+}
+//---------------------------------------------------------------------------
+PipelineHandle Application::getPermutationPipeline_(const MainShaderPermutation& permutation)
+{
+    ShaderPermutation shader_permutation = permutation.build();
+    const uint64_t key = shader_permutation.getKey();
+    if (auto it = mPermutationPipelines.find(key); it != mPermutationPipelines.end())
+    {
+        return it->second;
+    }
+
+    // ߂ĎgꂽoAg̓obNOEhŃRpC
+    GraphicsPipelineDesc desc = mMainPipelineDesc;
+    desc.permutation = std::move(shader_permutation);
+    PipelineHandle handle = getPipelineManager()->requestPipeline(desc);
+    mPermutationPipelines.emplace(key, handle);
+    return handle;
+}
+//---------------------------------------------------------------------------
+void Application::updateMainPermutation_()
+{
+    if (mUseShaderObject)
+    {
+        // C̋Lq͏AVF[_[IuWFNgp̋LqɎ
+        mShaderObjectDesc = mMainPipelineDesc;
+        mShaderObjectDesc.permutation = mMainPermutation.build();
+        return;
+    }
+    mMainPermutationPipeline = getPermutationPipeline_(mMainPermutation);
 }
 //---------------------------------------------------------------------------
 void Application::createFramebuffers_()
@@ -574,6 +774,7 @@ void Application::createFramebuffers_()
         if (vkCreateFramebuffer(getGfxDevice()->getVkDevice(), &frame_buffer_create_info, nullptr, &mSwapchainFramebuffers[i]) != VK_SUCCESS) {
             throw std::runtime_error("failed to create framebuffer!");
         }
+        getVkObjectTracker()->onCreate(mSwapchainFramebuffers[i], VK_OBJECT_TYPE_FRAMEBUFFER);
     }
 }
 //---------------------------------------------------------------------------
@@ -589,15 +790,14 @@ void Application::createCommandPool_()
     if (vkCreateCommandPool(getGfxDevice()->getVkDevice(), &pool_info, nullptr, &mCommandPool) != VK_SUCCESS) {
         throw std::runtime_error("failed to create graphics command pool!");
     }
+    getVkObjectTracker()->onCreate(mCommandPool, VK_OBJECT_TYPE_COMMAND_POOL);
 }
 //---------------------------------------------------------------------------
 void Application::createDescriptorPool_()
 {
-    std::array<VkDescriptorPoolSize, 2> poolSizes{};
-    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = static_cast<uint32_t>(sInflightFrames);
-    poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = static_cast<uint32_t>(sInflightFrames);
+    // ImGui p (V[̃Zbg mFrameDescriptors 犄蓖Ă)
+    // set 0 t[mۂłTCYtNV狁߂
+    std::vector<VkDescriptorPoolSize> poolSizes = mShaderLayout->getPoolSizes(0, static_cast<uint32_t>(sInflightFrames));
 
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -608,53 +808,35 @@ void Application::createDescriptorPool_()
     if (vkCreateDescriptorPool(getGfxDevice()->getVkDevice(), &poolInfo, nullptr, &mDescriptorPool) != VK_SUCCESS) {
         throw std::runtime_error("failed to create descriptor pool!");
     }
+    getVkObjectTracker()->onCreate(mDescriptorPool, VK_OBJECT_TYPE_DESCRIPTOR_POOL);
 }
 //---------------------------------------------------------------------------
-void Application::createDescriptorSets_()
+void Application::bindSceneDescriptors_(VkCommandBuffer commandBuffer)
 {
-    std::vector<VkDescriptorSetLayout> layouts(sInflightFrames, mDescriptorSetLayout);
-    VkDescriptorSetAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocInfo.descriptorPool = mDescriptorPool;
-    allocInfo.descriptorSetCount = static_cast<uint32_t>(sInflightFrames);
-    allocInfo.pSetLayouts = layouts.data();
-
-    mDescriptorSets.resize(sInflightFrames);
-    if (vkAllocateDescriptorSets(getGfxDevice()->getVkDevice(), &allocInfo, mDescriptorSets.data()) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate descriptor sets!");
+    // ݐ̃oCfBO̓ev[gmĂ̂ŁAzɃf[^l߂邾ł悢
+    if (mSceneTextureIndex != UINT32_MAX)
+    {
+        mSceneDescriptorData[mSceneTextureIndex].image = VkDescriptorImageInfo{
+            .sampler = rect.getTextureSampler(),
+            .imageView = rect.getTextureImageView(),
+            .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        };
     }
 
-    for (size_t i = 0; i < sInflightFrames; i++) {
-        VkDescriptorBufferInfo bufferInfo{};
-        bufferInfo.buffer = uniformBuffers[i];
-        bufferInfo.offset = 0;
-        bufferInfo.range = sizeof(UniformBufferObject);
-
-        VkDescriptorImageInfo imageInfo{};
-        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfo.imageView = textureImageView;
-        imageInfo.sampler = textureSampler;
-
-        std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
-
-        descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[0].dstSet = mDescriptorSets[i];
-        descriptorWrites[0].dstBinding = 0;
-        descriptorWrites[0].dstArrayElement = 0;
-        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        descriptorWrites[0].descriptorCount = 1;
-        descriptorWrites[0].pBufferInfo = &bufferInfo;
-
-        descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[1].dstSet = mDescriptorSets[i];
-        descriptorWrites[1].dstBinding = 1;
-        descriptorWrites[1].dstArrayElement = 0;
-        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        descriptorWrites[1].descriptorCount = 1;
-        descriptorWrites[1].pImageInfo = &imageInfo;
+    if (mUsePushDescriptor)
+    {
+        // Zbg͊蓖ĂAR}hobt@ɒڋL^
+        vkCmdPushDescriptorSetWithTemplateKHR(commandBuffer, mSceneUpdateTemplate, mPipelineLayout, 0, mSceneDescriptorData.data());
+        return;
+    }
 
-        vkUpdateDescriptorSets(getGfxDevice()->getVkDevice(), static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+    // gIǗȂĂ悢悤ɁAt[Ɋ蓖Ē
+    VkDescriptorSet descriptor_set = mFrameDescriptors.allocate(mDescriptorSetLayout, mShaderLayout->getVariableDescriptorCount(0));
+    if (mSceneUpdateTemplate != VK_NULL_HANDLE)
+    {
+        vkUpdateDescriptorSetWithTemplate(getGfxDevice()->getVkDevice(), descriptor_set, mSceneUpdateTemplate, mSceneDescriptorData.data());
     }
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout, 0, 1, &descriptor_set, 0, nullptr);
 }
 //---------------------------------------------------------------------------
 void Application::createCommandBuffer_()
@@ -677,7 +859,6 @@ void Application::recordCommandBuffer_(VkCommandBuffer commandBuffer, uint32_t i
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
-    // TODO:mDescriptorSetsRectɈړ
     if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
         throw std::runtime_error("failed to begin recording command buffer!");
     }
@@ -690,6 +871,21 @@ void Application::recordCommandBuffer_(VkCommandBuffer commandBuffer, uint32_t i
     VkClearColorValue{ 0.85f, 0.5f, 0.7f, 0.0f },
     };
 
+    // I[o[h[JE^̃NA̓_[pXOōs
+    mOverdrawView.beginFrame(commandBuffer, mCurrentFrame);
+    // GPU ł̃JO_[pX̊OŁA`ŎgZbgOɍς܂
+    if (mGpuDrivenScene.isInitialized())
+    {
+        cullGpuDrivenScene_(commandBuffer);
+    }
+    mDynamicState.begin(commandBuffer, getGfxDevice()->getDynamicStateSupport());
+    // oChX̃Zbg̓R}hobt@̐擪1x
+    // V[̃pCvC̓I[o[h[p܂߂ăZbg 0 ƃvbV萔ʂȂ̂ŁAKv͂Ȃ
+    if (mUseBindless)
+    {
+        getBindlessDescriptors()->bind(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout);
+    }
+
 #if !defined(USE_RENDERPASS)
     beginRender_();
 
@@ -715,10 +911,15 @@ void Application::recordCommandBuffer_(VkCommandBuffer commandBuffer, uint32_t i
 
     vkCmdBeginRendering(current_command_buffer, &rendering_info);
 #else
+    // VF[_[IuWFNg̏ꍇ̓V[ɕ`A_[pXł͂̏ɏd˂
+    if (mUseShaderObject)
+    {
+        recordShaderObjectScene_(commandBuffer, imageIndex, clear_value);
+    }
 
     VkRenderPassBeginInfo render_pass_info{
         .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-        .renderPass = mRenderPass,
+        .renderPass = mUseShaderObject ? mRenderPassLoad : mRenderPass,
         .framebuffer = mSwapchainFramebuffers[imageIndex],
         .renderArea{
             .offset = {0, 0},
@@ -731,32 +932,65 @@ void Application::recordCommandBuffer_(VkCommandBuffer commandBuffer, uint32_t i
     vkCmdBeginRenderPass(commandBuffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
 #endif
 
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipeline);
-
-    VkViewport viewport{};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = (float)mSwapchainExtent.width;
-    viewport.height = (float)mSwapchainExtent.height;
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-
-    VkRect2D scissor{};
-    scissor.offset = { 0, 0 };
-    scissor.extent = mSwapchainExtent;
-    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
-
-    VkBuffer vertexBuffers[] = { vertexBuffer };
-    VkDeviceSize offsets[] = { 0 };
-    vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-
-    vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT16);
-
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout, 0, 1, &mDescriptorSets[mCurrentFrame], 0, nullptr);
+    // RpCIĂȂpCvC̕`̓XLbv
+    const bool overdraw_enabled = mOverdrawView.isEnabled();
+    const auto record_start = std::chrono::steady_clock::now();
+    // I𒆂̃oAg̓RpCI܂Ŋ̃oAgőp
+    VkPipeline pipeline = mUseShaderObject ? VK_NULL_HANDLE : mMainPermutationPipeline.get();
+    if (pipeline == VK_NULL_HANDLE && !mUseShaderObject)
+    {
+        pipeline = mPipeline.get();
+    }
+    if (overdraw_enabled && !mUseShaderObject)
+    {
+        pipeline = mOverdrawPipeline.get();
+    }
+    const bool vertex_pull = mUseVertexPulling && !overdraw_enabled && !mUseShaderObject &&
+        rect.isVertexPullingSupported() && mVertexPullPipeline.get() != VK_NULL_HANDLE;
+    if (vertex_pull)
+    {
+        pipeline = mVertexPullPipeline.get();
+    }
+    if (pipeline != VK_NULL_HANDLE)
+    {
+        // pCvC菜ꂽ (JOuhȂ) ͋Lq̒lŐݒ肷
+        mDynamicState.bindPipeline(pipeline);
+        mDynamicState.setPipelineState(vertex_pull ? mVertexPullPipelineDesc : overdraw_enabled ? mOverdrawPipelineDesc : mMainPipelineDesc, mSwapchainExtent);
 
-    vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
+        drawScene_(commandBuffer, overdraw_enabled, vertex_pull);
+    }
+    // ob`ނ̓oChXł̂ݎgAZbg 0 Ȃ̂ŁAI[o[h[̃Zbg1xΎc
+    if (overdraw_enabled && mUseBindless)
+    {
+        VkDescriptorSet overdraw_set = mOverdrawView.getDescriptorSet(mCurrentFrame);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mOverdrawPipelineLayout, 1, 1, &overdraw_set, 0, nullptr);
+    }
+    if (mRectBatch.isInitialized())
+    {
+        drawRectBatch_(commandBuffer, overdraw_enabled);
+    }
+    if (mSpriteBatcher.isInitialized())
+    {
+        drawSprites_(commandBuffer, overdraw_enabled);
+    }
+    if (mGpuDrivenScene.isInitialized())
+    {
+        mGpuDrivenScene.draw(commandBuffer, mDynamicState, mPipelineLayout, mSwapchainExtent, overdraw_enabled);
+    }
+    if (mHasDrawQueueDemo)
+    {
+        submitDrawQueue_(commandBuffer, overdraw_enabled);
+    }
+    if (!mUseShaderObject)
+    {
+        const double record_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - record_start).count();
+        mSceneRecordUs += (record_us - mSceneRecordUs) * 0.05;
+    }
 
+    // V[`AImGuȋOɃq[g}bvd˂
+    mOverdrawView.drawHeatmap(commandBuffer, mCurrentFrame);
+    // q[g}bv ImGui ͎ÕpCvC
+    mDynamicState.invalidate();
 
     ImGui::Begin("Information");
     ImGui::Text("Hello Triangle");
@@ -767,8 +1001,69 @@ void Application::recordCommandBuffer_(VkCommandBuffer commandBuffer, uint32_t i
 #else
     ImGui::Text("USE Dynamic Rendering");
 #endif
+    ImGui::Text("Scene backend: %s", mUseShaderObject ? "Shader objects" : "Pipelines");
+    ImGui::Text("Scene descriptors: %s", mUseBindless ? "Bindless" : mUsePushDescriptor ? "Push descriptor template" : "Per-frame set template");
+    ImGui::Text("Scene record: %.2f us", mSceneRecordUs);
+    ImGui::Text("Dynamic state: %u set, %u skipped", mDynamicState.getStats().commandCount, mDynamicState.getStats().skippedCount);
+    ImGui::SeparatorText("Shader permutation");
+    bool is_permutation_changed = ImGui::Checkbox("Texture", &mMainPermutation.useTexture);
+    is_permutation_changed |= ImGui::Checkbox("Vertex color", &mMainPermutation.useVertexColor);
+    is_permutation_changed |= ImGui::Checkbox("Alpha test", &mMainPermutation.useAlphaTest);
+    if (is_permutation_changed)
+    {
+        // ̃t[VoAgŕ`
+        updateMainPermutation_();
+    }
+    mOverdrawView.drawImGui();
+    mPresentLatency.drawImGui();
+    getPipelineManager()->drawImGui();
+    getShaderSource()->drawImGui();
+    getBindlessDescriptors()->drawImGui();
+    getGeometryPool()->drawImGui();
+    if (rect.isVertexPullingSupported())
+    {
+        static const char* stream_layouts[] = { "Interleaved", "Deinterleaved", "Compressed" };
+        ImGui::Checkbox("Vertex pulling", &mUseVertexPulling);
+        ImGui::Combo("Vertex streams", &mVertexStreamLayout, stream_layouts, IM_ARRAYSIZE(stream_layouts));
+    }
+    if (!mUseBindless && !mUsePushDescriptor)
+    {
+        mFrameDescriptors.drawImGui();
+    }
+    if (mRectBatch.isInitialized())
+    {
+        ImGui::SliderInt("Batch rects", &mRectBatchCount, 0, 200000);
+        mRectBatch.drawImGui();
+    }
+    if (mSpriteBatcher.isInitialized())
+    {
+        ImGui::SliderInt("Sprites", &mSpriteCount, 0, static_cast<int>(SpriteBatcher::sMaxSprites));
+        mSpriteBatcher.drawImGui();
+    }
+    if (mGpuDrivenScene.isInitialized())
+    {
+        ImGui::SliderInt("GPU driven objects", &mGpuDrivenObjectCount, 0, 262144);
+        mGpuDrivenScene.drawImGui();
+    }
+    if (mHasDrawQueueDemo)
+    {
+        ImGui::SliderInt("Queued draws", &mDrawQueueCount, 0, 100000);
+        mDrawQueue.drawImGui();
+    }
+    if (mUseShaderObject)
+    {
+        getShaderObjectRenderer()->drawImGui();
+    }
+    mShaderHotReload.drawImGui();
+    if (ImGui::Button("Save pipeline cache"))
+    {
+        getGfxDevice()->savePipelineCache();
+    }
     ImGui::End();
 
+    getVkObjectTracker()->drawImGui();
+    getPipelineFeedback()->drawImGui();
+
     ImGui::Render();
     ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), commandBuffer);
 
@@ -783,6 +1078,275 @@ void Application::recordCommandBuffer_(VkCommandBuffer commandBuffer, uint32_t i
     }
 }
 //---------------------------------------------------------------------------
+void Application::drawScene_(VkCommandBuffer commandBuffer, bool isOverdraw, bool isVertexPull)
+{
+    // bV firstIndex  vertexOffset ŋʂ̂ŁA̓v[̃obt@1x
+    getGeometryPool()->bind(commandBuffer);
+
+    if (isVertexPull)
+    {
+        // _̓VF[_[AhXœǂނ̂Ŏĝ̓CfbNXobt@ŁAvbV萔 Rect ݒ肷
+        rect.renderPulled(commandBuffer, mPipelineLayout, static_cast<VertexStreamLayout>(mVertexStreamLayout));
+        return;
+    }
+
+    if (mUseBindless)
+    {
+        // fBXNv^͕̌svŁAQƂeNX`̔ԍn
+        const BindlessDrawConstants draw_constants = rect.getDrawConstants();
+        vkCmdPushConstants(commandBuffer, mPipelineLayout, BindlessDescriptors::getPushConstantRange().stageFlags, 0, sizeof(draw_constants), &draw_constants);
+    }
+    else
+    {
+        bindSceneDescriptors_(commandBuffer);
+    }
+    if (isOverdraw)
+    {
+        VkDescriptorSet overdraw_set = mOverdrawView.getDescriptorSet(mCurrentFrame);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mOverdrawPipelineLayout, 1, 1, &overdraw_set, 0, nullptr);
+    }
+
+    rect.render(commandBuffer);
+}
+//---------------------------------------------------------------------------
+void Application::drawRectBatch_(VkCommandBuffer commandBuffer, bool isOverdraw)
+{
+    if (mRectBatchCount <= 0)
+    {
+        return;
+    }
+    // ʂiqɕāA`ɉ]ƐFς
+    const BindlessDrawConstants texture = rect.getDrawConstants();
+    const uint32_t count = static_cast<uint32_t>(mRectBatchCount);
+    const uint32_t columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    const float cell = 2.0f / static_cast<float>(columns);
+    const float time = static_cast<float>(glfwGetTime());
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const uint32_t x = i % columns;
+        const uint32_t y = i / columns;
+        const float phase = time + static_cast<float>(i) * 0.01f;
+        mRectBatch.add(mRectBatchPipeline, RectInstance{
+            .position = glm::vec2(-1.0f + (x + 0.5f) * cell, -1.0f + (y + 0.5f) * cell),
+            .size = glm::vec2(cell * 0.8f),
+            .rotation = phase,
+            .color = RectBatch::packColor(glm::vec4(0.5f + 0.5f * std::sin(phase), 0.5f + 0.5f * std::cos(phase), 1.0f, 0.8f)),
+            .textureIndex = texture.textureIndex,
+            .samplerIndex = texture.samplerIndex,
+        });
+    }
+    mRectBatch.record(commandBuffer, mDynamicState, mSwapchainExtent, isOverdraw);
+}
+//---------------------------------------------------------------------------
+void Application::drawSprites_(VkCommandBuffer commandBuffer, bool isOverdraw)
+{
+    if (mSpriteCount <= 0)
+    {
+        return;
+    }
+    // ̃Xbh瓊邱Ƃm߂邽߁A͈͂𕪂ĕɐς
+    // eNX`̎l؂oXvCg~ɕׁA͉Zŕ`
+    const BindlessDrawConstants texture = rect.getDrawConstants();
+    const uint32_t count = static_cast<uint32_t>(mSpriteCount);
+    const float time = static_cast<float>(glfwGetTime());
+    auto push_chunk = [&](uint32_t chunk) {
+        const uint32_t begin = count * chunk / sSpriteChunkCount;
+        const uint32_t end = count * (chunk + 1) / sSpriteChunkCount;
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const float angle = time * 0.5f + static_cast<float>(i) * 2.39996f;
+            const float radius = 0.9f * std::sqrt(static_cast<float>(i + 1) / static_cast<float>(count));
+            const float u = static_cast<float>(i & 1) * 0.5f;
+            const float v = static_cast<float>((i >> 1) & 1) * 0.5f;
+            mSpriteBatcher.draw(Sprite{
+                .position = glm::vec2(std::cos(angle), std::sin(angle)) * radius,
+                .size = glm::vec2(0.04f),
+                .rotation = -angle,
+                .uvRect = glm::vec4(u, v, u + 0.5f, v + 0.5f),
+                .color = RectBatch::packColor(glm::vec4(1.0f, 1.0f, 1.0f, 0.9f)),
+                .textureIndex = texture.textureIndex,
+                .samplerIndex = texture.samplerIndex,
+                .blend = (i & 1) ? SpriteBlend::Additive : SpriteBlend::Alpha,
+                .layer = static_cast<uint16_t>(i & 1),
+            });
+        }
+    };
+    // std::execution::par  libstdc++ ł TBB KvɂȂ̂ŁA풓̃[J[ɕ (t[XbhȂ)
+    mSpriteWorkers.run(sSpriteChunkCount, push_chunk);
+    mSpriteBatcher.flush(commandBuffer, mDynamicState, mPipelineLayout, mSwapchainExtent, isOverdraw);
+}
+//---------------------------------------------------------------------------
+void Application::cullGpuDrivenScene_(VkCommandBuffer commandBuffer)
+{
+    // ςIuWFNg蒼 (t[̓J𓮂)
+    const BindlessDrawConstants texture = rect.getDrawConstants();
+    const uint32_t count = static_cast<uint32_t>(mGpuDrivenObjectCount);
+    const uint32_t columns = std::max(1u, static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(count)))));
+    constexpr float cell = 0.1f;
+    const float world_half = 0.5f * cell * static_cast<float>(columns);
+    if (count != mGpuDrivenScene.getObjectCount())
+    {
+        std::vector<GpuDrawObject> objects(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const glm::vec2 position(-world_half + ((i % columns) + 0.5f) * cell, -world_half + ((i / columns) + 0.5f) * cell);
+            const glm::vec2 size(cell * 0.8f);
+            // bV͎w肹ɋL̎lp`g
+            GpuDrawObject& object = objects[i];
+            object.boundingSphere = glm::vec4(position, 0.0f, glm::length(size) * 0.5f);
+            object.positionScale = glm::vec4(position, size);
+            object.color = RectBatch::packColor(glm::vec4(position / (2.0f * world_half) + 0.5f, 1.0f, 0.8f));
+            object.textureIndex = texture.textureIndex;
+            object.samplerIndex = texture.samplerIndex;
+        }
+        mGpuDrivenScene.setObjects(objects);
+    }
+
+    // iq̈ꕔ悤ɁA1͈̔͂~`ē
+    const float time = static_cast<float>(glfwGetTime());
+    const float aspect = static_cast<float>(mSwapchainExtent.width) / static_cast<float>(std::max(mSwapchainExtent.height, 1u));
+    const glm::vec2 center = glm::vec2(std::cos(time * 0.2f), std::sin(time * 0.2f)) * world_half * 0.5f;
+    const glm::mat4 view_proj = glm::ortho(center.x - aspect, center.x + aspect, center.y - 1.0f, center.y + 1.0f, -1.0f, 1.0f);
+    mGpuDrivenScene.cull(commandBuffer, view_proj);
+}
+//---------------------------------------------------------------------------
+void Application::createDrawQueueDemo_()
+{
+    auto& gfx_device = getGfxDevice();
+    auto device = gfx_device->getVkDevice();
+
+    // iq̏ږ̎lp`ꂼʂ̃bVƂ1̒_obt@ɕׂ (vertexOffset ŋʂ)
+    constexpr uint32_t grid = 8;
+    const float cell = 2.0f / static_cast<float>(grid);
+    std::vector<SpriteVertex> vertices;
+    vertices.reserve(grid * grid * 4);
+    for (uint32_t y = 0; y < grid; ++y)
+    {
+        for (uint32_t x = 0; x < grid; ++x)
+        {
+            const glm::vec2 lo(-1.0f + (x + 0.1f) * cell, -1.0f + (y + 0.1f) * cell);
+            const glm::vec2 hi = lo + glm::vec2(cell * 0.8f);
+            const uint32_t color = RectBatch::packColor(glm::vec4(x / (grid - 1.0f), y / (grid - 1.0f), 1.0f, 0.5f));
+            vertices.push_back(SpriteVertex{ lo, glm::vec2(0.0f, 0.0f), color });
+            vertices.push_back(SpriteVertex{ glm::vec2(hi.x, lo.y), glm::vec2(1.0f, 0.0f), color });
+            vertices.push_back(SpriteVertex{ hi, glm::vec2(1.0f, 1.0f), color });
+            vertices.push_back(SpriteVertex{ glm::vec2(lo.x, hi.y), glm::vec2(0.0f, 1.0f), color });
+        }
+    }
+    static const std::array<uint16_t, 6> indices = { 0, 1, 2, 2, 3, 0 };
+
+    void* data = nullptr;
+    const VkDeviceSize vertex_size = vertices.size() * sizeof(SpriteVertex);
+    gfx_device->createBuffer(vertex_size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mDrawQueueVertexBuffer, mDrawQueueVertexMemory);
+    gfx_device->setObjectName(uint64_t(mDrawQueueVertexBuffer), "DrawQueueDemoVertices", VK_OBJECT_TYPE_BUFFER);
+    vkMapMemory(device, mDrawQueueVertexMemory, 0, vertex_size, 0, &data);
+    memcpy(data, vertices.data(), vertex_size);
+    vkUnmapMemory(device, mDrawQueueVertexMemory);
+
+    gfx_device->createBuffer(sizeof(indices), VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mDrawQueueIndexBuffer, mDrawQueueIndexMemory);
+    gfx_device->setObjectName(uint64_t(mDrawQueueIndexBuffer), "DrawQueueDemoIndices", VK_OBJECT_TYPE_BUFFER);
+    vkMapMemory(device, mDrawQueueIndexMemory, 0, sizeof(indices), 0, &data);
+    memcpy(data, indices.data(), sizeof(indices));
+    vkUnmapMemory(device, mDrawQueueIndexMemory);
+
+    // C[ 0 ͔Ȃ̂ŉOɁAC[ 1 ͉Z (Ɉ˂Ȃ) ŕ`
+    const VkPipelineLayout overdraw_layout = mOverdrawView.isSupported() ? mOverdrawPipelineLayout : VK_NULL_HANDLE;
+    mDrawQueuePipelines[0] = mDrawQueue.addPipeline(mSpriteBatcher.getPipelineDesc(SpriteBlend::Alpha), overdraw_layout);
+    mDrawQueuePipelines[1] = mDrawQueue.addPipeline(mSpriteBatcher.getPipelineDesc(SpriteBlend::Additive), overdraw_layout);
+    mDrawQueue.setBackToFront(0, true);
+    // eNX`1̂Œg͓A؂ւ̉񐔂邽߂ɕʂ̃}eAɂ
+    mDrawQueueMaterials.clear();
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        mDrawQueueMaterials.push_back(mDrawQueue.addMaterial(rect.getDrawConstants()));
+    }
+    mDrawQueueMeshes.clear();
+    for (uint32_t i = 0; i < grid * grid; ++i)
+    {
+        mDrawQueueMeshes.push_back(mDrawQueue.addMesh(DrawMesh{
+            .vertexBuffer = mDrawQueueVertexBuffer,
+            .indexBuffer = mDrawQueueIndexBuffer,
+            .indexType = VK_INDEX_TYPE_UINT16,
+            .indexCount = static_cast<uint32_t>(indices.size()),
+            .firstIndex = 0,
+            .vertexOffset = static_cast<int32_t>(i * 4),
+        }));
+    }
+    mHasDrawQueueDemo = true;
+}
+//---------------------------------------------------------------------------
+void Application::submitDrawQueue_(VkCommandBuffer commandBuffer, bool isOverdraw)
+{
+    // pCvCE}eAEbV΂΂ɓւ鏇Őς
+    mDrawQueue.beginFrame();
+    const uint32_t count = static_cast<uint32_t>(mDrawQueueCount);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const uint32_t hash = i * 2654435761u;
+        const uint32_t pipeline = (hash >> 13) & 1;
+        const uint32_t mesh = (hash >> 16) % static_cast<uint32_t>(mDrawQueueMeshes.size());
+        const uint32_t material = (hash >> 24) % static_cast<uint32_t>(mDrawQueueMaterials.size());
+        mDrawQueue.submit(pipeline, mDrawQueuePipelines[pipeline], mDrawQueueMaterials[material], mDrawQueueMeshes[mesh],
+            static_cast<float>(mesh) / static_cast<float>(mDrawQueueMeshes.size()));
+    }
+    mDrawQueue.record(commandBuffer, mDynamicState, mPipelineLayout, mSwapchainExtent, isOverdraw);
+}
+//---------------------------------------------------------------------------
+void Application::recordShaderObjectScene_(VkCommandBuffer commandBuffer, uint32_t imageIndex, const VkClearValue& clearValue)
+{
+    // _[pX̂ŃCAEgJڂ͎ōs
+    VkImageMemoryBarrier to_attachment{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .srcAccessMask = 0,
+        .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = mSwapchainImages[imageIndex],
+        .subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+    };
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &to_attachment);
+
+    VkRenderingAttachmentInfo attachment_info{
+        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        .imageView = mSwapchainImageViews[imageIndex],
+        .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+        .clearValue = clearValue,
+    };
+    VkRenderingInfo rendering_info{
+        .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+        .renderArea = {
+            .offset = { 0, 0 },
+            .extent = mSwapchainExtent,
+        },
+        .layerCount = 1,
+        .colorAttachmentCount = 1,
+        .pColorAttachments = &attachment_info,
+    };
+    vkCmdBeginRendering(commandBuffer, &rendering_info);
+
+    // pCvC̏ꍇƓLqAVF[_[̌ƓIXe[g̐ݒs
+    const auto record_start = std::chrono::steady_clock::now();
+    // I𒆂̃oAg̓`FbN{bNXς蒼̂g
+    const bool overdraw_enabled = mOverdrawView.isEnabled();
+    const GraphicsPipelineDesc& desc = overdraw_enabled ? mOverdrawPipelineDesc : mShaderObjectDesc;
+    if (getShaderObjectRenderer()->bind(mDynamicState, desc, mSwapchainExtent))
+    {
+        drawScene_(commandBuffer, overdraw_enabled, false);
+    }
+    const double record_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - record_start).count();
+    mSceneRecordUs += (record_us - mSceneRecordUs) * 0.05;
+
+    vkCmdEndRendering(commandBuffer);
+}
+//---------------------------------------------------------------------------
 void Application::createSyncObjects_()
 {
     mImageAvailableSemaphores.resize(sInflightFrames);
@@ -802,6 +1366,10 @@ void Application::createSyncObjects_()
             vkCreateFence(getGfxDevice()->getVkDevice(), &fenceInfo, nullptr, &mInFlightFences[i]) != VK_SUCCESS) {
             throw std::runtime_error("failed to create synchronization objects for a frame!");
         }
+        auto& tracker = getVkObjectTracker();
+        tracker->onCreate(mImageAvailableSemaphores[i], VK_OBJECT_TYPE_SEMAPHORE);
+        tracker->onCreate(mRenderFinishedSemaphores[i], VK_OBJECT_TYPE_SEMAPHORE);
+        tracker->onCreate(mInFlightFences[i], VK_OBJECT_TYPE_FENCE);
     }
 }
 //---------------------------------------------------------------------------
@@ -817,45 +1385,80 @@ void Application::recreateSwapchain_()
 
     vkDeviceWaitIdle(getGfxDevice()->getVkDevice());
 
+    // Xbv`FCĐɔIuWFNg͋e
+    getVkObjectTracker()->resetSteadyState();
+
     cleanupSwapchain_();
 
     createSwapchain_();
     createImageViews_();
     createFramebuffers_();
+    mPresentLatency.start(mSwapchain);
+    mOverdrawView.resize(getGfxDevice().get(), mSwapchainExtent);
 }
 //---------------------------------------------------------------------------
 void Application::cleanupSwapchain_()
 {
 	auto device = getGfxDevice()->getVkDevice();
+    auto& tracker = getVkObjectTracker();
+
+    // \҂̊ĎXbhXbv`FCQƂĂ̂ŐɎ~߂
+    mPresentLatency.stop();
 
     for (auto framebuffer : mSwapchainFramebuffers) {
         vkDestroyFramebuffer(device, framebuffer, nullptr);
+        tracker->onDestroy(framebuffer, VK_OBJECT_TYPE_FRAMEBUFFER);
     }
 
     for (auto imageView : mSwapchainImageViews) {
         vkDestroyImageView(device, imageView, nullptr);
+        tracker->onDestroy(imageView, VK_OBJECT_TYPE_IMAGE_VIEW);
     }
 
     vkDestroySwapchainKHR(device, mSwapchain, nullptr);
+    tracker->onDestroy(mSwapchain, VK_OBJECT_TYPE_SWAPCHAIN_KHR);
 }
 //---------------------------------------------------------------------------
 void Application::cleanup_()
 {
 	auto device = getGfxDevice()->getVkDevice();
+    auto& tracker = getVkObjectTracker();
     cleanupSwapchain_();
 
-    vkDestroyPipeline(device, mPipeline, nullptr);
-    vkDestroyPipelineLayout(device, mPipelineLayout, nullptr);
+    // pCvC PipelineManager ܂Ƃ߂Ĕj
+    getPipelineManager()->shutdown();
+    mPipeline = {};
+    mOverdrawPipeline = {};
+    mVertexPullPipeline = {};
+    mPermutationPipelines.clear();
+    mMainPermutationPipeline = {};
+    if (mUseShaderObject)
+    {
+        getShaderObjectRenderer()->shutdown();
+        vkDestroyRenderPass(device, mRenderPassLoad, nullptr);
+        tracker->onDestroy(mRenderPassLoad, VK_OBJECT_TYPE_RENDER_PASS);
+    }
+
 #ifdef USE_RENDERPASS
     vkDestroyRenderPass(device, mRenderPass, nullptr);
+    tracker->onDestroy(mRenderPass, VK_OBJECT_TYPE_RENDER_PASS);
 #endif
 
-    for (size_t i = 0; i < sInflightFrames; i++) {
-        vkDestroyBuffer(device, mUniformBuffers[i], nullptr);
-        vkFreeMemory(device, mUniformBuffersMemory[i], nullptr);
-    }
-
     vkDestroyDescriptorPool(device, mDescriptorPool, nullptr);
+    tracker->onDestroy(mDescriptorPool, VK_OBJECT_TYPE_DESCRIPTOR_POOL);
+    mFrameDescriptors.shutdown();
+    mRectBatch.shutdown();
+    mSpriteWorkers.stop();
+    mSpriteBatcher.shutdown();
+    mGpuDrivenScene.shutdown();
+    // bV̂SĔjɔj
+    getGeometryPool()->shutdown();
+    if (mHasDrawQueueDemo)
+    {
+        getGfxDevice()->destroyBuffer(mDrawQueueVertexBuffer, mDrawQueueVertexMemory);
+        getGfxDevice()->destroyBuffer(mDrawQueueIndexBuffer, mDrawQueueIndexMemory);
+        mHasDrawQueueDemo = false;
+    }
 
     vkDestroySampler(device, mTextureSampler, nullptr);
     vkDestroyImageView(device, mTextureImageView, nullptr);
@@ -863,21 +1466,23 @@ void Application::cleanup_()
     vkDestroyImage(device, textureImage, nullptr);
     vkFreeMemory(device, textureImageMemory, nullptr);
 
-    vkDestroyDescriptorSetLayout(device, mDescriptorSetLayout, nullptr);
-
-    vkDestroyBuffer(device, indexBuffer, nullptr);
-    vkFreeMemory(device, indexBufferMemory, nullptr);
-
-    vkDestroyBuffer(device, vertexBuffer, nullptr);
-    vkFreeMemory(device, vertexBufferMemory, nullptr);
+    // fBXNv^ZbgCAEgƃpCvCCAEgAXVev[g̓LbV܂Ƃ߂Ĕj
+    getPipelineLayoutCache()->shutdown();
+    mShaderLayout = nullptr;
+    mSceneUpdateTemplate = VK_NULL_HANDLE;
+    getBindlessDescriptors()->shutdown();
 
     for (size_t i = 0; i < sInflightFrames; i++) {
         vkDestroySemaphore(device, mRenderFinishedSemaphores[i], nullptr);
         vkDestroySemaphore(device, mImageAvailableSemaphores[i], nullptr);
         vkDestroyFence(device, mInFlightFences[i], nullptr);
+        tracker->onDestroy(mRenderFinishedSemaphores[i], VK_OBJECT_TYPE_SEMAPHORE);
+        tracker->onDestroy(mImageAvailableSemaphores[i], VK_OBJECT_TYPE_SEMAPHORE);
+        tracker->onDestroy(mInFlightFences[i], VK_OBJECT_TYPE_FENCE);
     }
 
     vkDestroyCommandPool(device, mCommandPool, nullptr);
+    tracker->onDestroy(mCommandPool, VK_OBJECT_TYPE_COMMAND_POOL);
 }
 //---------------------------------------------------------------------------
 void Application::drawFrame_()
@@ -886,13 +1491,42 @@ void Application::drawFrame_()
     auto graphics_queue = getGfxDevice()->getGraphicsQueue();
     auto present_queue = getGfxDevice()->getPresentQueue();
 
+    // t[Pʂ̃IuWFNg/jWv
+    auto& tracker = getVkObjectTracker();
+    tracker->beginFrame();
+
     vkWaitForFences(device, 1, &mInFlightFences[mCurrentFrame], VK_TRUE, UINT64_MAX);
+    mPresentLatency.beginFrame(mCurrentFrame);
+    // GPU gÎŁÃt[Ŋ蓖ĂZbg܂Ƃ߂ĉ
+    mFrameDescriptors.beginFrame(mCurrentFrame);
+    // lߒ͂ōŝŁA`̈ێ̂͂̌Ŏ蒼
+    getGeometryPool()->beginFrame();
+    mRectBatch.beginFrame(mCurrentFrame);
+    mSpriteBatcher.beginFrame(mCurrentFrame);
+    mGpuDrivenScene.beginFrame(mCurrentFrame);
+
+    // zbg[hō蒼pCvC͂ōւ
+    getPipelineManager()->beginFrame();
+    getBindlessDescriptors()->beginFrame();
+    if (mUseShaderObject)
+    {
+        getShaderObjectRenderer()->beginFrame();
+    }
+
+    const auto frame_time = std::chrono::steady_clock::now();
+    if (mLastFrameTime != std::chrono::steady_clock::time_point{})
+    {
+        mFrameTimeMetric->observe(std::chrono::duration<double, std::milli>(frame_time - mLastFrameTime).count());
+    }
+    mLastFrameTime = frame_time;
+    mFrameCountMetric->add();
 
     uint32_t imageIndex;
     VkResult result = vkAcquireNextImageKHR(device, mSwapchain, UINT64_MAX, mImageAvailableSemaphores[mCurrentFrame], VK_NULL_HANDLE, &imageIndex);
 
     if (result == VK_ERROR_OUT_OF_DATE_KHR) {
         recreateSwapchain_();
+        tracker->endFrame();
         return;
     }
     else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
@@ -925,10 +1559,12 @@ void Application::drawFrame_()
     if (vkQueueSubmit(graphics_queue, 1, &submitInfo, mInFlightFences[mCurrentFrame]) != VK_SUCCESS) {
         throw std::runtime_error("failed to submit draw command buffer!");
     }
+    mPresentLatency.onSubmit(mCurrentFrame);
 
     VkSwapchainKHR swapChains[] = { mSwapchain };
     VkPresentInfoKHR present_info{
         .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+        .pNext = mPresentLatency.preparePresent(mCurrentFrame),
         .waitSemaphoreCount = 1,
         .pWaitSemaphores = signalSemaphores,
         .swapchainCount = 1,
@@ -937,6 +1573,7 @@ void Application::drawFrame_()
     };
 
     result = vkQueuePresentKHR(present_queue, &present_info);
+    mPresentLatency.onPresented(mCurrentFrame, result);
 
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || mFramebufferResized) {
         mFramebufferResized = false;
@@ -947,5 +1584,7 @@ void Application::drawFrame_()
     }
 
     mCurrentFrame = (mCurrentFrame + 1) % sInflightFrames;
+
+    tracker->endFrame();
 }
 //---------------------------------------------------------------------------
\ No newline at end of file
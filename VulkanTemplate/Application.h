@@ -1,4 +1,5 @@
 #pragma once
+#include <unordered_map>
 #include <vector>
 #include "GfxDevice.h"
 
@@ -9,6 +10,23 @@
 #include "glm/glm.hpp"
 #include "glm/ext.hpp"
 #include "Rect.h"
+#include "OverdrawView.h"
+#include "PresentLatency.h"
+#include "Metrics.h"
+#include "PipelineManager.h"
+#include "PipelineLayoutCache.h"
+#include "ShaderHotReload.h"
+#include "ShaderObjectRenderer.h"
+#include "DynamicStateCache.h"
+#include "BindlessDescriptors.h"
+#include "DescriptorAllocator.h"
+#include "RectBatch.h"
+#include "SpriteBatcher.h"
+#include "GpuDrivenScene.h"
+#include "DrawQueue.h"
+#include "GeometryPool.h"
+#include "WorkerGroup.h"
+#include <chrono>
 #include <optional>
 
 
@@ -30,6 +48,19 @@ public:
     void process();
     bool getIsInitialized() { return mIsInitialized; }
 
+	/*
+	 * V[̕` VK_EXT_shader_object g (Initialize ̑OɌĂԁAgȂꍇ̓pCvĈ܂)
+	 */
+	inline void requestShaderObject(bool enable) { mIsShaderObjectRequested = enable; }
+	/*
+	 * oChX̃fBXNv^ VK_EXT_descriptor_buffer g (Initialize ̑OɌĂԁAgȂꍇ̓v[̂܂)
+	 */
+	inline void requestDescriptorBuffer(bool enable) { mIsDescriptorBufferRequested = enable; }
+	/*
+	 * V[̒_VF[_[AhXœǂ (_v) ԂŎn߂ (gȂꍇ͒_obt@̂܂܁AImGui Ő؂ւ)
+	 */
+	inline void requestVertexPulling(bool enable) { mUseVertexPulling = enable; }
+
 private:
     void initializeWindow_();
     void initializeGfxDevice_();
@@ -47,13 +78,23 @@ private:
     void createRenderPass_();
 	void createDescriptorSetLayout_();
 	void createGraphicsPipeline_();
+	PipelineHandle getPermutationPipeline_(const MainShaderPermutation& permutation);
+	// I𒆂̃oAg蒼 (ImGui ̃`FbN{bNXςĂ)
+	void updateMainPermutation_();
 	void createFramebuffers_();
 	void createCommandPool_();
 
 	void createDescriptorPool_();
-	void createDescriptorSets_();
+	void bindSceneDescriptors_(VkCommandBuffer commandBuffer);
 	void createCommandBuffer_();
 	void recordCommandBuffer_(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+	void drawScene_(VkCommandBuffer commandBuffer, bool isOverdraw, bool isVertexPull);
+	void drawRectBatch_(VkCommandBuffer commandBuffer, bool isOverdraw);
+	void drawSprites_(VkCommandBuffer commandBuffer, bool isOverdraw);
+	void cullGpuDrivenScene_(VkCommandBuffer commandBuffer);
+	void createDrawQueueDemo_();
+	void submitDrawQueue_(VkCommandBuffer commandBuffer, bool isOverdraw);
+	void recordShaderObjectScene_(VkCommandBuffer commandBuffer, uint32_t imageIndex, const VkClearValue& clearValue);
 	void createSyncObjects_();
 
 	void recreateSwapchain_();
@@ -61,17 +102,19 @@ private:
 	void cleanup_();
 
 	void drawFrame_();
+	void registerMetrics_();
 
     bool mIsInitialized = false;
 
     Rect rect;
+    OverdrawView mOverdrawView;
+    PresentLatencyTracker mPresentLatency;
+    ShaderHotReload mShaderHotReload;
 
-    struct UniformBufferObject
-    {
-        glm::mat4 model;
-        glm::mat4 view;
-        glm::mat4 proj;
-	};
+	// \[NeXgp̃gNX
+	MetricCounter* mFrameCountMetric = nullptr;
+	MetricHistogram* mFrameTimeMetric = nullptr;
+	std::chrono::steady_clock::time_point mLastFrameTime{};
 
 	VkSwapchainKHR mSwapchain = VK_NULL_HANDLE;
 	uint32_t mSwapchainImageCount = 0;
@@ -98,7 +141,13 @@ private:
 
 	VkCommandPool mCommandPool = VK_NULL_HANDLE;
 	VkDescriptorPool mDescriptorPool = VK_NULL_HANDLE;
-	std::vector<VkDescriptorSet> mDescriptorSets;
+	// oChXgȂꍇ̃V[̃Zbg (t[Ɋ蓖āAtFX҂ɂ܂Ƃ߂ăZbg)
+	DescriptorAllocator mFrameDescriptors;
+	// V[̃Zbg 0 ͍XVev[gŏ (vbVfBXNv^gꍇ̓Zbg蓖ĂɃvbV)
+	bool mUsePushDescriptor = false;
+	VkDescriptorUpdateTemplate mSceneUpdateTemplate = VK_NULL_HANDLE;
+	std::vector<DescriptorData> mSceneDescriptorData;
+	uint32_t mSceneTextureIndex = UINT32_MAX;
 	uint32_t mCurrentFrameIndex = 0;
 	uint32_t mSwapchainImageIndex = 0;
 
@@ -107,9 +156,72 @@ private:
 	std::vector<VkSemaphore> mRenderFinishedSemaphores;
 	std::vector<VkFence> mInFlightFences;
 
+	// C̃VF[_[琶CAEg (nh PipelineLayoutCache L)
+	const ShaderLayout* mShaderLayout = nullptr;
 	VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;
     VkPipelineLayout mPipelineLayout = VK_NULL_HANDLE;
-    VkPipeline mPipeline = VK_NULL_HANDLE;
+    PipelineHandle mPipeline;
+
+	// CVF[_[̃oAg (߂ĎgꂽɃRpC)
+	GraphicsPipelineDesc mMainPipelineDesc;
+	MainShaderPermutation mMainPermutation;
+	std::unordered_map<uint64_t, PipelineHandle> mPermutationPipelines;
+	// I𒆂̃oAg (pCvC̏ꍇ̓nhAVF[_[IuWFNg̏ꍇ͋Lq)
+	PipelineHandle mMainPermutationPipeline;
+	GraphicsPipelineDesc mShaderObjectDesc;
+
+	// I[o[h[\p (tOgo͂JE^Zɒu)
+	VkPipelineLayout mOverdrawPipelineLayout = VK_NULL_HANDLE;
+	GraphicsPipelineDesc mOverdrawPipelineDesc;
+	PipelineHandle mOverdrawPipeline;
+
+	// _vp (_͂A_ VertexPullConstants ̃AhXǂ)
+	// oChX̃vbV萔gAobt@̃foCXAhXgꍇ̂
+	GraphicsPipelineDesc mVertexPullPipelineDesc;
+	PipelineHandle mVertexPullPipeline;
+	bool mUseVertexPulling = false;
+	int mVertexStreamLayout = 0;  // VertexStreamLayout
+
+	// VF[_[IuWFNgŃV[`悷ꍇ
+	// V[ Dynamic Rendering ŕ`悵Aq[g}bv ImGui  mRenderPassLoad őĕ`
+	bool mIsShaderObjectRequested = false;
+	bool mUseShaderObject = false;
+	VkRenderPass mRenderPassLoad = VK_NULL_HANDLE;
+	// V[`̃R}hL^ɂ CPU  (pCvCƂ̔rp)
+	double mSceneRecordUs = 0.0;
+
+	// oChXŕ`悷ꍇ (descriptor indexing gꍇ)
+	// Zbg 0  BindlessDescriptors ̃ZbgɂȂAeNX`̔ԍ̓vbV萔œn
+	bool mUseBindless = false;
+	bool mIsDescriptorBufferRequested = false;
+
+	// CX^VOŕ`ʂ̋` (oChXŃpCvCgꍇ̂)
+	RectBatch mRectBatch;
+	uint32_t mRectBatchPipeline = 0;
+	int mRectBatchCount = 0;
+	// c[ HUD ̑[h̃XvCg (`̃ob`ƓoChX̏ꍇ̂)
+	SpriteBatcher mSpriteBatcher;
+	int mSpriteCount = 0;
+	// XvCgɐςނ߂͈̔͂̐ (ŏ͈͕̔͂`XbhŐς݁Ac풓̃[J[ς)
+	static constexpr uint32_t sSpriteChunkCount = 4;
+	WorkerGroup mSpriteWorkers;
+	// JOƕ`R}h̐ GPU ōsIuWFNg (Ԑڕ`ɑΉĂꍇ̂)
+	GpuDrivenScene mGpuDrivenScene;
+	int mGpuDrivenObjectCount = 0;
+	// L[ŕבւĂL^` (XvCg̃pCvCĝœoChX̏ꍇ̂)
+	DrawQueue mDrawQueue;
+	int mDrawQueueCount = 0;
+	bool mHasDrawQueueDemo = false;
+	std::array<uint32_t, 2> mDrawQueuePipelines{};
+	std::vector<uint32_t> mDrawQueueMaterials;
+	std::vector<uint32_t> mDrawQueueMeshes;
+	VkBuffer mDrawQueueVertexBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory mDrawQueueVertexMemory = VK_NULL_HANDLE;
+	VkBuffer mDrawQueueIndexBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory mDrawQueueIndexMemory = VK_NULL_HANDLE;
+
+	// L^̃R}hobt@ɐݒ肵 (l̍ĐݒȂ)
+	DynamicStateCache mDynamicState;
 
     VkRenderPass mRenderPass;
 };
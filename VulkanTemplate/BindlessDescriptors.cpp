@@ -0,0 +1,500 @@
+#include "BindlessDescriptors.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include "VkObjectTracker.h"
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+static std::unique_ptr<BindlessDescriptors> bindlessDescriptors = nullptr;
+std::unique_ptr<BindlessDescriptors>& getBindlessDescriptors()
+{
+    if (bindlessDescriptors == nullptr)
+    {
+        bindlessDescriptors = std::make_unique<BindlessDescriptors>();
+    }
+    return bindlessDescriptors;
+}
+//---------------------------------------------------------------------------
+uint32_t BindlessDescriptors::Slots::allocate()
+{
+    if (!freeIndices.empty())
+    {
+        const uint32_t index = freeIndices.back();
+        freeIndices.pop_back();
+        return index;
+    }
+    if (next < capacity)
+    {
+        return next++;
+    }
+    return sInvalidIndex;
+}
+//---------------------------------------------------------------------------
+uint32_t BindlessDescriptors::Slots::getCount() const
+{
+    return next - static_cast<uint32_t>(freeIndices.size() + retired.size());
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::initialize(GfxDevice* gfx_device, DescriptorBackend backend)
+{
+    mGfxDevice = gfx_device;
+    if (!gfx_device->isDescriptorIndexingEnabled())
+    {
+        return;
+    }
+    mBackend = backend;
+    if (mBackend == DescriptorBackend::DescriptorBuffer && !gfx_device->isDescriptorBufferEnabled())
+    {
+        fprintf(stderr, "[Bindless] descriptor buffer is not enabled, using descriptor pool\n");
+        mBackend = DescriptorBackend::Pool;
+    }
+    const bool is_descriptor_buffer = mBackend == DescriptorBackend::DescriptorBuffer;
+
+    // z̑傫̓foCX̏Ɏ߂
+    // v[̏ꍇ UPDATE_AFTER_BIND pAdescriptor buffer ̏ꍇ͒ʏ̏Kp
+    VkPhysicalDeviceDescriptorIndexingProperties indexing_properties{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES,
+    };
+    VkPhysicalDeviceProperties2 properties2{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+        .pNext = &indexing_properties,
+    };
+    vkGetPhysicalDeviceProperties2(gfx_device->getVkPhysicalDevice(), &properties2);
+    const VkPhysicalDeviceLimits& limits = properties2.properties.limits;
+    mTextures = Slots{ .capacity = is_descriptor_buffer
+        ? std::min({ sMaxTextures, limits.maxPerStageDescriptorSampledImages, limits.maxDescriptorSetSampledImages })
+        : std::min({ sMaxTextures,
+            indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+            indexing_properties.maxDescriptorSetUpdateAfterBindSampledImages }) };
+    mSamplers = Slots{ .capacity = is_descriptor_buffer
+        ? std::min({ sMaxSamplers, limits.maxPerStageDescriptorSamplers, limits.maxDescriptorSetSamplers })
+        : std::min({ sMaxSamplers,
+            indexing_properties.maxPerStageDescriptorUpdateAfterBindSamplers,
+            indexing_properties.maxDescriptorSetUpdateAfterBindSamplers }) };
+    mStorageBuffers = Slots{ .capacity = is_descriptor_buffer
+        ? std::min({ sMaxStorageBuffers, limits.maxPerStageDescriptorStorageBuffers, limits.maxDescriptorSetStorageBuffers })
+        : std::min({ sMaxStorageBuffers,
+            indexing_properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+            indexing_properties.maxDescriptorSetUpdateAfterBindStorageBuffers }) };
+
+    const VkShaderStageFlags stages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+    std::array<VkDescriptorSetLayoutBinding, 3> bindings{
+        VkDescriptorSetLayoutBinding{
+            .binding = sTextureBinding,
+            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            .descriptorCount = mTextures.capacity,
+            .stageFlags = stages,
+        },
+        VkDescriptorSetLayoutBinding{
+            .binding = sSamplerBinding,
+            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
+            .descriptorCount = mSamplers.capacity,
+            .stageFlags = stages,
+        },
+        VkDescriptorSetLayoutBinding{
+            .binding = sStorageBufferBinding,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = mStorageBuffers.capacity,
+            .stageFlags = stages,
+        },
+    };
+    // o^ĂȂvf͎QƂȂOŁASĂ̗vf܂ȂĂ悢悤ɂ
+    // descriptor buffer ͂̃Ȃ̂ UPDATE_AFTER_BIND ͎włȂ (w肵ȂĂsɏ߂)
+    const VkDescriptorBindingFlags binding_flag = is_descriptor_buffer
+        ? VkDescriptorBindingFlags(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT)
+        : VkDescriptorBindingFlags(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT);
+    std::array<VkDescriptorBindingFlags, 3> binding_flags{ binding_flag, binding_flag, binding_flag };
+    VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        .bindingCount = static_cast<uint32_t>(binding_flags.size()),
+        .pBindingFlags = binding_flags.data(),
+    };
+    VkDescriptorSetLayoutCreateInfo layout_create_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext = &binding_flags_info,
+        .bindingCount = static_cast<uint32_t>(bindings.size()),
+        .pBindings = bindings.data(),
+    };
+    if (is_descriptor_buffer)
+    {
+        createDescriptorBuffer_(layout_create_info);
+    }
+    else
+    {
+        createDescriptorSet_(layout_create_info);
+    }
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::createDescriptorSet_(VkDescriptorSetLayoutCreateInfo& layoutCreateInfo)
+{
+    auto device = mGfxDevice->getVkDevice();
+    auto& tracker = getVkObjectTracker();
+
+    layoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    if (vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &mDescriptorSetLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create bindless descriptor set layout!");
+    }
+    tracker->onCreate(mDescriptorSetLayout, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+    mGfxDevice->setObjectName(uint64_t(mDescriptorSetLayout), "BindlessSetLayout", VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+
+    std::array<VkDescriptorPoolSize, 3> pool_sizes{
+        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, mTextures.capacity },
+        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_SAMPLER, mSamplers.capacity },
+        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mStorageBuffers.capacity },
+    };
+    VkDescriptorPoolCreateInfo pool_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        .maxSets = 1,
+        .poolSizeCount = static_cast<uint32_t>(pool_sizes.size()),
+        .pPoolSizes = pool_sizes.data(),
+    };
+    if (vkCreateDescriptorPool(device, &pool_info, nullptr, &mDescriptorPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create bindless descriptor pool!");
+    }
+    tracker->onCreate(mDescriptorPool, VK_OBJECT_TYPE_DESCRIPTOR_POOL);
+
+    VkDescriptorSetAllocateInfo alloc_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .descriptorPool = mDescriptorPool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &mDescriptorSetLayout,
+    };
+    if (vkAllocateDescriptorSets(device, &alloc_info, &mDescriptorSet) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate bindless descriptor set!");
+    }
+    mGfxDevice->setObjectName(uint64_t(mDescriptorSet), "BindlessSet", VK_OBJECT_TYPE_DESCRIPTOR_SET);
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::createDescriptorBuffer_(VkDescriptorSetLayoutCreateInfo& layoutCreateInfo)
+{
+    auto device = mGfxDevice->getVkDevice();
+    auto& tracker = getVkObjectTracker();
+
+    layoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+    if (vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &mDescriptorSetLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create bindless descriptor set layout!");
+    }
+    tracker->onCreate(mDescriptorSetLayout, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+    mGfxDevice->setObjectName(uint64_t(mDescriptorSetLayout), "BindlessBufferSetLayout", VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+
+    // fBXNv^̑傫Ɣzu̓foCXɈقȂ
+    VkPhysicalDeviceDescriptorBufferPropertiesEXT descriptor_buffer_properties{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT,
+    };
+    VkPhysicalDeviceProperties2 properties2{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+        .pNext = &descriptor_buffer_properties,
+    };
+    vkGetPhysicalDeviceProperties2(mGfxDevice->getVkPhysicalDevice(), &properties2);
+    mDescriptorSizes[sTextureBinding] = descriptor_buffer_properties.sampledImageDescriptorSize;
+    mDescriptorSizes[sSamplerBinding] = descriptor_buffer_properties.samplerDescriptorSize;
+    mDescriptorSizes[sStorageBufferBinding] = descriptor_buffer_properties.storageBufferDescriptorSize;
+
+    vkGetDescriptorSetLayoutSizeEXT(device, mDescriptorSetLayout, &mDescriptorBufferSize);
+    for (uint32_t binding : { sTextureBinding, sSamplerBinding, sStorageBufferBinding })
+    {
+        vkGetDescriptorSetLayoutBindingOffsetEXT(device, mDescriptorSetLayout, binding, &mBindingOffsets[binding]);
+    }
+    // Zbg̓obt@̐擪ɒûŁA傫zu̒Pʂɑ
+    const VkDeviceSize alignment = descriptor_buffer_properties.descriptorBufferOffsetAlignment;
+    mDescriptorBufferSize = (mDescriptorBufferSize + alignment - 1) / alignment * alignment;
+
+    // Tv[ƃ\[X𓯂ZbgɒûŁA̗prw肷
+    mGfxDevice->createBuffer(mDescriptorBufferSize,
+        VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        mDescriptorBuffer, mDescriptorBufferMemory);
+    mGfxDevice->setObjectName(uint64_t(mDescriptorBuffer), "BindlessDescriptorBuffer", VK_OBJECT_TYPE_BUFFER);
+    if (vkMapMemory(device, mDescriptorBufferMemory, 0, mDescriptorBufferSize, 0, reinterpret_cast<void**>(&mDescriptorBufferData)) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to map bindless descriptor buffer!");
+    }
+    mDescriptorBufferAddress = mGfxDevice->getBufferDeviceAddress(mDescriptorBuffer);
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::shutdown()
+{
+    if (mGfxDevice == nullptr)
+    {
+        return;
+    }
+    auto device = mGfxDevice->getVkDevice();
+    auto& tracker = getVkObjectTracker();
+
+    if (mDescriptorBuffer != VK_NULL_HANDLE)
+    {
+        vkUnmapMemory(device, mDescriptorBufferMemory);
+        mGfxDevice->destroyBuffer(mDescriptorBuffer, mDescriptorBufferMemory);
+        mDescriptorBufferData = nullptr;
+        mDescriptorBufferAddress = 0;
+        mDescriptorBufferSize = 0;
+    }
+    // Zbg̓v[ƈꏏɉ
+    if (mDescriptorPool != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorPool(device, mDescriptorPool, nullptr);
+        tracker->onDestroy(mDescriptorPool, VK_OBJECT_TYPE_DESCRIPTOR_POOL);
+    }
+    if (mDescriptorSetLayout != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorSetLayout(device, mDescriptorSetLayout, nullptr);
+        tracker->onDestroy(mDescriptorSetLayout, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+    }
+    mDescriptorPool = VK_NULL_HANDLE;
+    mDescriptorSetLayout = VK_NULL_HANDLE;
+    mDescriptorSet = VK_NULL_HANDLE;
+    mTextures = {};
+    mSamplers = {};
+    mStorageBuffers = {};
+    mBackend = DescriptorBackend::Pool;
+    mGfxDevice = nullptr;
+}
+//---------------------------------------------------------------------------
+VkPushConstantRange BindlessDescriptors::getPushConstantRange()
+{
+    return VkPushConstantRange{
+        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+        .offset = 0,
+        .size = sizeof(VertexPullConstants),
+    };
+}
+//---------------------------------------------------------------------------
+uint32_t BindlessDescriptors::registerTexture(VkImageView imageView)
+{
+    const VkDescriptorImageInfo image_info{
+        .imageView = imageView,
+        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+    };
+    std::lock_guard<std::mutex> lock(mMutex);
+    const uint32_t index = allocate_(mTextures, "texture");
+    write_(sTextureBinding, index, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, &image_info, nullptr);
+    return index;
+}
+//---------------------------------------------------------------------------
+uint32_t BindlessDescriptors::registerSampler(VkSampler sampler)
+{
+    const VkDescriptorImageInfo image_info{
+        .sampler = sampler,
+    };
+    std::lock_guard<std::mutex> lock(mMutex);
+    const uint32_t index = allocate_(mSamplers, "sampler");
+    write_(sSamplerBinding, index, VK_DESCRIPTOR_TYPE_SAMPLER, &image_info, nullptr);
+    return index;
+}
+//---------------------------------------------------------------------------
+uint32_t BindlessDescriptors::registerStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+{
+    const VkDescriptorBufferInfo buffer_info{
+        .buffer = buffer,
+        .offset = offset,
+        .range = range,
+    };
+    std::lock_guard<std::mutex> lock(mMutex);
+    const uint32_t index = allocate_(mStorageBuffers, "storage buffer");
+    write_(sStorageBufferBinding, index, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &buffer_info);
+    return index;
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::releaseTexture(uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    release_(mTextures, index);
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::releaseSampler(uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    release_(mSamplers, index);
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::releaseStorageBuffer(uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    release_(mStorageBuffers, index);
+}
+//---------------------------------------------------------------------------
+uint32_t BindlessDescriptors::allocate_(Slots& slots, const char* name)
+{
+    if (!isEnabled())
+    {
+        throw std::runtime_error("bindless descriptors are not enabled!");
+    }
+    const uint32_t index = slots.allocate();
+    if (index == sInvalidIndex)
+    {
+        fprintf(stderr, "[Bindless] %s array is full (%u)\n", name, slots.capacity);
+        throw std::runtime_error("failed to allocate bindless descriptor index!");
+    }
+    return index;
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::release_(Slots& slots, uint32_t index)
+{
+    if (index == sInvalidIndex || index >= slots.next)
+    {
+        return;
+    }
+    // vf͏ɎcĂ (L^ς݂̃R}hobt@QƂĂĂȂ)
+    slots.retired.push_back({ index, mFrameNumber });
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::write_(uint32_t binding, uint32_t index, VkDescriptorType type, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo)
+{
+    const auto start_time = std::chrono::steady_clock::now();
+    if (mBackend == DescriptorBackend::DescriptorBuffer)
+    {
+        writeDescriptorBuffer_(binding, index, type, imageInfo, bufferInfo);
+    }
+    else
+    {
+        writeDescriptorSet_(binding, index, type, imageInfo, bufferInfo);
+    }
+    mWriteUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_time).count();
+    mWriteCount++;
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::writeDescriptorSet_(uint32_t binding, uint32_t index, VkDescriptorType type, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo)
+{
+    // UPDATE_AFTER_BIND Ȃ̂ŁAZbgR}hobt@̎sł߂
+    const VkWriteDescriptorSet write{
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = mDescriptorSet,
+        .dstBinding = binding,
+        .dstArrayElement = index,
+        .descriptorCount = 1,
+        .descriptorType = type,
+        .pImageInfo = imageInfo,
+        .pBufferInfo = bufferInfo,
+    };
+    vkUpdateDescriptorSets(mGfxDevice->getVkDevice(), 1, &write, 0, nullptr);
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::writeDescriptorBuffer_(uint32_t binding, uint32_t index, VkDescriptorType type, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo)
+{
+    // hCo[ԂfBXNv^̃oCgz̗vf̈ʒuɃRs[邾
+    VkDescriptorGetInfoEXT get_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+        .type = type,
+    };
+    VkDescriptorAddressInfoEXT address_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT,
+    };
+    switch (type)
+    {
+    case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+        get_info.data.pSampledImage = imageInfo;
+        break;
+    case VK_DESCRIPTOR_TYPE_SAMPLER:
+        get_info.data.pSampler = &imageInfo->sampler;
+        break;
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        if (bufferInfo->range == VK_WHOLE_SIZE)
+        {
+            throw std::runtime_error("descriptor buffer requires an explicit storage buffer range!");
+        }
+        address_info.address = mGfxDevice->getBufferDeviceAddress(bufferInfo->buffer) + bufferInfo->offset;
+        address_info.range = bufferInfo->range;
+        get_info.data.pStorageBuffer = &address_info;
+        break;
+    default:
+        return;
+    }
+    const size_t descriptor_size = mDescriptorSizes[binding];
+    vkGetDescriptorEXT(mGfxDevice->getVkDevice(), &get_info, descriptor_size,
+        mDescriptorBufferData + mBindingOffsets[binding] + index * descriptor_size);
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::beginFrame()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFrameNumber++;
+
+    // s̃t[QƂȂȂԍėpł悤ɂ
+    for (Slots* slots : { &mTextures, &mSamplers, &mStorageBuffers })
+    {
+        auto it = std::remove_if(slots->retired.begin(), slots->retired.end(), [&](const Slots::Retired& retired) {
+            if (mFrameNumber - retired.retireFrame < sRetireFrameDelay)
+            {
+                return false;
+            }
+            slots->freeIndices.push_back(retired.index);
+            return true;
+        });
+        slots->retired.erase(it, slots->retired.end());
+    }
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet)
+{
+    mBindCount++;
+    if (mBackend == DescriptorBackend::Pool)
+    {
+        vkCmdBindDescriptorSets(commandBuffer, bindPoint, layout, firstSet, 1, &mDescriptorSet, 0, nullptr);
+        return;
+    }
+
+    // obt@̃AhXAZbg͂̐擪n܂̂ƂăItZbgݒ肷
+    const VkDescriptorBufferBindingInfoEXT binding_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT,
+        .address = mDescriptorBufferAddress,
+        .usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT,
+    };
+    vkCmdBindDescriptorBuffersEXT(commandBuffer, 1, &binding_info);
+    const uint32_t buffer_index = 0;
+    const VkDeviceSize offset = 0;
+    vkCmdSetDescriptorBufferOffsetsEXT(commandBuffer, bindPoint, layout, firstSet, 1, &buffer_index, &offset);
+}
+//---------------------------------------------------------------------------
+BindlessDescriptors::Stats BindlessDescriptors::getStats()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return Stats{
+        .textureCount = mTextures.getCount(),
+        .textureCapacity = mTextures.capacity,
+        .samplerCount = mSamplers.getCount(),
+        .samplerCapacity = mSamplers.capacity,
+        .storageBufferCount = mStorageBuffers.getCount(),
+        .storageBufferCapacity = mStorageBuffers.capacity,
+        .writeCount = mWriteCount,
+        .writeUs = mWriteUs,
+        .bindCount = mBindCount,
+        .backend = mBackend,
+        .bufferSize = mDescriptorBufferSize,
+    };
+}
+//---------------------------------------------------------------------------
+void BindlessDescriptors::drawImGui()
+{
+    ImGui::SeparatorText("Bindless");
+    if (!isEnabled())
+    {
+        ImGui::Text("Bindless: unsupported (descriptor indexing)");
+        return;
+    }
+    const Stats stats = getStats();
+    if (stats.backend == DescriptorBackend::DescriptorBuffer)
+    {
+        ImGui::Text("Backend: descriptor buffer (%llu bytes)", static_cast<unsigned long long>(stats.bufferSize));
+    }
+    else
+    {
+        ImGui::Text("Backend: descriptor pool");
+    }
+    ImGui::Text("Textures: %u / %u", stats.textureCount, stats.textureCapacity);
+    ImGui::Text("Samplers: %u / %u", stats.samplerCount, stats.samplerCapacity);
+    ImGui::Text("Storage buffers: %u / %u", stats.storageBufferCount, stats.storageBufferCapacity);
+    ImGui::Text("Descriptor writes: %llu (%.3f us/write)",
+        static_cast<unsigned long long>(stats.writeCount),
+        stats.writeCount > 0 ? stats.writeUs / double(stats.writeCount) : 0.0);
+    ImGui::Text("Binds: %llu", static_cast<unsigned long long>(stats.bindCount));
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
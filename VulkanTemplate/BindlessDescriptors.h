@@ -0,0 +1,221 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "GfxDevice.h"
+
+//---------------------------------------------------------------------------
+class BindlessDescriptors;
+std::unique_ptr<BindlessDescriptors>& getBindlessDescriptors();
+
+//---------------------------------------------------------------------------
+/*
+ * oChX`ŃvbV萔Ƃēn\[X̔ԍ (res/bindless.frag  DrawConstants ƍ킹邱)
+ */
+struct BindlessDrawConstants
+{
+	uint32_t textureIndex = 0;
+	uint32_t samplerIndex = 0;
+	uint32_t bufferIndex = 0;
+	uint32_t padding = 0;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * _v (res/vertex_pull.vert) œǂޒ_̑̌` (VF[_[ FORMAT_* ƍ킹邱)
+ */
+enum class VertexStreamFormat : uint32_t
+{
+	Float2 = 0,    // 32 rbg_ x2
+	Float3 = 1,    // 32 rbg_ x3
+	Half2 = 2,     // 16 rbg_ x2 (packHalf2x16)
+	Unorm8x4 = 3,  // 8 rbgK x4 (packUnorm4x8)
+};
+/*
+ * _̑1̒uꏊ
+ * _ i ̒l address + i * stride  format œǂ (address  stride  4 ̔{ł邱)
+ */
+struct VertexStream
+{
+	VkDeviceAddress address = 0;  // VK_KHR_buffer_device_address ̃AhX
+	uint32_t stride = 0;
+	VertexStreamFormat format = VertexStreamFormat::Float2;
+};
+/*
+ * _vŕ`悷ꍇ̃vbV萔 (res/vertex_pull.vert  PullConstants ƍ킹邱)
+ * _̌`̓vbV萔œn̂ŁApCvC͒_̌`Ɉ˂炸1ōς
+ */
+struct VertexPullConstants
+{
+	BindlessDrawConstants draw;
+	VertexStream position;
+	VertexStream color;
+	VertexStream texcoord;
+};
+static_assert(sizeof(VertexPullConstants) == 64, "VertexPullConstants must match the push constant block in res/vertex_pull.vert");
+
+//---------------------------------------------------------------------------
+/*
+ * fBXNv^̒uꏊ
+ */
+enum class DescriptorBackend
+{
+	Pool,              // fBXNv^v[̃Zbg vkUpdateDescriptorSets ŏ
+	DescriptorBuffer,  // VK_EXT_descriptor_buffer: }bvobt@ vkGetDescriptorEXT Œڏ
+};
+
+//---------------------------------------------------------------------------
+/*
+ * SẴeNX`ETv[EXg[Wobt@1̃fBXNv^Zbg̔zɓo^
+ * o^\[Xɂ͕ςȂԍ蓖ĂAVF[_[̓vbV萔Ŏ󂯎ԍŔz
+ * Zbg̓R}hobt@1x邾ŁA`斈̃fBXNv^͕̌svɂȂ
+ *
+ * oCfBO PARTIALLY_BOUND | UPDATE_AFTER_BIND Ȃ̂ŁAo^̗vfĂ悭A
+ * Zbg (L^ς݂̃R}hobt@s҂̊) łVvf߂
+ * ԍ͎s̃t[QƂȂȂ܂ōėpȂ
+ *
+ * DescriptorBackend::DescriptorBuffer ̏ꍇ̓Zbg̑ɃzXg猩obt@1A
+ * o^̓obt@ւ݂̃ōς (̓obt@̃AhXƃItZbg̐ݒɂȂ)
+ * ǂ API Ȃ̂ŁANIvVŐ؂ւēo^ƌ CPU ׂrł
+ * descriptor buffer ̃CAEg͒ʏ̃fBXNv^ZbgƓpCvCCAEgɍ݂łA
+ * pCvC̐ getPipelineCreateFlags ̃tOKvɂȂ
+ */
+class BindlessDescriptors
+{
+public:
+	// set 0 ̃oCfBOԍ
+	static constexpr uint32_t sTextureBinding = 0;
+	static constexpr uint32_t sSamplerBinding = 1;
+	static constexpr uint32_t sStorageBufferBinding = 2;
+	// z̗vf (foCX̏菬ꍇ͏ɍ킹)
+	static constexpr uint32_t sMaxTextures = 4096;
+	static constexpr uint32_t sMaxSamplers = 64;
+	static constexpr uint32_t sMaxStorageBuffers = 1024;
+	// ԍėp܂ł̃t[
+	static constexpr uint32_t sRetireFrameDelay = 3;
+	static constexpr uint32_t sInvalidIndex = UINT32_MAX;
+
+	struct Stats
+	{
+		uint32_t textureCount = 0;
+		uint32_t textureCapacity = 0;
+		uint32_t samplerCount = 0;
+		uint32_t samplerCapacity = 0;
+		uint32_t storageBufferCount = 0;
+		uint32_t storageBufferCapacity = 0;
+		uint64_t writeCount = 0;  // o^ŏ񂾃fBXNv^̐
+		double writeUs = 0.0;     // ݂ɂ CPU Ԃ̍v
+		uint64_t bindCount = 0;
+		DescriptorBackend backend = DescriptorBackend::Pool;
+		VkDeviceSize bufferSize = 0;  // descriptor buffer ̑傫
+	};
+
+public:
+	/*
+	 * descriptor indexing gȂꍇ͉AisEnabled  false ɂȂ
+	 * DescriptorBuffer vĂgȂꍇ Pool ɂȂ
+	 */
+	void initialize(GfxDevice* gfx_device, DescriptorBackend backend = DescriptorBackend::Pool);
+	void shutdown();
+
+	inline bool isEnabled() const { return mDescriptorSetLayout != VK_NULL_HANDLE; }
+	inline DescriptorBackend getBackend() const { return mBackend; }
+	inline VkDescriptorSetLayout getDescriptorSetLayout() const { return mDescriptorSetLayout; }
+	// Pool ̏ꍇ̂ݗL
+	inline VkDescriptorSet getDescriptorSet() const { return mDescriptorSet; }
+	/*
+	 * ̃ZbgCAEg܂ރpCvC̐ɕKvȃtO (GraphicsPipelineDesc::flags)
+	 */
+	inline VkPipelineCreateFlags getPipelineCreateFlags() const {
+		return mBackend == DescriptorBackend::DescriptorBuffer ? VkPipelineCreateFlags(VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT) : 0;
+	}
+	/*
+	 * BindlessDrawConstants n߂̃vbV萔͈̔
+	 * _v VertexPullConstants ܂傫ɂāASẴoChX̃pCvCŃCAEgL
+	 * (͈͂قȂƃCAEǧ݊ȂA؂ւxɃZbǧKvɂȂ)
+	 */
+	static VkPushConstantRange getPushConstantRange();
+
+	/*
+	 * \[Xo^ĔԍԂ (t̏ꍇ͗O𓊂)
+	 * eNX` SHADER_READ_ONLY_OPTIMAL ŎQƂ
+	 * Xg[Wobt@ descriptor buffer ł̓AhXŎQƂ̂ŁAVK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT ŐA
+	 * range  VK_WHOLE_SIZE ł͂Ȃۂ̑傫n
+	 */
+	uint32_t registerTexture(VkImageView imageView);
+	uint32_t registerSampler(VkSampler sampler);
+	uint32_t registerStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+	void releaseTexture(uint32_t index);
+	void releaseSampler(uint32_t index);
+	void releaseStorageBuffer(uint32_t index);
+
+	/*
+	 * t[̋E (CtCgtFX̑ҋ@AR}hL^O) ŌĂяo
+	 */
+	void beginFrame();
+	/*
+	 * layout  firstSet ɃoChX̃Zbg (R}hobt@1xł悢)
+	 */
+	void bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t firstSet = 0);
+
+	Stats getStats();
+	void drawImGui();
+
+private:
+	/*
+	 * z1̔ԍ̊蓖
+	 */
+	struct Slots
+	{
+		uint32_t capacity = 0;
+		uint32_t next = 0;                   // ܂gꂽƂ̂Ȃ擪̔ԍ
+		std::vector<uint32_t> freeIndices;   // ėpłԍ
+		struct Retired
+		{
+			uint32_t index;
+			uint64_t retireFrame;
+		};
+		std::vector<Retired> retired;        // ς݂Ŏs̃t[QƂĂ邩Ȃԍ
+
+		uint32_t allocate();
+		uint32_t getCount() const;
+	};
+
+	void createDescriptorSet_(VkDescriptorSetLayoutCreateInfo& layoutCreateInfo);
+	void createDescriptorBuffer_(VkDescriptorSetLayoutCreateInfo& layoutCreateInfo);
+
+	uint32_t allocate_(Slots& slots, const char* name);
+	void release_(Slots& slots, uint32_t index);
+	void write_(uint32_t binding, uint32_t index, VkDescriptorType type, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo);
+	void writeDescriptorSet_(uint32_t binding, uint32_t index, VkDescriptorType type, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo);
+	void writeDescriptorBuffer_(uint32_t binding, uint32_t index, VkDescriptorType type, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo);
+
+private:
+	GfxDevice* mGfxDevice = nullptr;
+	VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;
+	VkDescriptorPool mDescriptorPool = VK_NULL_HANDLE;
+	VkDescriptorSet mDescriptorSet = VK_NULL_HANDLE;
+	DescriptorBackend mBackend = DescriptorBackend::Pool;
+
+	// descriptor buffer (iIɃ}bvĂ)
+	VkBuffer mDescriptorBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory mDescriptorBufferMemory = VK_NULL_HANDLE;
+	VkDeviceSize mDescriptorBufferSize = 0;
+	VkDeviceAddress mDescriptorBufferAddress = 0;
+	uint8_t* mDescriptorBufferData = nullptr;
+	// oCfBÕobt@̃ItZbgƁAz̗vf1̑傫
+	std::array<VkDeviceSize, 3> mBindingOffsets{};
+	std::array<size_t, 3> mDescriptorSizes{};
+
+	// o^͓ǂݍ݃XbhĂ΂
+	std::mutex mMutex;
+	Slots mTextures;
+	Slots mSamplers;
+	Slots mStorageBuffers;
+	uint64_t mFrameNumber = 0;
+	uint64_t mWriteCount = 0;
+	double mWriteUs = 0.0;
+	uint64_t mBindCount = 0;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
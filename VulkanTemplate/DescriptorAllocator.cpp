@@ -0,0 +1,146 @@
+#include "DescriptorAllocator.h"
+#include <algorithm>
+#include <stdexcept>
+#include "VkObjectTracker.h"
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+void DescriptorAllocator::initialize(GfxDevice* gfx_device, uint32_t frameCount, const std::vector<VkDescriptorPoolSize>& setSizes, const char* name)
+{
+    mGfxDevice = gfx_device;
+    mName = name;
+    mSetSizes = setSizes;
+    // v[͍ŏ̊蓖Ăō (gȂΉȂ)
+    mFrames.assign(frameCount, FrameContext{});
+    mFrameIndex = 0;
+    mStats = Stats{};
+}
+//---------------------------------------------------------------------------
+void DescriptorAllocator::shutdown()
+{
+    if (mGfxDevice == nullptr)
+    {
+        return;
+    }
+    auto device = mGfxDevice->getVkDevice();
+    auto& tracker = getVkObjectTracker();
+    for (auto& frame : mFrames)
+    {
+        for (VkDescriptorPool pool : frame.pools)
+        {
+            vkDestroyDescriptorPool(device, pool, nullptr);
+            tracker->onDestroy(pool, VK_OBJECT_TYPE_DESCRIPTOR_POOL);
+        }
+    }
+    mFrames.clear();
+    mStats.poolCount = 0;
+    mGfxDevice = nullptr;
+}
+//---------------------------------------------------------------------------
+void DescriptorAllocator::beginFrame(uint32_t frameIndex)
+{
+    if (frameIndex >= mFrames.size())
+    {
+        return;
+    }
+    mFrameIndex = frameIndex;
+    FrameContext& frame = mFrames[frameIndex];
+
+    // gv[Zbg΂悢 (Zbg͂܂Ƃ߂ĉ)
+    auto device = mGfxDevice->getVkDevice();
+    const uint32_t used_pool_count = std::min(frame.currentPool + 1, static_cast<uint32_t>(frame.pools.size()));
+    for (uint32_t i = 0; i < used_pool_count; ++i)
+    {
+        vkResetDescriptorPool(device, frame.pools[i], 0);
+    }
+    mStats.lastSetCount = frame.setCount;
+    frame.currentPool = 0;
+    frame.setCount = 0;
+}
+//---------------------------------------------------------------------------
+VkDescriptorSet DescriptorAllocator::allocate(VkDescriptorSetLayout layout, uint32_t variableDescriptorCount)
+{
+    FrameContext& frame = mFrames[mFrameIndex];
+    auto device = mGfxDevice->getVkDevice();
+
+    while (true)
+    {
+        const bool is_new_pool = frame.currentPool >= frame.pools.size();
+        if (is_new_pool)
+        {
+            // ǉv[͑Õv[̔{̑傫ɂ
+            const uint32_t set_count = std::min(sInitialSetCount << std::min(frame.currentPool, 16u), sMaxPoolSetCount);
+            frame.pools.push_back(createPool_(set_count));
+        }
+
+        VkDescriptorSetVariableDescriptorCountAllocateInfo variable_count_info{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO,
+            .descriptorSetCount = 1,
+            .pDescriptorCounts = &variableDescriptorCount,
+        };
+        VkDescriptorSetAllocateInfo alloc_info{
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            .pNext = variableDescriptorCount > 0 ? &variable_count_info : nullptr,
+            .descriptorPool = frame.pools[frame.currentPool],
+            .descriptorSetCount = 1,
+            .pSetLayouts = &layout,
+        };
+        VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+        VkResult result = vkAllocateDescriptorSets(device, &alloc_info, &descriptor_set);
+        if (result == VK_SUCCESS)
+        {
+            frame.setCount++;
+            mStats.allocationCount++;
+            mStats.peakSetCount = std::max(mStats.peakSetCount, frame.setCount);
+            mStats.peakPoolCount = std::max(mStats.peakPoolCount, frame.currentPool + 1);
+            return descriptor_set;
+        }
+        // ̃v[łȂꍇ̓CAEgv[̍\ƍĂȂ
+        if ((result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL) || is_new_pool)
+        {
+            throw std::runtime_error("failed to allocate descriptor set!");
+        }
+        // ̃v[͎g؂̂Ŏ̃v[
+        frame.currentPool++;
+        mStats.growCount++;
+    }
+}
+//---------------------------------------------------------------------------
+VkDescriptorPool DescriptorAllocator::createPool_(uint32_t setCount)
+{
+    std::vector<VkDescriptorPoolSize> pool_sizes = mSetSizes;
+    for (auto& pool_size : pool_sizes)
+    {
+        pool_size.descriptorCount *= setCount;
+    }
+    // ʂ̉͂Ȃ̂ FREE_DESCRIPTOR_SET ͕tȂ
+    VkDescriptorPoolCreateInfo pool_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .maxSets = setCount,
+        .poolSizeCount = static_cast<uint32_t>(pool_sizes.size()),
+        .pPoolSizes = pool_sizes.data(),
+    };
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    if (vkCreateDescriptorPool(mGfxDevice->getVkDevice(), &pool_info, nullptr, &pool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create descriptor pool!");
+    }
+    // `ʂ̃v[̒ǉ͑z肵Ȃ̂ŁAԂɓłsĂ悢
+    VkObjectTracker::SteadyStateExemption exemption;
+    getVkObjectTracker()->onCreate(pool, VK_OBJECT_TYPE_DESCRIPTOR_POOL);
+    mGfxDevice->setObjectName(uint64_t(pool), mName, VK_OBJECT_TYPE_DESCRIPTOR_POOL);
+    mStats.poolCount++;
+    return pool;
+}
+//---------------------------------------------------------------------------
+void DescriptorAllocator::drawImGui()
+{
+    ImGui::SeparatorText(mName);
+    ImGui::Text("Pools: %u (peak %u per frame)", mStats.poolCount, mStats.peakPoolCount);
+    ImGui::Text("Sets per frame: %u (peak %u)", mStats.lastSetCount, mStats.peakSetCount);
+    ImGui::Text("Allocations: %llu  Grown: %llu",
+        static_cast<unsigned long long>(mStats.allocationCount),
+        static_cast<unsigned long long>(mStats.growCount));
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include "GfxDevice.h"
+
+//---------------------------------------------------------------------------
+/*
+ * t[ɎĝĂfBXNv^Zbg̊蓖
+ * t[ReLXgɃv[̃XgAv[ȂȂ (VK_ERROR_OUT_OF_POOL_MEMORY)
+ * ̃v[Ɉڂ (ΑO傫ȃv[ǉ)
+ * Zbg͌ʂɉÃt[̃CtCgtFX҂ beginFrame őSẴv[܂Ƃ߂ăZbg
+ * ʂɉȂv[̊蓖ẮAhCo[ł̓|C^i߂邾ōς
+ *
+ * v[͔jɎg񂷂̂ŁAt[ŕKvȐɗAȍ~͑Ȃ
+ * R}hL^ƓXbhg
+ */
+class DescriptorAllocator
+{
+public:
+	// ŏ̃v[ɊmۂZbg (ǉv[͔{Xɂ)
+	static constexpr uint32_t sInitialSetCount = 64;
+	static constexpr uint32_t sMaxPoolSetCount = 4096;
+
+	struct Stats
+	{
+		uint32_t poolCount = 0;       // St[̃v[
+		uint32_t peakPoolCount = 0;   // 1t[Ŏgv[̍ő
+		uint32_t peakSetCount = 0;    // 1t[Ŋ蓖ĂZbg̍ő
+		uint32_t lastSetCount = 0;    // OɃZbgt[Ŋ蓖ĂZbg
+		uint64_t allocationCount = 0;
+		uint64_t growCount = 0;       // v[肸Ɏ̃v[ֈڂ
+	};
+
+public:
+	/*
+	 * setSizes: Zbg1ɕKvȃfBXNv^ (ShaderLayout::getPoolSizes(set, 1) Ȃ)
+	 * v[̑傫͂Zbg{̂ɂȂ
+	 */
+	void initialize(GfxDevice* gfx_device, uint32_t frameCount, const std::vector<VkDescriptorPoolSize>& setSizes, const char* name);
+	void shutdown();
+
+	/*
+	 * frameIndex ̃t[̃v[SăZbgāAȍ~̊蓖Đɂ
+	 * ̃t[̃CtCgtFX҂ɌĂԂ
+	 */
+	void beginFrame(uint32_t frameIndex);
+	/*
+	 * ݂̃t[̃v[Zbg蓖Ă ( beginFrame œt[ɖ߂܂ŗL)
+	 * variableDescriptorCount: ϒ̃oCfBO̗vf (ShaderLayout::getVariableDescriptorCount)
+	 */
+	VkDescriptorSet allocate(VkDescriptorSetLayout layout, uint32_t variableDescriptorCount = 0);
+
+	inline const Stats& getStats() const { return mStats; }
+	void drawImGui();
+
+private:
+	struct FrameContext
+	{
+		std::vector<VkDescriptorPool> pools;
+		uint32_t currentPool = 0;  // 蓖Ē̃v[ (pools ̓Y)
+		uint32_t setCount = 0;     // ̃t[Ŋ蓖ĂZbg
+	};
+
+	VkDescriptorPool createPool_(uint32_t setCount);
+
+private:
+	GfxDevice* mGfxDevice = nullptr;
+	const char* mName = "";
+	std::vector<VkDescriptorPoolSize> mSetSizes;
+	std::vector<FrameContext> mFrames;
+	uint32_t mFrameIndex = 0;
+	Stats mStats;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include "DrawQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "OverdrawView.h"
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+// \[g1pXňrbg
+static constexpr uint32_t sRadixBits = 8;
+static constexpr uint32_t sRadixSize = 1u << sRadixBits;
+static constexpr uint32_t sRadixPassCount = 64 / sRadixBits;
+
+static uint32_t getKeyField(uint64_t key, uint32_t shift, uint32_t bits)
+{
+    return static_cast<uint32_t>((key >> shift) & ((uint64_t(1) << bits) - 1));
+}
+//---------------------------------------------------------------------------
+uint32_t DrawQueue::addPipeline(const GraphicsPipelineDesc& desc, VkPipelineLayout overdrawLayout)
+{
+    if (mPipelines.size() >= sMaxPipelines)
+    {
+        throw std::runtime_error("too many pipelines in draw queue!");
+    }
+    Pipeline pipeline;
+    pipeline.handle = getPipelineManager()->requestPipeline(desc);
+    pipeline.desc = desc;
+    if (overdrawLayout != VK_NULL_HANDLE)
+    {
+        pipeline.overdrawDesc = OverdrawView::makePipelineDesc(desc, overdrawLayout);
+        pipeline.overdrawHandle = getPipelineManager()->requestPipeline(pipeline.overdrawDesc);
+    }
+    mPipelines.push_back(std::move(pipeline));
+    return static_cast<uint32_t>(mPipelines.size() - 1);
+}
+//---------------------------------------------------------------------------
+uint32_t DrawQueue::addMaterial(const BindlessDrawConstants& constants)
+{
+    if (mMaterials.size() >= sMaxMaterials)
+    {
+        throw std::runtime_error("too many materials in draw queue!");
+    }
+    mMaterials.push_back(constants);
+    return static_cast<uint32_t>(mMaterials.size() - 1);
+}
+//---------------------------------------------------------------------------
+uint32_t DrawQueue::addMesh(const DrawMesh& mesh)
+{
+    if (mMeshes.size() >= sMaxMeshes)
+    {
+        throw std::runtime_error("too many meshes in draw queue!");
+    }
+    mMeshes.push_back(mesh);
+    return static_cast<uint32_t>(mMeshes.size() - 1);
+}
+//---------------------------------------------------------------------------
+void DrawQueue::setBackToFront(uint32_t layer, bool backToFront)
+{
+    mBackToFront[layer % sMaxLayers] = backToFront;
+}
+//---------------------------------------------------------------------------
+void DrawQueue::beginFrame()
+{
+    // z̗eʂ͎cĂÃt[ŊmۂȂ悤ɂ
+    mDraws.clear();
+    mSortItems.clear();
+}
+//---------------------------------------------------------------------------
+void DrawQueue::submit(uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth, uint32_t instanceCount, uint32_t firstInstance)
+{
+    const uint32_t index = static_cast<uint32_t>(mDraws.size());
+    mDraws.push_back(QueuedDraw{ instanceCount, firstInstance });
+    mSortItems.push_back(SortItem{
+        .key = makeSortKey(layer, pipeline, material, mesh, depth, mBackToFront[layer % sMaxLayers]),
+        .index = index,
+    });
+}
+//---------------------------------------------------------------------------
+void DrawQueue::record(VkCommandBuffer commandBuffer, DynamicStateCache& dynamicState, VkPipelineLayout layout, VkExtent2D extent, bool isOverdraw)
+{
+    const auto sort_start = std::chrono::steady_clock::now();
+    countUnsortedChanges_();
+    radixSort(mSortItems, mSortScratch);
+    const auto record_start = std::chrono::steady_clock::now();
+
+    mStats.submitCount = 0;
+    mStats.pipelineBindCount = 0;
+    mStats.materialBindCount = 0;
+    mStats.bufferBindCount = 0;
+
+    uint32_t bound_pipeline = UINT32_MAX;
+    uint32_t bound_material = UINT32_MAX;
+    VkBuffer bound_vertex_buffer = VK_NULL_HANDLE;
+    VkDeviceSize bound_vertex_offset = 0;
+    VkBuffer bound_index_buffer = VK_NULL_HANDLE;
+    VkIndexType bound_index_type = VK_INDEX_TYPE_UINT16;
+    for (const SortItem& item : mSortItems)
+    {
+        const uint32_t pipeline_index = getKeyField(item.key, sPipelineShift, sPipelineBits);
+        const uint32_t material_index = getKeyField(item.key, sMaterialShift, sMaterialBits);
+        const uint32_t mesh_index = getKeyField(item.key, sMeshShift, sMeshBits);
+
+        if (pipeline_index != bound_pipeline)
+        {
+            const Pipeline& entry = mPipelines[pipeline_index];
+            VkPipeline pipeline = isOverdraw ? entry.overdrawHandle.get() : entry.handle.get();
+            if (pipeline == VK_NULL_HANDLE)
+            {
+                continue;
+            }
+            dynamicState.bindPipeline(pipeline);
+            dynamicState.setPipelineState(isOverdraw ? entry.overdrawDesc : entry.desc, extent);
+            bound_pipeline = pipeline_index;
+            mStats.pipelineBindCount++;
+        }
+        // pCvCCAEg͋ʂȂ̂ŁApCvC؂ւĂvbV萔͎c
+        if (material_index != bound_material)
+        {
+            const BindlessDrawConstants& constants = mMaterials[material_index];
+            vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(constants), &constants);
+            bound_material = material_index;
+            mStats.materialBindCount++;
+        }
+        // bV̔ԍł͂Ȃobt@ŔׁAobt@L郁bVł͌Ȃ
+        const DrawMesh& mesh = mMeshes[mesh_index];
+        if (mesh.vertexBuffer != bound_vertex_buffer || mesh.vertexBufferOffset != bound_vertex_offset)
+        {
+            vkCmdBindVertexBuffers(commandBuffer, 0, 1, &mesh.vertexBuffer, &mesh.vertexBufferOffset);
+            bound_vertex_buffer = mesh.vertexBuffer;
+            bound_vertex_offset = mesh.vertexBufferOffset;
+            mStats.bufferBindCount++;
+        }
+        if (mesh.indexBuffer != bound_index_buffer || mesh.indexType != bound_index_type)
+        {
+            vkCmdBindIndexBuffer(commandBuffer, mesh.indexBuffer, 0, mesh.indexType);
+            bound_index_buffer = mesh.indexBuffer;
+            bound_index_type = mesh.indexType;
+            mStats.bufferBindCount++;
+        }
+
+        const QueuedDraw& draw = mDraws[item.index];
+        vkCmdDrawIndexed(commandBuffer, mesh.indexCount, draw.instanceCount, mesh.firstIndex, mesh.vertexOffset, draw.firstInstance);
+        mStats.submitCount++;
+    }
+
+    const auto record_end = std::chrono::steady_clock::now();
+    mStats.sortUs = std::chrono::duration<double, std::micro>(record_start - sort_start).count();
+    mStats.recordUs = std::chrono::duration<double, std::micro>(record_end - record_start).count();
+}
+//---------------------------------------------------------------------------
+uint64_t DrawQueue::makeSortKey(uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth, bool backToFront)
+{
+    constexpr uint32_t depth_max = (1u << sDepthBits) - 1;
+    uint32_t quantized_depth = static_cast<uint32_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>(depth_max) + 0.5f);
+    if (backToFront)
+    {
+        quantized_depth = depth_max - quantized_depth;
+    }
+    return (uint64_t(layer & (sMaxLayers - 1)) << sLayerShift) |
+        (uint64_t(pipeline & (sMaxPipelines - 1)) << sPipelineShift) |
+        (uint64_t(material & (sMaxMaterials - 1)) << sMaterialShift) |
+        (uint64_t(mesh & (sMaxMeshes - 1)) << sMeshShift) |
+        (uint64_t(quantized_depth) << sDepthShift);
+}
+//---------------------------------------------------------------------------
+void DrawQueue::radixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch)
+{
+    const size_t count = items.size();
+    if (count < 2)
+    {
+        return;
+    }
+    scratch.resize(count);
+
+    // SpX̃qXgO1̑Ő (8 pX 8KB Ȃ̂ŃLbVɎ܂)
+    std::array<std::array<uint32_t, sRadixSize>, sRadixPassCount> histograms{};
+    for (const SortItem& item : items)
+    {
+        uint64_t key = item.key;
+        for (uint32_t pass = 0; pass < sRadixPassCount; ++pass)
+        {
+            histograms[pass][key & (sRadixSize - 1)]++;
+            key >>= sRadixBits;
+        }
+    }
+
+    SortItem* src = items.data();
+    SortItem* dst = scratch.data();
+    for (uint32_t pass = 0; pass < sRadixPassCount; ++pass)
+    {
+        const uint32_t shift = pass * sRadixBits;
+        const auto& histogram = histograms[pass];
+        // SẴL[̌œȂт͕ςȂ
+        if (histogram[(src[0].key >> shift) & (sRadixSize - 1)] == count)
+        {
+            continue;
+        }
+
+        std::array<uint32_t, sRadixSize> offsets;
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < sRadixSize; ++digit)
+        {
+            offsets[digit] = offset;
+            offset += histogram[digit];
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            const SortItem& item = src[i];
+            dst[offsets[(item.key >> shift) & (sRadixSize - 1)]++] = item;
+        }
+        std::swap(src, dst);
+    }
+    // ւꍇ͌ʂƗp̔zɂ
+    if (src != items.data())
+    {
+        items.swap(scratch);
+    }
+}
+//---------------------------------------------------------------------------
+void DrawQueue::runSortBenchmark(uint32_t count)
+{
+    constexpr uint32_t iteration_count = 10;
+
+    // ۂ̃L[ɋ߂Â邽߁AC[ƃpCvC͏ȂA[x͑SɎU炷
+    std::mt19937_64 random(12345);
+    std::vector<SortItem> source(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const uint64_t value = random();
+        source[i] = SortItem{
+            .key = makeSortKey(static_cast<uint32_t>(value & 3), static_cast<uint32_t>((value >> 2) & 31),
+                static_cast<uint32_t>((value >> 8) & 1023), static_cast<uint32_t>((value >> 20) & 4095),
+                static_cast<float>((value >> 40) & 0xffff) / 65535.0f, false),
+            .index = i,
+        };
+    }
+
+    std::vector<SortItem> items;
+    std::vector<SortItem> scratch;
+    double radix_ms = 0.0;
+    double std_sort_ms = 0.0;
+    bool is_sorted = true;
+    for (uint32_t iteration = 0; iteration < iteration_count; ++iteration)
+    {
+        items = source;
+        auto start = std::chrono::steady_clock::now();
+        radixSort(items, scratch);
+        radix_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        is_sorted = is_sorted && std::is_sorted(items.begin(), items.end(), [](const SortItem& a, const SortItem& b) { return a.key < b.key; });
+
+        items = source;
+        start = std::chrono::steady_clock::now();
+        std::sort(items.begin(), items.end(), [](const SortItem& a, const SortItem& b) { return a.key < b.key; });
+        std_sort_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    radix_ms /= iteration_count;
+    std_sort_ms /= iteration_count;
+
+    fprintf(stderr, "[sort] keys=%u iterations=%u radix_ms=%.3f std_sort_ms=%.3f speedup=%.2fx sorted=%s\n",
+        count, iteration_count, radix_ms, std_sort_ms, radix_ms > 0.0 ? std_sort_ms / radix_ms : 0.0, is_sorted ? "yes" : "no");
+}
+//---------------------------------------------------------------------------
+void DrawQueue::countUnsortedChanges_()
+{
+    // בւO (ς񂾏) ɗׂ荇`ŃpCvCƃ}eAς
+    mStats.unsortedPipelineChangeCount = 0;
+    mStats.unsortedMaterialChangeCount = 0;
+    uint64_t previous_key = ~uint64_t(0);
+    for (const SortItem& item : mSortItems)
+    {
+        if (getKeyField(item.key, sPipelineShift, sPipelineBits) != getKeyField(previous_key, sPipelineShift, sPipelineBits))
+        {
+            mStats.unsortedPipelineChangeCount++;
+        }
+        if (getKeyField(item.key, sMaterialShift, sMaterialBits) != getKeyField(previous_key, sMaterialShift, sMaterialBits))
+        {
+            mStats.unsortedMaterialChangeCount++;
+        }
+        previous_key = item.key;
+    }
+}
+//---------------------------------------------------------------------------
+void DrawQueue::drawImGui()
+{
+    ImGui::SeparatorText("Draw queue");
+    ImGui::Text("Draws: %u  Sort: %.2f us  Record: %.2f us", mStats.submitCount, mStats.sortUs, mStats.recordUs);
+    ImGui::Text("Pipeline binds: %u (unsorted %u)", mStats.pipelineBindCount, mStats.unsortedPipelineChangeCount);
+    ImGui::Text("Material binds: %u (unsorted %u)", mStats.materialBindCount, mStats.unsortedMaterialChangeCount);
+    ImGui::Text("Buffer binds: %u", mStats.bufferBindCount);
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
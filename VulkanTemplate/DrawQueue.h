@@ -0,0 +1,156 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "GfxDevice.h"
+#include "PipelineManager.h"
+#include "DynamicStateCache.h"
+#include "BindlessDescriptors.h"
+
+//---------------------------------------------------------------------------
+/*
+ * DrawQueue ɓo^郁bV (obt@L郁bV̓obt@̌Ȃ)
+ */
+struct DrawMesh
+{
+	VkBuffer vertexBuffer = VK_NULL_HANDLE;
+	VkDeviceSize vertexBufferOffset = 0;
+	VkBuffer indexBuffer = VK_NULL_HANDLE;
+	VkIndexType indexType = VK_INDEX_TYPE_UINT16;
+	uint32_t indexCount = 0;
+	uint32_t firstIndex = 0;
+	int32_t vertexOffset = 0;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * `̒oL[
+ * `斈ɃC[EpCvCE}eAEbVE[x 64 rbg̃L[ɋl߂Đς݁A
+ * L^̑OɃL[ŕבւ邱ƂŁApCvCE}eAEobt@̕`ׂ荇킹
+ * L^͕בւɒHApCvCEvbV萔 (}eA)E_/CfbNXobt@͕ςݒ肷
+ *
+ * L[̃rbgzu (ʂ)
+ *   layer:8 | pipeline:10 | material:14 | mesh:16 | depth:16
+ * C[ŗDȂ̂ŁAC[̏ (s UI Ȃ) ̓pCvC̐؂ւD悳
+ * [x [0, 1]  16 rbgɗʎqAsetBackToFront C[ł͔]ĉȌɂ
+ *
+ * בւ 8 rbg LSD \[g (8 pX)
+ * SẴpX̃qXgOŏ1̑ŐASẴL[œ̃pX (gĂȂC[̏ʃrbgȂ) ͔΂
+ * L[ƕ`̔ԍ̑g (16 oCg) 𓮂A`̒g͓Ȃ
+ * ȃ\[gȂ̂ŁAL[`͐ς񂾏ɋL^
+ *
+ * R}hL^ƓXbhg
+ */
+class DrawQueue
+{
+public:
+	static constexpr uint32_t sLayerBits = 8;
+	static constexpr uint32_t sPipelineBits = 10;
+	static constexpr uint32_t sMaterialBits = 14;
+	static constexpr uint32_t sMeshBits = 16;
+	static constexpr uint32_t sDepthBits = 16;
+	static constexpr uint32_t sDepthShift = 0;
+	static constexpr uint32_t sMeshShift = sDepthShift + sDepthBits;
+	static constexpr uint32_t sMaterialShift = sMeshShift + sMeshBits;
+	static constexpr uint32_t sPipelineShift = sMaterialShift + sMaterialBits;
+	static constexpr uint32_t sLayerShift = sPipelineShift + sPipelineBits;
+	static_assert(sLayerShift + sLayerBits == 64, "sort key fields must fill 64 bits");
+
+	static constexpr uint32_t sMaxLayers = 1u << sLayerBits;
+	static constexpr uint32_t sMaxPipelines = 1u << sPipelineBits;
+	static constexpr uint32_t sMaxMaterials = 1u << sMaterialBits;
+	static constexpr uint32_t sMaxMeshes = 1u << sMeshBits;
+
+	// בւvf (index ͐ς񂾕`̔ԍ)
+	struct SortItem
+	{
+		uint64_t key;
+		uint32_t index;
+		uint32_t padding;
+	};
+
+	struct Stats
+	{
+		uint32_t submitCount = 0;        // OɋL^`̐
+		uint32_t pipelineBindCount = 0;
+		uint32_t materialBindCount = 0;  // vbV萔ݒ肵
+		uint32_t bufferBindCount = 0;    // _obt@ƃCfbNXobt@
+		// ς񂾏̂܂܋L^ꍇ̐؂ւ (rp)
+		uint32_t unsortedPipelineChangeCount = 0;
+		uint32_t unsortedMaterialChangeCount = 0;
+		double sortUs = 0.0;
+		double recordUs = 0.0;
+	};
+
+public:
+	/*
+	 * o^ԍL[ɋl߂ (o^̏ sMax*, ꂽꍇ͗O𓊂)
+	 * pCvC͂ǂpCvCCAEgŁABindlessDrawConstants ̃vbV萔
+	 * overdrawLayout nƃI[o[h[vp̃oAg (OverdrawView::makePipelineDesc)
+	 */
+	uint32_t addPipeline(const GraphicsPipelineDesc& desc, VkPipelineLayout overdrawLayout = VK_NULL_HANDLE);
+	uint32_t addMaterial(const BindlessDrawConstants& constants);
+	uint32_t addMesh(const DrawMesh& mesh);
+	/*
+	 * layer ̕`Ȍɂ (pA͎O牜)
+	 */
+	void setBackToFront(uint32_t layer, bool backToFront);
+
+	/*
+	 * Õt[Őς񂾕`̂Ă (o^pCvCE}eAEbV͎c)
+	 */
+	void beginFrame();
+	/*
+	 * depth  [0, 1] (͈͊O͊ۂ߂)
+	 */
+	void submit(uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+	inline uint32_t getSubmitCount() const { return static_cast<uint32_t>(mDraws.size()); }
+
+	/*
+	 * ς񂾕`L[̏ɋL^ (oChX̃Zbg͌ς݂ł邱)
+	 * RpCIĂȂpCvC̕`̓XLbv
+	 * isOverdraw ̏ꍇ̓I[o[h[vp̃oAgŕ` (I[o[h[̃Zbg͌ς݂ł邱)
+	 */
+	void record(VkCommandBuffer commandBuffer, DynamicStateCache& dynamicState, VkPipelineLayout layout, VkExtent2D extent, bool isOverdraw = false);
+
+	static uint64_t makeSortKey(uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth, bool backToFront);
+	/*
+	 * items L[̏ɕבւ (scratch ͍ƗpŁAĂяoŎg񂷂Ɗmۂ)
+	 */
+	static void radixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch);
+	/*
+	 * count ̗̃L[ radixSort  std::sort ŕבւĎԂׁAʂWG[ɏo
+	 */
+	static void runSortBenchmark(uint32_t count);
+
+	inline const Stats& getStats() const { return mStats; }
+	void drawImGui();
+
+private:
+	struct Pipeline
+	{
+		GraphicsPipelineDesc desc;
+		PipelineHandle handle;
+		GraphicsPipelineDesc overdrawDesc;
+		PipelineHandle overdrawHandle;
+	};
+	// `̒g (L[ɓȂ)
+	struct QueuedDraw
+	{
+		uint32_t instanceCount;
+		uint32_t firstInstance;
+	};
+
+	void countUnsortedChanges_();
+
+private:
+	std::vector<Pipeline> mPipelines;
+	std::vector<BindlessDrawConstants> mMaterials;
+	std::vector<DrawMesh> mMeshes;
+	std::array<bool, sMaxLayers> mBackToFront{};
+
+	std::vector<QueuedDraw> mDraws;
+	std::vector<SortItem> mSortItems;
+	std::vector<SortItem> mSortScratch;
+	Stats mStats;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "DynamicStateCache.h"
+#include <cstring>
+#include <vector>
+
+//---------------------------------------------------------------------------
+void DynamicStateCache::begin(VkCommandBuffer commandBuffer, const DynamicStateSupport& support)
+{
+    mCommandBuffer = commandBuffer;
+    mSupport = support;
+    mState = State{};
+    mStats = Stats{};
+}
+//---------------------------------------------------------------------------
+void DynamicStateCache::invalidate()
+{
+    mState = State{};
+}
+//---------------------------------------------------------------------------
+template<typename T>
+bool DynamicStateCache::update_(std::optional<T>& cached, const T& value)
+{
+    // Vulkan ̍\̂ operator== Ȃ̂ŃoCgŔr
+    if (cached.has_value() && memcmp(&*cached, &value, sizeof(T)) == 0)
+    {
+        mStats.skippedCount++;
+        return false;
+    }
+    cached = value;
+    mStats.commandCount++;
+    return true;
+}
+//---------------------------------------------------------------------------
+void DynamicStateCache::bindPipeline(VkPipeline pipeline)
+{
+    if (update_(mState.pipeline, pipeline))
+    {
+        vkCmdBindPipeline(mCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        // pCvCƃVF[_[IuWFNǧ͉
+        mState.vertexShader.reset();
+        mState.fragmentShader.reset();
+    }
+}
+//---------------------------------------------------------------------------
+void DynamicStateCache::bindShaders(VkShaderEXT vertexShader, VkShaderEXT fragmentShader)
+{
+    const bool is_vertex_changed = update_(mState.vertexShader, vertexShader);
+    const bool is_fragment_changed = update_(mState.fragmentShader, fragmentShader);
+    if (!is_vertex_changed && !is_fragment_changed)
+    {
+        return;
+    }
+    // ebZ[VƃWIg͗LɂĂȂ̂ŁA_ƃtOg΂悢
+    const VkShaderStageFlagBits stages[] = { VK_SHADER_STAGE_VERTEX_BIT, VK_SHADER_STAGE_FRAGMENT_BIT };
+    const VkShaderEXT shaders[] = { vertexShader, fragmentShader };
+    vkCmdBindShadersEXT(mCommandBuffer, 2, stages, shaders);
+    mState.pipeline.reset();
+}
+//---------------------------------------------------------------------------
+void DynamicStateCache::setPipelineState(const GraphicsPipelineDesc& desc, VkExtent2D extent)
+{
+    const VkViewport viewport{
+        .x = 0.0f,
+        .y = 0.0f,
+        .width = static_cast<float>(extent.width),
+        .height = static_cast<float>(extent.height),
+        .minDepth = 0.0f,
+        .maxDepth = 1.0f,
+    };
+    const VkRect2D scissor{
+        .offset = { 0, 0 },
+        .extent = extent,
+    };
+    if (update_(mState.viewport, viewport))
+    {
+        vkCmdSetViewport(mCommandBuffer, 0, 1, &viewport);
+    }
+    if (update_(mState.scissor, scissor))
+    {
+        vkCmdSetScissor(mCommandBuffer, 0, 1, &scissor);
+    }
+
+    setRasterizationState_(desc, false);
+    if (mSupport.colorBlend)
+    {
+        setColorBlendState_(desc.colorBlend);
+    }
+}
+//---------------------------------------------------------------------------
+void DynamicStateCache::setShaderObjectState(const GraphicsPipelineDesc& desc, VkExtent2D extent)
+{
+    const VkViewport viewport{
+        .x = 0.0f,
+        .y = 0.0f,
+        .width = static_cast<float>(extent.width),
+        .height = static_cast<float>(extent.height),
+        .minDepth = 0.0f,
+        .maxDepth = 1.0f,
+    };
+    const VkRect2D scissor{
+        .offset = { 0, 0 },
+        .extent = extent,
+    };
+    if (update_(mState.viewport, viewport))
+    {
+        vkCmdSetViewportWithCount(mCommandBuffer, 1, &viewport);
+    }
+    if (update_(mState.scissor, scissor))
+    {
+        vkCmdSetScissorWithCount(mCommandBuffer, 1, &scissor);
+    }
+
+    // _͂͋Lq̃nbVŔr
+    StateHasher hasher;
+    hasher.add(desc.vertexBindings);
+    hasher.add(desc.vertexAttributes);
+    if (update_(mState.vertexInputHash, hasher.get()))
+    {
+        std::vector<VkVertexInputBindingDescription2EXT> bindings;
+        std::vector<VkVertexInputAttributeDescription2EXT> attributes;
+        for (const auto& binding : desc.vertexBindings)
+        {
+            bindings.push_back(VkVertexInputBindingDescription2EXT{
+                .sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_BINDING_DESCRIPTION_2_EXT,
+                .binding = binding.binding,
+                .stride = binding.stride,
+                .inputRate = binding.inputRate,
+                .divisor = 1,
+            });
+        }
+        for (const auto& attribute : desc.vertexAttributes)
+        {
+            attributes.push_back(VkVertexInputAttributeDescription2EXT{
+                .sType = VK_STRUCTURE_TYPE_VERTEX_INPUT_ATTRIBUTE_DESCRIPTION_2_EXT,
+                .location = attribute.location,
+                .binding = attribute.binding,
+                .format = attribute.format,
+                .offset = attribute.offset,
+            });
+        }
+        vkCmdSetVertexInputEXT(mCommandBuffer,
+            static_cast<uint32_t>(bindings.size()), bindings.data(),
+            static_cast<uint32_t>(attributes.size()), attributes.data());
+    }
+
+    setRasterizationState_(desc, true);
+    setColorBlendState_(desc.colorBlend);
+
+    // LqɊ܂܂ȂԂ͏ɓlȂ̂ŁAR}hobt@1xݒ肷
+    if (!mState.isFixedStateSet)
+    {
+        const VkSampleMask sample_mask = ~0u;
+        vkCmdSetRasterizerDiscardEnable(mCommandBuffer, VK_FALSE);
+        vkCmdSetLineWidth(mCommandBuffer, 1.0f);
+        vkCmdSetDepthBiasEnable(mCommandBuffer, VK_FALSE);
+        vkCmdSetRasterizationSamplesEXT(mCommandBuffer, VK_SAMPLE_COUNT_1_BIT);
+        vkCmdSetSampleMaskEXT(mCommandBuffer, VK_SAMPLE_COUNT_1_BIT, &sample_mask);
+        vkCmdSetAlphaToCoverageEnableEXT(mCommandBuffer, VK_FALSE);
+        vkCmdSetDepthBoundsTestEnable(mCommandBuffer, VK_FALSE);
+        vkCmdSetStencilTestEnable(mCommandBuffer, VK_FALSE);
+        mStats.commandCount += 8;
+        mState.isFixedStateSet = true;
+    }
+}
+//---------------------------------------------------------------------------
+void DynamicStateCache::setRasterizationState_(const GraphicsPipelineDesc& desc, bool isAll)
+{
+    if (isAll || mSupport.extendedDynamicState)
+    {
+        if (update_(mState.topology, desc.topology))
+        {
+            vkCmdSetPrimitiveTopology(mCommandBuffer, desc.topology);
+        }
+        if (update_(mState.cullMode, desc.cullMode))
+        {
+            vkCmdSetCullMode(mCommandBuffer, desc.cullMode);
+        }
+        if (update_(mState.frontFace, desc.frontFace))
+        {
+            vkCmdSetFrontFace(mCommandBuffer, desc.frontFace);
+        }
+        if (update_(mState.depthTestEnable, desc.depthTestEnable))
+        {
+            vkCmdSetDepthTestEnable(mCommandBuffer, desc.depthTestEnable);
+        }
+        if (update_(mState.depthWriteEnable, desc.depthWriteEnable))
+        {
+            vkCmdSetDepthWriteEnable(mCommandBuffer, desc.depthWriteEnable);
+        }
+        if (update_(mState.depthCompareOp, desc.depthCompareOp))
+        {
+            vkCmdSetDepthCompareOp(mCommandBuffer, desc.depthCompareOp);
+        }
+    }
+    if ((isAll || mSupport.extendedDynamicState2) && update_(mState.primitiveRestartEnable, desc.primitiveRestartEnable))
+    {
+        vkCmdSetPrimitiveRestartEnable(mCommandBuffer, desc.primitiveRestartEnable);
+    }
+    if ((isAll || mSupport.polygonMode) && update_(mState.polygonMode, desc.polygonMode))
+    {
+        vkCmdSetPolygonModeEXT(mCommandBuffer, desc.polygonMode);
+    }
+}
+//---------------------------------------------------------------------------
+void DynamicStateCache::setColorBlendState_(const VkPipelineColorBlendAttachmentState& blend)
+{
+    // J[A^b`g1
+    if (update_(mState.colorBlendEnable, blend.blendEnable))
+    {
+        vkCmdSetColorBlendEnableEXT(mCommandBuffer, 0, 1, &blend.blendEnable);
+    }
+    if (update_(mState.colorWriteMask, blend.colorWriteMask))
+    {
+        vkCmdSetColorWriteMaskEXT(mCommandBuffer, 0, 1, &blend.colorWriteMask);
+    }
+    // uhȂꍇ͎gȂ̂Őݒ肵Ȃ
+    if (blend.blendEnable)
+    {
+        const VkColorBlendEquationEXT equation{
+            .srcColorBlendFactor = blend.srcColorBlendFactor,
+            .dstColorBlendFactor = blend.dstColorBlendFactor,
+            .colorBlendOp = blend.colorBlendOp,
+            .srcAlphaBlendFactor = blend.srcAlphaBlendFactor,
+            .dstAlphaBlendFactor = blend.dstAlphaBlendFactor,
+            .alphaBlendOp = blend.alphaBlendOp,
+        };
+        if (update_(mState.colorBlendEquation, equation))
+        {
+            vkCmdSetColorBlendEquationEXT(mCommandBuffer, 0, 1, &equation);
+        }
+    }
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+#include <optional>
+#include "GfxDevice.h"
+#include "PipelineState.h"
+
+//---------------------------------------------------------------------------
+/*
+ * R}hobt@ɐݒ肵pCvCEVF[_[EIXe[goĂAl̍ĐݒȂ
+ * R}hobt@̋L^Jn begin ĂԂ
+ *
+ * PipelineManager ̃pCvC͑SēԂ𓮓IɂĂ̂ŁAĂݒς݂̒l͗LȂ܂
+ * ȊÕpCvC (ImGui q[g}bvȂ)  invalidate ŊoĂl̂Ă
+ */
+class DynamicStateCache
+{
+public:
+	struct Stats
+	{
+		uint32_t commandCount = 0;  // ۂɋL^R}h
+		uint32_t skippedCount = 0;  // l̂ŏȂ
+	};
+
+public:
+	void begin(VkCommandBuffer commandBuffer, const DynamicStateSupport& support);
+	void invalidate();
+
+	void bindPipeline(VkPipeline pipeline);
+	void bindShaders(VkShaderEXT vertexShader, VkShaderEXT fragmentShader);
+
+	/*
+	 * PipelineManager ̃pCvCp
+	 * r[|[gƃVU[Asupport œIɂĂԂ desc ̒lŐݒ肷
+	 */
+	void setPipelineState(const GraphicsPipelineDesc& desc, VkExtent2D extent);
+	/*
+	 * VF[_[IuWFNgp
+	 * VF[_[IuWFNgɂ͏Ă܂ꂽԂ̂ŁA`ɕKvȑSĂ̏Ԃݒ肷
+	 */
+	void setShaderObjectState(const GraphicsPipelineDesc& desc, VkExtent2D extent);
+
+	inline VkCommandBuffer getCommandBuffer() const { return mCommandBuffer; }
+	inline const Stats& getStats() const { return mStats; }
+
+private:
+	/*
+	 * lςĂ cached XV true Ԃ
+	 */
+	template<typename T>
+	bool update_(std::optional<T>& cached, const T& value);
+
+	void setRasterizationState_(const GraphicsPipelineDesc& desc, bool isAll);
+	void setColorBlendState_(const VkPipelineColorBlendAttachmentState& blend);
+
+private:
+	struct State
+	{
+		std::optional<VkPipeline> pipeline;
+		std::optional<VkShaderEXT> vertexShader;
+		std::optional<VkShaderEXT> fragmentShader;
+		std::optional<VkViewport> viewport;
+		std::optional<VkRect2D> scissor;
+		std::optional<uint64_t> vertexInputHash;
+		std::optional<VkPrimitiveTopology> topology;
+		std::optional<VkBool32> primitiveRestartEnable;
+		std::optional<VkPolygonMode> polygonMode;
+		std::optional<VkCullModeFlags> cullMode;
+		std::optional<VkFrontFace> frontFace;
+		std::optional<VkBool32> depthTestEnable;
+		std::optional<VkBool32> depthWriteEnable;
+		std::optional<VkCompareOp> depthCompareOp;
+		std::optional<VkBool32> colorBlendEnable;
+		std::optional<VkColorBlendEquationEXT> colorBlendEquation;
+		std::optional<VkColorComponentFlags> colorWriteMask;
+		// VF[_[IuWFNgł̂ݐݒ肷Œl
+		bool isFixedStateSet = false;
+	};
+
+	VkCommandBuffer mCommandBuffer = VK_NULL_HANDLE;
+	DynamicStateSupport mSupport;
+	State mState;
+	Stats mStats;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -42,4 +42,28 @@ bool FileLoader::Load(std::filesystem::path filePath, std::vector<char>& fileDat
     }
     return false;
 }
+//---------------------------------------------------------------------------
+bool FileLoader::WriteAtomic(const std::filesystem::path& filePath, std::string_view fileData)
+{
+    std::filesystem::path temp_path = filePath;
+    temp_path += ".tmp";
+    {
+        std::ofstream outfile(temp_path, std::ios::binary | std::ios::trunc);
+        if (!outfile)
+        {
+            return false;
+        }
+        outfile.write(fileData.data(), fileData.size());
+        if (!outfile)
+        {
+            outfile.close();
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, filePath, ec);
+    return !ec;
+}
 //---------------------------------------------------------------------------
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <memory>
 #include <vector>
 #include <filesystem>
+#include <string_view>
 
 //---------------------------------------------------------------------------
 class FileLoader;
@@ -12,5 +13,10 @@ class FileLoader
 {
 public:
 	bool Load(std::filesystem::path filePath, std::vector<char>& fileData);
+	/*
+	 * ꎞt@C (filePath + ".tmp") ɏłu
+	 * ݓrŏIAr̃t@C𑼂̃vZXǂ񂾂肵ĂꂽeȂ
+	 */
+	bool WriteAtomic(const std::filesystem::path& filePath, std::string_view fileData);
 };
 //---------------------------------------------------------------------------
\ No newline at end of file
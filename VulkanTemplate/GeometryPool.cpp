@@ -0,0 +1,637 @@
+#include "GeometryPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include "Metrics.h"
+#include "VkObjectTracker.h"
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+static std::unique_ptr<GeometryPool> geometryPool = nullptr;
+std::unique_ptr<GeometryPool>& getGeometryPool()
+{
+    if (geometryPool == nullptr)
+    {
+        geometryPool = std::make_unique<GeometryPool>();
+    }
+    return geometryPool;
+}
+//---------------------------------------------------------------------------
+static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    // _̑傫 2 ׂ̂Ƃ͌Ȃ
+    return (value + alignment - 1) / alignment * alignment;
+}
+//---------------------------------------------------------------------------
+void GeometryPool::RangeAllocator::reset(VkDeviceSize capacity, VkDeviceSize used)
+{
+    mFreeRanges.clear();
+    mCapacity = capacity;
+    mFreeBytes = capacity - used;
+    if (used < capacity)
+    {
+        mFreeRanges.emplace(used, capacity - used);
+    }
+}
+//---------------------------------------------------------------------------
+VkDeviceSize GeometryPool::RangeAllocator::allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+    for (auto it = mFreeRanges.begin(); it != mFreeRanges.end(); ++it)
+    {
+        const VkDeviceSize range_begin = it->first;
+        const VkDeviceSize range_end = it->first + it->second;
+        const VkDeviceSize offset = alignUp(range_begin, alignment);
+        if (offset + size > range_end)
+        {
+            continue;
+        }
+        // ʒu킹̑Oƌ̗]͋󂫂Ɏc
+        mFreeRanges.erase(it);
+        if (offset > range_begin)
+        {
+            mFreeRanges.emplace(range_begin, offset - range_begin);
+        }
+        if (offset + size < range_end)
+        {
+            mFreeRanges.emplace(offset + size, range_end - (offset + size));
+        }
+        mFreeBytes -= size;
+        return offset;
+    }
+    return sInvalidOffset;
+}
+//---------------------------------------------------------------------------
+void GeometryPool::RangeAllocator::free(VkDeviceSize offset, VkDeviceSize size)
+{
+    VkDeviceSize begin = offset;
+    VkDeviceSize end = offset + size;
+    // Ő󂫂Ɨׂ荇Ă1ɂ܂Ƃ߂
+    auto next = mFreeRanges.lower_bound(offset);
+    if (next != mFreeRanges.begin())
+    {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == begin)
+        {
+            begin = prev->first;
+            mFreeRanges.erase(prev);
+        }
+    }
+    if (next != mFreeRanges.end() && next->first == end)
+    {
+        end += next->second;
+        mFreeRanges.erase(next);
+    }
+    mFreeRanges.emplace(begin, end - begin);
+    mFreeBytes += size;
+}
+//---------------------------------------------------------------------------
+void GeometryPool::initialize(GfxDevice* gfx_device, VkDeviceSize vertexCapacity, VkDeviceSize indexCapacity)
+{
+    mGfxDevice = gfx_device;
+    createBuffers_(vertexCapacity, indexCapacity, mVertexBuffer, mVertexMemory, mIndexBuffer, mIndexMemory);
+    updateVertexAddress_();
+    createStagingRing_(sDefaultStagingCapacity);
+    mVertexRanges.reset(vertexCapacity, 0);
+    mIndexRanges.reset(indexCapacity, 0);
+    mMeshes.clear();
+    mFreeHandles.clear();
+    mRetired.clear();
+    mRetiredBuffers.clear();
+    mPendingTransfers.clear();
+    mFrameNumber = 0;
+    mGeneration = 0;
+    mIsDefragmentRequested = false;
+    mStats = Stats{};
+}
+//---------------------------------------------------------------------------
+void GeometryPool::shutdown()
+{
+    if (mGfxDevice == nullptr)
+    {
+        return;
+    }
+    if (mStats.meshCount > 0)
+    {
+        fprintf(stderr, "[GeometryPool] %u meshes were not freed\n", mStats.meshCount);
+    }
+    retireTransfers_(true);
+    destroyRetiredBuffers_(true);
+    destroyStagingRing_();
+    mGfxDevice->destroyBuffer(mVertexBuffer, mVertexMemory);
+    mGfxDevice->destroyBuffer(mIndexBuffer, mIndexMemory);
+    mVertexAddress = 0;
+    mMeshes.clear();
+    mFreeHandles.clear();
+    mRetired.clear();
+    mGfxDevice = nullptr;
+}
+//---------------------------------------------------------------------------
+GeometryPool::MeshHandle GeometryPool::allocate(const void* vertices, uint32_t vertexCount, uint32_t vertexStride, std::span<const uint32_t> indices)
+{
+    if (vertices == nullptr || vertexCount == 0 || vertexStride == 0 || indices.empty())
+    {
+        throw std::invalid_argument("geometry pool mesh must not be empty!");
+    }
+    Mesh mesh{
+        .vertexSize = VkDeviceSize(vertexCount) * vertexStride,
+        .vertexStride = vertexStride,
+        .indexCount = static_cast<uint32_t>(indices.size()),
+    };
+    const VkDeviceSize index_size = indices.size_bytes();
+    // ԍS 1 ̃nh sInvalidMesh ƋʂłȂ̂ŎgȂ
+    if (mFreeHandles.empty() && mMeshes.size() >= sHandleIndexMask)
+    {
+        throw std::runtime_error("too many geometry pool meshes!");
+    }
+
+    if (!tryAllocate_(mesh, index_size))
+    {
+        // 󂫂̍vĂ΋lߒŎ܂AȂ΃obt@傫ċlߒ
+        const VkDeviceSize vertex_needed = alignUp(getPackedVertexSize_(), vertexStride) + mesh.vertexSize;
+        const VkDeviceSize index_needed = mStats.indexUsed + index_size;
+        VkDeviceSize vertex_capacity = mVertexRanges.getCapacity();
+        VkDeviceSize index_capacity = mIndexRanges.getCapacity();
+        while (vertex_capacity < vertex_needed)
+        {
+            vertex_capacity *= 2;
+        }
+        while (index_capacity < index_needed)
+        {
+            index_capacity *= 2;
+        }
+        repack_(vertex_capacity, index_capacity);
+        if (!tryAllocate_(mesh, index_size))
+        {
+            throw std::runtime_error("failed to allocate geometry pool memory!");
+        }
+    }
+
+    // Xe[WÕOɒ_ƃCfbNXׂ1xɓ]
+    const auto start_time = std::chrono::steady_clock::now();
+    const VkDeviceSize staging_size = mesh.vertexSize + index_size;
+    const VkDeviceSize staging_offset = allocateStaging_(staging_size);
+    memcpy(mStagingData + staging_offset, vertices, static_cast<size_t>(mesh.vertexSize));
+    memcpy(mStagingData + staging_offset + mesh.vertexSize, indices.data(), static_cast<size_t>(index_size));
+
+    VkCommandBuffer command_buffer = beginTransfer_();
+    const VkBufferCopy vertex_copy{
+        .srcOffset = staging_offset,
+        .dstOffset = mesh.vertexOffset,
+        .size = mesh.vertexSize,
+    };
+    vkCmdCopyBuffer(command_buffer, mStagingBuffer, mVertexBuffer, 1, &vertex_copy);
+    const VkBufferCopy index_copy{
+        .srcOffset = staging_offset + mesh.vertexSize,
+        .dstOffset = mesh.indexOffset,
+        .size = index_size,
+    };
+    vkCmdCopyBuffer(command_buffer, mStagingBuffer, mIndexBuffer, 1, &index_copy);
+    submitTransfer_(command_buffer);
+
+    auto& metrics = getMetricsRegistry();
+    static MetricCounter* upload_bytes = metrics->counter("upload_bytes_total", "Bytes uploaded to device local memory");
+    static MetricCounter* upload_time = metrics->counter("upload_time_us_total", "Time spent in blocking uploads in microseconds");
+    upload_bytes->add(staging_size);
+    upload_time->add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count()));
+
+    mesh.isLive = true;
+    uint32_t index = 0;
+    if (!mFreeHandles.empty())
+    {
+        index = mFreeHandles.back();
+        mFreeHandles.pop_back();
+        // ͉ɐi߂Ă
+        mesh.generation = mMeshes[index].generation;
+        mMeshes[index] = mesh;
+    }
+    else
+    {
+        index = static_cast<uint32_t>(mMeshes.size());
+        mMeshes.push_back(mesh);
+    }
+    mStats.meshCount++;
+    mStats.vertexUsed += mesh.vertexSize;
+    mStats.indexUsed += index_size;
+    return (mesh.generation << sHandleIndexBits) | index;
+}
+//---------------------------------------------------------------------------
+GeometryPool::MeshHandle GeometryPool::allocate(const void* vertices, uint32_t vertexCount, uint32_t vertexStride, std::span<const uint16_t> indices)
+{
+    const std::vector<uint32_t> wide_indices(indices.begin(), indices.end());
+    return allocate(vertices, vertexCount, vertexStride, std::span<const uint32_t>(wide_indices));
+}
+//---------------------------------------------------------------------------
+void GeometryPool::free(MeshHandle mesh)
+{
+    const uint32_t index = getMeshIndex_(mesh);
+    if (index == sHandleIndexMask)
+    {
+        return;
+    }
+    Mesh& entry = mMeshes[index];
+    const VkDeviceSize index_size = VkDeviceSize(entry.indexCount) * sizeof(uint32_t);
+    mRetired.push_back({ entry.vertexOffset, entry.vertexSize, entry.indexOffset, index_size, mFrameNumber });
+    mStats.meshCount--;
+    mStats.vertexUsed -= entry.vertexSize;
+    mStats.indexUsed -= index_size;
+    // i߂āAnh̔ԍėpbVQƂȂ悤ɂ
+    const uint32_t generation = (entry.generation + 1) & (UINT32_MAX >> sHandleIndexBits);
+    entry = Mesh{};
+    entry.generation = generation;
+    mFreeHandles.push_back(index);
+}
+//---------------------------------------------------------------------------
+GeometryDrawArgs GeometryPool::getDrawArgs(MeshHandle mesh) const
+{
+    const uint32_t index = getMeshIndex_(mesh);
+    if (index == sHandleIndexMask)
+    {
+        return GeometryDrawArgs{};
+    }
+    const Mesh& entry = mMeshes[index];
+    return GeometryDrawArgs{
+        .indexCount = entry.indexCount,
+        .firstIndex = static_cast<uint32_t>(entry.indexOffset / sizeof(uint32_t)),
+        .vertexOffset = static_cast<int32_t>(entry.vertexOffset / entry.vertexStride),
+    };
+}
+//---------------------------------------------------------------------------
+VkDeviceAddress GeometryPool::getVertexAddress(MeshHandle mesh) const
+{
+    const uint32_t index = getMeshIndex_(mesh);
+    if (index == sHandleIndexMask || mVertexAddress == 0)
+    {
+        return 0;
+    }
+    return mVertexAddress + mMeshes[index].vertexOffset;
+}
+//---------------------------------------------------------------------------
+bool GeometryPool::isValid(MeshHandle mesh) const
+{
+    return getMeshIndex_(mesh) != sHandleIndexMask;
+}
+//---------------------------------------------------------------------------
+uint32_t GeometryPool::getMeshIndex_(MeshHandle mesh) const
+{
+    const uint32_t index = mesh & sHandleIndexMask;
+    if (index >= mMeshes.size() || !mMeshes[index].isLive || mMeshes[index].generation != (mesh >> sHandleIndexBits))
+    {
+        return sHandleIndexMask;
+    }
+    return index;
+}
+//---------------------------------------------------------------------------
+void GeometryPool::beginFrame()
+{
+    mFrameNumber++;
+    auto it = std::remove_if(mRetired.begin(), mRetired.end(), [&](const Retired& retired) {
+        if (mFrameNumber - retired.retireFrame < sRetireFrameDelay)
+        {
+            return false;
+        }
+        mVertexRanges.free(retired.vertexOffset, retired.vertexSize);
+        mIndexRanges.free(retired.indexOffset, retired.indexSize);
+        return true;
+    });
+    mRetired.erase(it, mRetired.end());
+    retireTransfers_(false);
+    destroyRetiredBuffers_(false);
+
+    if (mIsDefragmentRequested)
+    {
+        mIsDefragmentRequested = false;
+        defragment();
+    }
+}
+//---------------------------------------------------------------------------
+void GeometryPool::defragment()
+{
+    if (mGfxDevice == nullptr)
+    {
+        return;
+    }
+    repack_(mVertexRanges.getCapacity(), mIndexRanges.getCapacity());
+}
+//---------------------------------------------------------------------------
+void GeometryPool::bind(VkCommandBuffer commandBuffer) const
+{
+    const VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &mVertexBuffer, &offset);
+    vkCmdBindIndexBuffer(commandBuffer, mIndexBuffer, 0, sIndexType);
+}
+//---------------------------------------------------------------------------
+void GeometryPool::createBuffers_(VkDeviceSize vertexCapacity, VkDeviceSize indexCapacity, VkBuffer& vertexBuffer, VkDeviceMemory& vertexMemory, VkBuffer& indexBuffer, VkDeviceMemory& indexMemory)
+{
+    // lߒŌÂobt@Vobt@֎ʂ̂ŁA]ɂ]ɂȂ
+    const VkBufferUsageFlags transfer_usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    // _vł̓VF[_[_obt@AhXœǂ
+    VkBufferUsageFlags vertex_usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | transfer_usage;
+    if (mGfxDevice->isBufferDeviceAddressEnabled())
+    {
+        vertex_usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
+    mGfxDevice->createBuffer(vertexCapacity, vertex_usage,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertexBuffer, vertexMemory);
+    mGfxDevice->setObjectName(uint64_t(vertexBuffer), "GeometryPoolVertices", VK_OBJECT_TYPE_BUFFER);
+    mGfxDevice->createBuffer(indexCapacity, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | transfer_usage,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indexBuffer, indexMemory);
+    mGfxDevice->setObjectName(uint64_t(indexBuffer), "GeometryPoolIndices", VK_OBJECT_TYPE_BUFFER);
+}
+//---------------------------------------------------------------------------
+void GeometryPool::updateVertexAddress_()
+{
+    mVertexAddress = mGfxDevice->isBufferDeviceAddressEnabled() ? mGfxDevice->getBufferDeviceAddress(mVertexBuffer) : 0;
+}
+//---------------------------------------------------------------------------
+void GeometryPool::repack_(VkDeviceSize vertexCapacity, VkDeviceSize indexCapacity)
+{
+    const auto start_time = std::chrono::steady_clock::now();
+
+    VkBuffer vertex_buffer = VK_NULL_HANDLE;
+    VkDeviceMemory vertex_memory = VK_NULL_HANDLE;
+    VkBuffer index_buffer = VK_NULL_HANDLE;
+    VkDeviceMemory index_memory = VK_NULL_HANDLE;
+    {
+        // lߒ (ImGui ̗vo^̊g) ͑z肵Ȃ̂ŁAԂɓłsĂ悢
+        VkObjectTracker::SteadyStateExemption exemption;
+        createBuffers_(vertexCapacity, indexCapacity, vertex_buffer, vertex_memory, index_buffer, index_memory);
+    }
+
+    // Ă郁bVԍ̏ɑOׂ
+    std::vector<VkBufferCopy> vertex_copies;
+    std::vector<VkBufferCopy> index_copies;
+    VkDeviceSize vertex_end = 0;
+    VkDeviceSize index_end = 0;
+    for (Mesh& mesh : mMeshes)
+    {
+        if (!mesh.isLive)
+        {
+            continue;
+        }
+        const VkDeviceSize vertex_offset = alignUp(vertex_end, mesh.vertexStride);
+        const VkDeviceSize index_size = VkDeviceSize(mesh.indexCount) * sizeof(uint32_t);
+        vertex_copies.push_back({ .srcOffset = mesh.vertexOffset, .dstOffset = vertex_offset, .size = mesh.vertexSize });
+        index_copies.push_back({ .srcOffset = mesh.indexOffset, .dstOffset = index_end, .size = index_size });
+        mesh.vertexOffset = vertex_offset;
+        mesh.indexOffset = index_end;
+        vertex_end = vertex_offset + mesh.vertexSize;
+        index_end += index_size;
+    }
+
+    if (!vertex_copies.empty())
+    {
+        // ʂO̓]݂̏ submitTransfer_ ̃oAŌĂ
+        VkCommandBuffer command_buffer = beginTransfer_();
+        vkCmdCopyBuffer(command_buffer, mVertexBuffer, vertex_buffer, static_cast<uint32_t>(vertex_copies.size()), vertex_copies.data());
+        vkCmdCopyBuffer(command_buffer, mIndexBuffer, index_buffer, static_cast<uint32_t>(index_copies.size()), index_copies.data());
+        submitTransfer_(command_buffer);
+    }
+
+    // s̃t[ƒoʂÂobt@ǂݏIĂj (GPU ͑҂Ȃ)
+    mRetiredBuffers.push_back({ mVertexBuffer, mVertexMemory, mFrameNumber });
+    mRetiredBuffers.push_back({ mIndexBuffer, mIndexMemory, mFrameNumber });
+    mVertexBuffer = vertex_buffer;
+    mVertexMemory = vertex_memory;
+    mIndexBuffer = index_buffer;
+    mIndexMemory = index_memory;
+    updateVertexAddress_();
+
+    // ς݂̗̈͐Vobt@ɂ͎ʂĂȂ̂ŁA҂Kv͖
+    mRetired.clear();
+    mVertexRanges.reset(vertexCapacity, vertex_end);
+    mIndexRanges.reset(indexCapacity, index_end);
+    mGeneration++;
+
+    mStats.defragmentCount++;
+    mStats.defragmentMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+    fprintf(stderr, "[GeometryPool] repacked %u meshes into %llu/%llu bytes (%.2f ms)\n", mStats.meshCount,
+        static_cast<unsigned long long>(vertex_end), static_cast<unsigned long long>(index_end), mStats.defragmentMs);
+}
+//---------------------------------------------------------------------------
+bool GeometryPool::tryAllocate_(Mesh& mesh, VkDeviceSize indexSize)
+{
+    mesh.vertexOffset = mVertexRanges.allocate(mesh.vertexSize, mesh.vertexStride);
+    if (mesh.vertexOffset == RangeAllocator::sInvalidOffset)
+    {
+        return false;
+    }
+    mesh.indexOffset = mIndexRanges.allocate(indexSize, sizeof(uint32_t));
+    if (mesh.indexOffset == RangeAllocator::sInvalidOffset)
+    {
+        mVertexRanges.free(mesh.vertexOffset, mesh.vertexSize);
+        return false;
+    }
+    return true;
+}
+//---------------------------------------------------------------------------
+VkDeviceSize GeometryPool::getPackedVertexSize_() const
+{
+    VkDeviceSize end = 0;
+    for (const Mesh& mesh : mMeshes)
+    {
+        if (mesh.isLive)
+        {
+            end = alignUp(end, mesh.vertexStride) + mesh.vertexSize;
+        }
+    }
+    return end;
+}
+//---------------------------------------------------------------------------
+void GeometryPool::createStagingRing_(VkDeviceSize capacity)
+{
+    mGfxDevice->createBuffer(capacity, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mStagingBuffer, mStagingMemory);
+    mGfxDevice->setObjectName(uint64_t(mStagingBuffer), "GeometryPoolStaging", VK_OBJECT_TYPE_BUFFER);
+    void* data = nullptr;
+    if (vkMapMemory(mGfxDevice->getVkDevice(), mStagingMemory, 0, capacity, 0, &data) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to map geometry staging buffer!");
+    }
+    mStagingData = static_cast<uint8_t*>(data);
+    mStagingCapacity = capacity;
+    mStagingHead = 0;
+    mStagingTail = 0;
+}
+//---------------------------------------------------------------------------
+void GeometryPool::destroyStagingRing_()
+{
+    if (mStagingBuffer == VK_NULL_HANDLE)
+    {
+        return;
+    }
+    vkUnmapMemory(mGfxDevice->getVkDevice(), mStagingMemory);
+    mGfxDevice->destroyBuffer(mStagingBuffer, mStagingMemory);
+    mStagingData = nullptr;
+    mStagingCapacity = 0;
+}
+//---------------------------------------------------------------------------
+VkDeviceSize GeometryPool::allocateStaging_(VkDeviceSize size)
+{
+    // 1xɓ]ʂO傫ꍇ́A҂Ă烊O傫
+    if (size > mStagingCapacity)
+    {
+        retireTransfers_(true);
+        VkDeviceSize capacity = mStagingCapacity;
+        while (capacity < size)
+        {
+            capacity *= 2;
+        }
+        // 傫ȃbV̓o^ɍ킹čL̂͑z肵Ȃ̂ŁAԂɓłsĂ悢
+        VkObjectTracker::SteadyStateExemption exemption;
+        destroyStagingRing_();
+        createStagingRing_(capacity);
+    }
+
+    // 擪ƏI[dȂ̂͋̎ɂ̂ŁAI[̎O܂łȂ
+    for (int retry = 0; retry < 2; ++retry)
+    {
+        if (mPendingTransfers.empty())
+        {
+            mStagingHead = 0;
+            mStagingTail = 0;
+        }
+        if (mStagingHead >= mStagingTail)
+        {
+            if (mStagingCapacity - mStagingHead >= size)
+            {
+                const VkDeviceSize offset = mStagingHead;
+                mStagingHead += size;
+                return offset;
+            }
+            // Ɏ܂Ȃΐ擪ɖ߂ (̗]͎gȂ)
+            if (size < mStagingTail)
+            {
+                mStagingHead = size;
+                return 0;
+            }
+        }
+        else if (mStagingTail - mStagingHead > size)
+        {
+            const VkDeviceSize offset = mStagingHead;
+            mStagingHead += size;
+            return offset;
+        }
+        // OtȂ̂ŁAoς݂̓]̊҂
+        mStats.stagingStallCount++;
+        retireTransfers_(true);
+    }
+    throw std::runtime_error("failed to allocate geometry staging memory!");
+}
+//---------------------------------------------------------------------------
+VkCommandBuffer GeometryPool::beginTransfer_()
+{
+    VkCommandBufferAllocateInfo allocate_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .commandPool = mGfxDevice->getCommandPool(),
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = 1,
+    };
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    if (vkAllocateCommandBuffers(mGfxDevice->getVkDevice(), &allocate_info, &command_buffer) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate geometry transfer command buffer!");
+    }
+    VkCommandBufferBeginInfo begin_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+    return command_buffer;
+}
+//---------------------------------------------------------------------------
+void GeometryPool::submitTransfer_(VkCommandBuffer commandBuffer)
+{
+    // L[Ɍォo` (_̓́E_v) Ɠ] (lߒ̎ʂ) ݂ǂ߂悤ɂ
+    const VkMemoryBarrier barrier{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT,
+    };
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 1, &barrier, 0, nullptr, 0, nullptr);
+    vkEndCommandBuffer(commandBuffer);
+
+    VkSubmitInfo submit_info{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &commandBuffer,
+    };
+    if (vkQueueSubmit(mGfxDevice->getGraphicsQueue(), 1, &submit_info, VK_NULL_HANDLE) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to submit geometry transfer!");
+    }
+    // ォot[̃tFX҂Ă΁A̓]IĂ
+    mPendingTransfers.push_back({ commandBuffer, mStagingHead, mFrameNumber });
+}
+//---------------------------------------------------------------------------
+void GeometryPool::retireTransfers_(bool waitAll)
+{
+    if (waitAll && !mPendingTransfers.empty())
+    {
+        vkQueueWaitIdle(mGfxDevice->getGraphicsQueue());
+    }
+    // oɏÎŁAO
+    size_t count = 0;
+    for (const PendingTransfer& transfer : mPendingTransfers)
+    {
+        if (!waitAll && mFrameNumber - transfer.submitFrame < sRetireFrameDelay)
+        {
+            break;
+        }
+        vkFreeCommandBuffers(mGfxDevice->getVkDevice(), mGfxDevice->getCommandPool(), 1, &transfer.commandBuffer);
+        mStagingTail = transfer.stagingEnd;
+        count++;
+    }
+    mPendingTransfers.erase(mPendingTransfers.begin(), mPendingTransfers.begin() + count);
+}
+//---------------------------------------------------------------------------
+void GeometryPool::destroyRetiredBuffers_(bool destroyAll)
+{
+    auto it = std::remove_if(mRetiredBuffers.begin(), mRetiredBuffers.end(), [&](RetiredBuffer& retired) {
+        if (!destroyAll && mFrameNumber - retired.retireFrame < sRetireFrameDelay)
+        {
+            return false;
+        }
+        mGfxDevice->destroyBuffer(retired.buffer, retired.memory);
+        return true;
+    });
+    mRetiredBuffers.erase(it, mRetiredBuffers.end());
+}
+//---------------------------------------------------------------------------
+const GeometryPool::Stats& GeometryPool::getStats()
+{
+    mStats.vertexCapacity = mVertexRanges.getCapacity();
+    mStats.indexCapacity = mIndexRanges.getCapacity();
+    mStats.vertexFreeRanges = mVertexRanges.getRangeCount();
+    mStats.indexFreeRanges = mIndexRanges.getRangeCount();
+    mStats.stagingCapacity = mStagingCapacity;
+    mStats.pendingTransferCount = static_cast<uint32_t>(mPendingTransfers.size());
+    mStats.retiredBufferCount = static_cast<uint32_t>(mRetiredBuffers.size());
+    mStats.retiredBytes = 0;
+    for (const Retired& retired : mRetired)
+    {
+        mStats.retiredBytes += retired.vertexSize + retired.indexSize;
+    }
+    return mStats;
+}
+//---------------------------------------------------------------------------
+void GeometryPool::drawImGui()
+{
+    const Stats& stats = getStats();
+    ImGui::SeparatorText("Geometry pool");
+    ImGui::Text("Meshes: %u  Generation: %llu", stats.meshCount, static_cast<unsigned long long>(mGeneration));
+    ImGui::Text("Vertices: %.1f / %.1f KB (%u free ranges)", stats.vertexUsed / 1024.0, stats.vertexCapacity / 1024.0, stats.vertexFreeRanges);
+    ImGui::Text("Indices: %.1f / %.1f KB (%u free ranges)", stats.indexUsed / 1024.0, stats.indexCapacity / 1024.0, stats.indexFreeRanges);
+    ImGui::Text("Retired: %.1f KB, %u buffers  Defragments: %u (%.2f ms)", stats.retiredBytes / 1024.0, stats.retiredBufferCount, stats.defragmentCount, stats.defragmentMs);
+    ImGui::Text("Staging: %.1f KB  Pending transfers: %u  Stalls: %u", stats.stagingCapacity / 1024.0, stats.pendingTransferCount, stats.stagingStallCount);
+    // L^̃R}hÂobt@QƂĂ̂ŁÃt[̎n߂ɋlߒ
+    if (ImGui::Button("Defragment"))
+    {
+        mIsDefragmentRequested = true;
+    }
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,229 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <span>
+#include <vector>
+#include "GfxDevice.h"
+
+//---------------------------------------------------------------------------
+class GeometryPool;
+std::unique_ptr<GeometryPool>& getGeometryPool();
+
+//---------------------------------------------------------------------------
+/*
+ * GeometryPool ɒubV̕`̈ (vkCmdDrawIndexed  VkDrawIndexedIndirectCommand ɂ̂܂ܓn)
+ */
+struct GeometryDrawArgs
+{
+	uint32_t indexCount = 0;
+	uint32_t firstIndex = 0;
+	int32_t vertexOffset = 0;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * SẴbV̒_ƃCfbNX傫Ȓ_obt@1ƃCfbNXobt@1ɋl߂Ēu
+ * bV firstIndex  vertexOffset ŋʂ̂ŁAobt@̌̓R}hobt@1xōς݁A
+ * قȂ郁bV̕`1̊Ԑڕ` (}`h[) ɂ܂Ƃ߂
+ *
+ * ̈̓obt@̋󂫃Xg (ItZbg) ŏɎ܂鏊؂oÄׂ͗̋󂫂ƌq
+ * _̗̈͒_̑傫̔{̈ʒuɒu (vertexOffset ͒_̐Ő邽)
+ * CfbNX͑S 32 rbgŎ (16 rbĝ͓̂o^ɍL)
+ * ͎̈s̃t[QƂȂȂ܂ (sRetireFrameDelay t[) ėpȂ
+ * nh̏ʃrbgɂ͐Aς݂̃nhŌォo^bVQƂȂ悤ɂ
+ *
+ * 󂫂fЉĎ܂Ȃꍇ defragment ŐĂ郁bVVobt@ɑOlߒ
+ * Ȃꍇ̓obt@傫ċlߒ
+ * lߒƕ`̈ς̂ŁAێ鑤 getGeneration ς getDrawArgs Ŏ蒼
+ * Âobt@͎s̃t[QƂȂȂ܂ (sRetireFrameDelay t[) jȂ
+ *
+ * obt@̃foCXAhXgꍇ́A_VF[_[AhXœǂ߂悤ɂ (_v)
+ *
+ * ]͎IɃ}bvXe[WÕOsA҂Ȃ
+ * ]̌ɃoAûŁAォo`͓]̌ʂǂ߂
+ * Ö̗Ɠ]̃R}hobt@ sRetireFrameDelay t[ɍėpEAOt̎L[̊҂
+ * o^EElߒ̓R}h̋L^ɌĂ΂Ȃ (lߒ̓obt@ւ)
+ */
+class GeometryPool
+{
+public:
+	using MeshHandle = uint32_t;
+	static constexpr MeshHandle sInvalidMesh = UINT32_MAX;
+	static constexpr VkIndexType sIndexType = VK_INDEX_TYPE_UINT32;
+	static constexpr VkDeviceSize sDefaultVertexCapacity = 16 * 1024 * 1024;
+	static constexpr VkDeviceSize sDefaultIndexCapacity = 8 * 1024 * 1024;
+	static constexpr VkDeviceSize sDefaultStagingCapacity = 4 * 1024 * 1024;
+	static constexpr uint32_t sRetireFrameDelay = 3;
+	// nh̉ʃrbg̓bV̔ԍAʃrbg͐
+	static constexpr uint32_t sHandleIndexBits = 20;
+	static constexpr uint32_t sHandleIndexMask = (1u << sHandleIndexBits) - 1;
+
+	struct Stats
+	{
+		uint32_t meshCount = 0;
+		VkDeviceSize vertexUsed = 0;       // Ă郁bV̒_̃oCg
+		VkDeviceSize vertexCapacity = 0;
+		VkDeviceSize indexUsed = 0;
+		VkDeviceSize indexCapacity = 0;
+		uint32_t vertexFreeRanges = 0;     // 󂫂̒fЂ̐
+		uint32_t indexFreeRanges = 0;
+		VkDeviceSize retiredBytes = 0;     // ς݂ōėp҂ĂoCg
+		uint32_t defragmentCount = 0;
+		double defragmentMs = 0.0;         // Őlߒɂ
+		VkDeviceSize stagingCapacity = 0;
+		uint32_t pendingTransferCount = 0; // ҂Ă]̐
+		uint32_t retiredBufferCount = 0;   // lߒōւĔj҂Ăobt@̐
+		uint32_t stagingStallCount = 0;    // OtŃL[̊҂
+	};
+
+public:
+	void initialize(GfxDevice* gfx_device, VkDeviceSize vertexCapacity = sDefaultVertexCapacity, VkDeviceSize indexCapacity = sDefaultIndexCapacity);
+	void shutdown();
+	inline bool isInitialized() const { return mGfxDevice != nullptr; }
+
+	/*
+	 * bVo^Ē_ƃCfbNX]
+	 * CfbNX̓bV̐擪̒_̔ԍ
+	 */
+	MeshHandle allocate(const void* vertices, uint32_t vertexCount, uint32_t vertexStride, std::span<const uint32_t> indices);
+	MeshHandle allocate(const void* vertices, uint32_t vertexCount, uint32_t vertexStride, std::span<const uint16_t> indices);
+	/*
+	 * ̃nh͖ɂȂAԍėpbV͎QƂȂ
+	 */
+	void free(MeshHandle mesh);
+	GeometryDrawArgs getDrawArgs(MeshHandle mesh) const;
+	bool isValid(MeshHandle mesh) const;
+
+	/*
+	 * QƂȂȂ̈Eobt@E]ЕtAImGui vꂽlߒs
+	 * t[̃CtCgtFX҂ɁAt[1xĂԂ
+	 */
+	void beginFrame();
+	/*
+	 * Ă郁bVVobt@ɑOlߒċ󂫂1ɂ܂Ƃ߂ (GPU ̊͑҂Ȃ)
+	 * o^ɋ󂫂Ȃꍇlߒs
+	 */
+	void defragment();
+	// lߒxɑ
+	inline uint64_t getGeneration() const { return mGeneration; }
+
+	/*
+	 * _obt@ (oCfBO 0) ƃCfbNXobt@
+	 */
+	void bind(VkCommandBuffer commandBuffer) const;
+	inline VkBuffer getVertexBuffer() const { return mVertexBuffer; }
+	inline VkBuffer getIndexBuffer() const { return mIndexBuffer; }
+	/*
+	 * bV̐擪̒_̃AhX (foCXAhXgȂꍇ 0)
+	 * lߒƕς̂ŁA`̓xɎ蒼
+	 */
+	VkDeviceAddress getVertexAddress(MeshHandle mesh) const;
+	inline bool isVertexAddressEnabled() const { return mVertexAddress != 0; }
+
+	const Stats& getStats();
+	void drawImGui();
+
+private:
+	/*
+	 * obt@̗̒̈̋󂫃Xg (L[̓ItZbgAl͑傫)
+	 */
+	class RangeAllocator
+	{
+	public:
+		static constexpr VkDeviceSize sInvalidOffset = ~VkDeviceSize(0);
+
+		void reset(VkDeviceSize capacity, VkDeviceSize used);
+		// alignment ̔{̈ʒu size ؂o (܂Ȃ sInvalidOffset)
+		VkDeviceSize allocate(VkDeviceSize size, VkDeviceSize alignment);
+		void free(VkDeviceSize offset, VkDeviceSize size);
+		inline VkDeviceSize getCapacity() const { return mCapacity; }
+		inline VkDeviceSize getFreeBytes() const { return mFreeBytes; }
+		inline uint32_t getRangeCount() const { return static_cast<uint32_t>(mFreeRanges.size()); }
+
+	private:
+		std::map<VkDeviceSize, VkDeviceSize> mFreeRanges;
+		VkDeviceSize mCapacity = 0;
+		VkDeviceSize mFreeBytes = 0;
+	};
+
+	struct Mesh
+	{
+		VkDeviceSize vertexOffset = 0;  // oCg
+		VkDeviceSize vertexSize = 0;
+		uint32_t vertexStride = 0;
+		VkDeviceSize indexOffset = 0;   // oCg
+		uint32_t indexCount = 0;
+		uint32_t generation = 0;        // xɑ (nh̏ʃrbg)
+		bool isLive = false;
+	};
+	// ς݂Ŏs̃t[QƂĂ邩Ȃ̈
+	struct Retired
+	{
+		VkDeviceSize vertexOffset;
+		VkDeviceSize vertexSize;
+		VkDeviceSize indexOffset;
+		VkDeviceSize indexSize;
+		uint64_t retireFrame;
+	};
+	// lߒōւÂobt@
+	struct RetiredBuffer
+	{
+		VkBuffer buffer;
+		VkDeviceMemory memory;
+		uint64_t retireFrame;
+	};
+	// oĊ҂ĂȂ]
+	struct PendingTransfer
+	{
+		VkCommandBuffer commandBuffer;
+		VkDeviceSize stagingEnd;        // ̓]gȌI[
+		uint64_t submitFrame;
+	};
+
+	void createBuffers_(VkDeviceSize vertexCapacity, VkDeviceSize indexCapacity, VkBuffer& vertexBuffer, VkDeviceMemory& vertexMemory, VkBuffer& indexBuffer, VkDeviceMemory& indexMemory);
+	void updateVertexAddress_();
+	void repack_(VkDeviceSize vertexCapacity, VkDeviceSize indexCapacity);
+	bool tryAllocate_(Mesh& mesh, VkDeviceSize indexSize);
+	// Ă郁bV̔ԍ (ȃnh̏ꍇ sHandleIndexMask)
+	uint32_t getMeshIndex_(MeshHandle mesh) const;
+
+	void createStagingRing_(VkDeviceSize capacity);
+	void destroyStagingRing_();
+	// O size ؂o (t̏ꍇ͓]̊҂)
+	VkDeviceSize allocateStaging_(VkDeviceSize size);
+	VkCommandBuffer beginTransfer_();
+	// oAuĒoA beginFrame ŉ
+	void submitTransfer_(VkCommandBuffer commandBuffer);
+	void retireTransfers_(bool waitAll);
+	void destroyRetiredBuffers_(bool destroyAll);
+	// Ă郁bVOl߂ꍇ̒_̏I[
+	VkDeviceSize getPackedVertexSize_() const;
+
+private:
+	GfxDevice* mGfxDevice = nullptr;
+	VkBuffer mVertexBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory mVertexMemory = VK_NULL_HANDLE;
+	VkDeviceAddress mVertexAddress = 0;
+	VkBuffer mIndexBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory mIndexMemory = VK_NULL_HANDLE;
+	RangeAllocator mVertexRanges;
+	RangeAllocator mIndexRanges;
+
+	VkBuffer mStagingBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory mStagingMemory = VK_NULL_HANDLE;
+	uint8_t* mStagingData = nullptr;
+	VkDeviceSize mStagingCapacity = 0;
+	VkDeviceSize mStagingHead = 0;      // ɏʒu
+	VkDeviceSize mStagingTail = 0;      // ҂ĂłÂ]̐擪
+	std::vector<PendingTransfer> mPendingTransfers;
+
+	std::vector<Mesh> mMeshes;
+	std::vector<uint32_t> mFreeHandles;  // 󂢂Ă郁bV̔ԍ
+	std::vector<Retired> mRetired;
+	std::vector<RetiredBuffer> mRetiredBuffers;
+	uint64_t mFrameNumber = 0;
+	uint64_t mGeneration = 0;
+	bool mIsDefragmentRequested = false;
+	Stats mStats;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
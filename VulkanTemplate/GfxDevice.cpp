@@ -1,7 +1,13 @@
 #include "GfxDevice.h"
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
 #include "Window.h"
+#include "VkObjectTracker.h"
+#include "StartupProfiler.h"
+#include "Metrics.h"
+#include "PipelineFeedback.h"
+#include "FileLoader.h"
 
 #if defined(_WIN32)
 #define GLFW_EXPOSE_NATIVE_WIN32
@@ -10,6 +16,10 @@
 #endif
 #include <stdexcept>
 #include <set>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <fstream>
 
 //---------------------------------------------------------------------------
 static std::unique_ptr<GfxDevice> gfxDevice = nullptr;
@@ -22,6 +32,23 @@ std::unique_ptr<GfxDevice>& getGfxDevice()
     return gfxDevice;
 }
 //---------------------------------------------------------------------------
+/*
+ * pCvCLbVt@C̐擪ɕtwb_[
+ * Vulkan ̃LbVwb_[ɂ̓hCo[o[W܂܂ȂߓƎɎ
+ */
+struct PipelineCacheFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint8_t  pipelineCacheUUID[VK_UUID_SIZE];
+    uint64_t dataSize;
+};
+static constexpr uint32_t sPipelineCacheMagic = 0x48435056; // "VPCH"
+static constexpr uint32_t sPipelineCacheVersion = 1;
+//---------------------------------------------------------------------------
 void CheckVkResult(VkResult res)
 {
     assert(res == VK_SUCCESS);
@@ -41,13 +68,42 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL DebugMessageUtilsCallback(
 //---------------------------------------------------------------------------
 void GfxDevice::Initialize(const DeviceInitParams& initParams)
 {
+    auto& profiler = getStartupProfiler();
+
     // Vulkan APIgpOVolk
+    profiler->beginPhase("volk");
     volkInitialize();
+    profiler->endPhase();
 
+    profiler->beginPhase("instance");
     initVkInstance_();
+    profiler->endPhase();
+
+    profiler->beginPhase("physical_device");
     initPhysicalDevice_();
-    initVkDevice_();
+    profiler->endPhase();
+
+    profiler->beginPhase("device");
+    initVkDevice_(initParams);
+    profiler->endPhase();
+
+    profiler->beginPhase("pipeline_cache");
+    initPipelineCache_();
+    profiler->endPhase();
+
+    profiler->beginPhase("surface");
     initWindowSurface_(initParams);
+    profiler->endPhase();
+
+    auto& metrics = getMetricsRegistry();
+    mPipelineCompileCount = metrics->counter("pipeline_compiles_total", "Number of graphics pipelines created");
+    mPipelineCompileTime = metrics->histogram("pipeline_compile_ms", "Graphics pipeline creation time in milliseconds",
+        { 0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0, 250.0, 1000.0 });
+
+    // NɍpCvC̃tB[hobNN|[gɊ܂߂
+    profiler->addReportSection("pipelines", [](std::ostream& out) {
+        getPipelineFeedback()->writeJson(out);
+    });
 }
 //---------------------------------------------------------------------------
 void GfxDevice::Shutdown()
@@ -57,6 +113,9 @@ void GfxDevice::Shutdown()
 
     if (mVkDevice != VK_NULL_HANDLE)
     {
+        // N̂߂ɃLbVۑĂj
+        savePipelineCache();
+        destroyPipelineCache_();
         destroyVkDevice_();
 
     }
@@ -90,6 +149,265 @@ void GfxDevice::setObjectName(uint64_t handle, const char* name, VkObjectType ty
         .pObjectName = name,
     };
     vkSetDebugUtilsObjectNameEXT(mVkDevice, &name_info);
+
+    // gbJ[̃|[głOg
+    getVkObjectTracker()->setName(handle, name, type);
+}
+//---------------------------------------------------------------------------
+bool GfxDevice::isDeviceExtensionAvailable(const char* name) const
+{
+    return std::any_of(mAvailableExtensions.begin(), mAvailableExtensions.end(), [name](const VkExtensionProperties& ext) {
+        return strcmp(ext.extensionName, name) == 0;
+    });
+}
+//---------------------------------------------------------------------------
+bool GfxDevice::isDeviceExtensionEnabled(const char* name) const
+{
+    return std::any_of(mEnabledExtensions.begin(), mEnabledExtensions.end(), [name](const char* ext) {
+        return strcmp(ext, name) == 0;
+    });
+}
+//---------------------------------------------------------------------------
+void GfxDevice::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& memory, std::source_location site)
+{
+    VkBufferCreateInfo buffer_create_info{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = size,
+        .usage = usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+    };
+    if (vkCreateBuffer(mVkDevice, &buffer_create_info, nullptr, &buffer) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create buffer!");
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(mVkDevice, buffer, &requirements);
+    // foCXAhX擾obt@̓ɂtOKv
+    VkMemoryAllocateFlagsInfo allocate_flags_info{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO,
+        .flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT,
+    };
+    VkMemoryAllocateInfo allocate_info{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) ? &allocate_flags_info : nullptr,
+        .allocationSize = requirements.size,
+        .memoryTypeIndex = getMemoryTypeIndex(requirements, properties),
+    };
+    if (vkAllocateMemory(mVkDevice, &allocate_info, nullptr, &memory) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate buffer memory!");
+    }
+    vkBindBufferMemory(mVkDevice, buffer, memory, 0);
+
+    auto& tracker = getVkObjectTracker();
+    tracker->onCreate(buffer, VK_OBJECT_TYPE_BUFFER, 0, site);
+    tracker->onCreate(memory, VK_OBJECT_TYPE_DEVICE_MEMORY, allocate_info.allocationSize, site);
+}
+//---------------------------------------------------------------------------
+VkDeviceAddress GfxDevice::getBufferDeviceAddress(VkBuffer buffer) const
+{
+    const VkBufferDeviceAddressInfo address_info{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+        .buffer = buffer,
+    };
+    return vkGetBufferDeviceAddress(mVkDevice, &address_info);
+}
+//---------------------------------------------------------------------------
+void GfxDevice::destroyBuffer(VkBuffer& buffer, VkDeviceMemory& memory)
+{
+    vkDestroyBuffer(mVkDevice, buffer, nullptr);
+    vkFreeMemory(mVkDevice, memory, nullptr);
+
+    auto& tracker = getVkObjectTracker();
+    tracker->onDestroy(buffer, VK_OBJECT_TYPE_BUFFER);
+    tracker->onDestroy(memory, VK_OBJECT_TYPE_DEVICE_MEMORY);
+    buffer = VK_NULL_HANDLE;
+    memory = VK_NULL_HANDLE;
+}
+//---------------------------------------------------------------------------
+void GfxDevice::createImage2D(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, VkImage& image, VkDeviceMemory& memory, std::source_location site)
+{
+    VkImageCreateInfo image_info{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = format,
+        .extent = {
+            .width = width,
+            .height = height,
+            .depth = 1,
+        },
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+    if (vkCreateImage(mVkDevice, &image_info, nullptr, &image) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create image!");
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(mVkDevice, image, &requirements);
+    VkMemoryAllocateInfo allocate_info{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .allocationSize = requirements.size,
+        .memoryTypeIndex = getMemoryTypeIndex(requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+    };
+    if (vkAllocateMemory(mVkDevice, &allocate_info, nullptr, &memory) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate image memory!");
+    }
+    vkBindImageMemory(mVkDevice, image, memory, 0);
+
+    auto& tracker = getVkObjectTracker();
+    tracker->onCreate(image, VK_OBJECT_TYPE_IMAGE, 0, site);
+    tracker->onCreate(memory, VK_OBJECT_TYPE_DEVICE_MEMORY, allocate_info.allocationSize, site);
+}
+//---------------------------------------------------------------------------
+void GfxDevice::destroyImage(VkImage& image, VkDeviceMemory& memory)
+{
+    vkDestroyImage(mVkDevice, image, nullptr);
+    vkFreeMemory(mVkDevice, memory, nullptr);
+
+    auto& tracker = getVkObjectTracker();
+    tracker->onDestroy(image, VK_OBJECT_TYPE_IMAGE);
+    tracker->onDestroy(memory, VK_OBJECT_TYPE_DEVICE_MEMORY);
+    image = VK_NULL_HANDLE;
+    memory = VK_NULL_HANDLE;
+}
+//---------------------------------------------------------------------------
+VkResult GfxDevice::createGraphicsPipeline(const VkGraphicsPipelineCreateInfo& createInfo, VkPipeline& pipeline, const char* name, std::source_location site)
+{
+    // LbVꂽAXe[WɂǂꂾhCo[ɕ񍐂
+    PipelineFeedback::Scope feedback;
+    PipelineFeedback::begin(feedback, createInfo);
+    VkGraphicsPipelineCreateInfo create_info = createInfo;
+    create_info.pNext = &feedback.createInfo;
+
+    const auto start_time = std::chrono::steady_clock::now();
+    VkResult result = vkCreateGraphicsPipelines(mVkDevice, mPipelineCache, 1, &create_info, nullptr, &pipeline);
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    mPipelineCompileCount->add();
+    mPipelineCompileTime->observe(elapsed_ms);
+    getPipelineFeedback()->end(feedback, name, elapsed_ms);
+    getVkObjectTracker()->onCreate(pipeline, VK_OBJECT_TYPE_PIPELINE, 0, site);
+    return result;
+}
+//---------------------------------------------------------------------------
+void GfxDevice::initPipelineCache_()
+{
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(mPhysicalDevice, &properties);
+
+    // ۑς݂̃LbVǂݍ݁AfoCX/hCo[ōꂽ̂mF
+    std::vector<char> initial_data;
+    std::ifstream infile(sPipelineCachePath, std::ios::binary);
+    if (infile)
+    {
+        const auto size = infile.seekg(0, std::ios::end).tellg();
+        std::vector<char> file_data(static_cast<size_t>(size));
+        infile.seekg(0, std::ios::beg).read(file_data.data(), size);
+
+        PipelineCacheFileHeader header{};
+        bool is_valid = file_data.size() >= sizeof(header);
+        if (is_valid)
+        {
+            memcpy(&header, file_data.data(), sizeof(header));
+            is_valid =
+                header.magic == sPipelineCacheMagic &&
+                header.version == sPipelineCacheVersion &&
+                header.vendorID == properties.vendorID &&
+                header.deviceID == properties.deviceID &&
+                header.driverVersion == properties.driverVersion &&
+                memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0 &&
+                header.dataSize == file_data.size() - sizeof(header);
+        }
+        if (is_valid)
+        {
+            initial_data.assign(file_data.begin() + sizeof(header), file_data.end());
+        }
+        else
+        {
+            fprintf(stderr, "[GfxDevice] %s does not match this device, ignored\n", sPipelineCachePath);
+        }
+    }
+
+    VkPipelineCacheCreateInfo create_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .initialDataSize = initial_data.size(),
+        .pInitialData = initial_data.empty() ? nullptr : initial_data.data(),
+    };
+    VkResult result = vkCreatePipelineCache(mVkDevice, &create_info, nullptr, &mPipelineCache);
+    if (result != VK_SUCCESS && !initial_data.empty())
+    {
+        // hCo[g󂯕tȂꍇ͋ō蒼
+        create_info.initialDataSize = 0;
+        create_info.pInitialData = nullptr;
+        result = vkCreatePipelineCache(mVkDevice, &create_info, nullptr, &mPipelineCache);
+    }
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create pipeline cache!");
+    }
+    fprintf(stderr, "[GfxDevice] pipeline cache: %zu bytes loaded\n", initial_data.size());
+}
+//---------------------------------------------------------------------------
+bool GfxDevice::savePipelineCache()
+{
+    if (mPipelineCache == VK_NULL_HANDLE)
+    {
+        return false;
+    }
+
+    size_t data_size = 0;
+    if (vkGetPipelineCacheData(mVkDevice, mPipelineCache, &data_size, nullptr) != VK_SUCCESS)
+    {
+        return false;
+    }
+    std::vector<char> data(data_size);
+    if (vkGetPipelineCacheData(mVkDevice, mPipelineCache, &data_size, data.data()) != VK_SUCCESS)
+    {
+        return false;
+    }
+    data.resize(data_size);
+
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(mPhysicalDevice, &properties);
+    PipelineCacheFileHeader header{
+        .magic = sPipelineCacheMagic,
+        .version = sPipelineCacheVersion,
+        .vendorID = properties.vendorID,
+        .deviceID = properties.deviceID,
+        .driverVersion = properties.driverVersion,
+        .dataSize = data.size(),
+    };
+    memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    std::string file_data(reinterpret_cast<const char*>(&header), sizeof(header));
+    file_data.append(data.data(), data.size());
+
+    // ݓrŏIĂꂽLbVcȂ悤ꎞt@Cu
+    if (!getFileLoader()->WriteAtomic(sPipelineCachePath, file_data))
+    {
+        fprintf(stderr, "[GfxDevice] failed to write %s\n", sPipelineCachePath);
+        return false;
+    }
+    return true;
+}
+//---------------------------------------------------------------------------
+void GfxDevice::destroyPipelineCache_()
+{
+    vkDestroyPipelineCache(mVkDevice, mPipelineCache, nullptr);
+    mPipelineCache = VK_NULL_HANDLE;
 }
 //---------------------------------------------------------------------------
 void GfxDevice::initVkInstance_()
@@ -170,7 +488,7 @@ void GfxDevice::initPhysicalDevice_()
     vkGetPhysicalDeviceMemoryProperties(mPhysicalDevice, &mMemoryProperties);
 }
 //---------------------------------------------------------------------------
-void GfxDevice::initVkDevice_()
+void GfxDevice::initVkDevice_(const DeviceInitParams& initParams)
 {
     QueueFamilyIndices indices = findQueueFamilies_();
 
@@ -189,19 +507,300 @@ void GfxDevice::initVkDevice_()
         queueCreateInfos.push_back(queueCreateInfo);
     }
 
+    // p\ȃfoCXg擾Ă
+    uint32_t extension_count = 0;
+    vkEnumerateDeviceExtensionProperties(mPhysicalDevice, nullptr, &extension_count, nullptr);
+    mAvailableExtensions.resize(extension_count);
+    vkEnumerateDeviceExtensionProperties(mPhysicalDevice, nullptr, &extension_count, mAvailableExtensions.data());
+    mEnabledExtensions = deviceExtensions;
+
+    // g@\̃tB[`[ pNext `FCŖ₢킹
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptor_buffer_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT,
+    };
+    VkPhysicalDeviceBufferDeviceAddressFeatures buffer_device_address_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES,
+        .pNext = &descriptor_buffer_features,
+    };
+    VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES,
+        .pNext = &buffer_device_address_features,
+    };
+    VkPhysicalDeviceExtendedDynamicState3FeaturesEXT extended_dynamic_state3_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT,
+        .pNext = &descriptor_indexing_features,
+    };
+    VkPhysicalDeviceShaderObjectFeaturesEXT shader_object_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT,
+        .pNext = &extended_dynamic_state3_features,
+    };
+    VkPhysicalDeviceDynamicRenderingFeatures dynamic_rendering_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES,
+        .pNext = &shader_object_features,
+    };
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT graphics_pipeline_library_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT,
+        .pNext = &dynamic_rendering_features,
+    };
+    VkPhysicalDevicePresentWaitFeaturesKHR present_wait_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR,
+        .pNext = &graphics_pipeline_library_features,
+    };
+    VkPhysicalDevicePresentIdFeaturesKHR present_id_features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+        .pNext = &present_wait_features,
+    };
+    VkPhysicalDeviceFeatures2 supported_features2{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext = &present_id_features,
+    };
+    vkGetPhysicalDeviceFeatures2(mPhysicalDevice, &supported_features2);
+    const VkPhysicalDeviceFeatures& supportedFeatures = supported_features2.features;
+
     VkPhysicalDeviceFeatures deviceFeatures{};
     deviceFeatures.samplerAnisotropy = VK_TRUE;
+    // I[o[h[\ŃtOgVF[_[Xg[WC[Wɏ
+    deviceFeatures.fragmentStoresAndAtomics = supportedFeatures.fragmentStoresAndAtomics;
+    // GPU 쓮̕`1̊Ԑڕ`ɕ̃R}hׁAfirstInstance ŃIuWFNgw
+    deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+    deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+    // oChX̃eNX`ETv[̔zvbV萔̔ԍ (`ňl) ň
+    deviceFeatures.shaderSampledImageArrayDynamicIndexing = supportedFeatures.shaderSampledImageArrayDynamicIndexing;
+    // GPU 쓮̕`ŃoChX̃Xg[Wobt@̔z𓯂ԍň
+    deviceFeatures.shaderStorageBufferArrayDynamicIndexing = supportedFeatures.shaderStorageBufferArrayDynamicIndexing;
+    mEnabledFeatures = deviceFeatures;
+
+    // LɂtB[`[̃`FC (KvȂ̂q)
+    VkPhysicalDeviceFeatures2 enabled_features2{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .features = deviceFeatures,
+    };
+    void** feature_chain_tail = &enabled_features2.pNext;
+    auto append_feature = [&](auto& feature) {
+        feature.pNext = nullptr;
+        *feature_chain_tail = &feature;
+        feature_chain_tail = &feature.pNext;
+    };
+
+    // \̌vp (present id  present wait ͑΂Ŏg)
+    mIsPresentWaitEnabled =
+        isDeviceExtensionAvailable(VK_KHR_PRESENT_ID_EXTENSION_NAME) &&
+        isDeviceExtensionAvailable(VK_KHR_PRESENT_WAIT_EXTENSION_NAME) &&
+        present_id_features.presentId &&
+        present_wait_features.presentWait;
+    VkPhysicalDevicePresentIdFeaturesKHR enable_present_id{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+        .presentId = VK_TRUE,
+    };
+    VkPhysicalDevicePresentWaitFeaturesKHR enable_present_wait{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR,
+        .presentWait = VK_TRUE,
+    };
+    if (mIsPresentWaitEnabled)
+    {
+        mEnabledExtensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+        mEnabledExtensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+        append_feature(enable_present_id);
+        append_feature(enable_present_wait);
+    }
+
+    // pCvCXe[W̃CuɕăRpCANőgݗĂ
+    mIsGraphicsPipelineLibraryEnabled =
+        isDeviceExtensionAvailable(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+        isDeviceExtensionAvailable(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+        graphics_pipeline_library_features.graphicsPipelineLibrary;
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT enable_graphics_pipeline_library{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT,
+        .graphicsPipelineLibrary = VK_TRUE,
+    };
+    if (mIsGraphicsPipelineLibraryEnabled)
+    {
+        mEnabledExtensions.push_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+        mEnabledExtensions.push_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+        append_feature(enable_graphics_pipeline_library);
+
+        VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT graphics_pipeline_library_properties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT,
+        };
+        VkPhysicalDeviceProperties2 properties2{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            .pNext = &graphics_pipeline_library_properties,
+        };
+        vkGetPhysicalDeviceProperties2(mPhysicalDevice, &properties2);
+        mHasGraphicsPipelineLibraryFastLinking = graphics_pipeline_library_properties.graphicsPipelineLibraryFastLinking;
+    }
+
+    // VF[_[IuWFNg̓_[pXȂ̂ Dynamic Rendering (Vulkan 1.3) ̒ŕ`悷
+    // pCvĈ݂̏ꍇƏ𑵂邽߁AvꂽLɂ
+    mIsShaderObjectEnabled =
+        initParams.requestShaderObject &&
+        isSupportVulkan13() &&
+        isDeviceExtensionAvailable(VK_EXT_SHADER_OBJECT_EXTENSION_NAME) &&
+        shader_object_features.shaderObject &&
+        dynamic_rendering_features.dynamicRendering;
+    VkPhysicalDeviceShaderObjectFeaturesEXT enable_shader_object{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT,
+        .shaderObject = VK_TRUE,
+    };
+    VkPhysicalDeviceDynamicRenderingFeatures enable_dynamic_rendering{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES,
+        .dynamicRendering = VK_TRUE,
+    };
+    if (mIsShaderObjectEnabled)
+    {
+        mEnabledExtensions.push_back(VK_EXT_SHADER_OBJECT_EXTENSION_NAME);
+        append_feature(enable_shader_object);
+        append_feature(enable_dynamic_rendering);
+    }
+    else if (initParams.requestShaderObject)
+    {
+        fprintf(stderr, "[GfxDevice] VK_EXT_shader_object is not available, falling back to pipelines\n");
+    }
+
+    // pCvC̏Ԃ𓮓IXe[gɂāAlقȂpCvC1ɂ܂Ƃ߂
+    // extended_dynamic_state 1, 2  Vulkan 1.3 ̃RA@\Ȃ̂ŗL͕sv
+    const bool is_vulkan13 = isSupportVulkan13();
+    mDynamicStateSupport.extendedDynamicState = is_vulkan13;
+    mDynamicStateSupport.extendedDynamicState2 = is_vulkan13;
+    VkPhysicalDeviceExtendedDynamicState3FeaturesEXT enable_extended_dynamic_state3{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT,
+    };
+    if (isDeviceExtensionAvailable(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME))
+    {
+        mDynamicStateSupport.polygonMode = extended_dynamic_state3_features.extendedDynamicState3PolygonMode;
+        mDynamicStateSupport.colorBlend =
+            extended_dynamic_state3_features.extendedDynamicState3ColorBlendEnable &&
+            extended_dynamic_state3_features.extendedDynamicState3ColorBlendEquation &&
+            extended_dynamic_state3_features.extendedDynamicState3ColorWriteMask;
+        if (mDynamicStateSupport.polygonMode || mDynamicStateSupport.colorBlend)
+        {
+            enable_extended_dynamic_state3.extendedDynamicState3PolygonMode = mDynamicStateSupport.polygonMode;
+            enable_extended_dynamic_state3.extendedDynamicState3ColorBlendEnable = mDynamicStateSupport.colorBlend;
+            enable_extended_dynamic_state3.extendedDynamicState3ColorBlendEquation = mDynamicStateSupport.colorBlend;
+            enable_extended_dynamic_state3.extendedDynamicState3ColorWriteMask = mDynamicStateSupport.colorBlend;
+            mEnabledExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+            append_feature(enable_extended_dynamic_state3);
+
+            VkPhysicalDeviceExtendedDynamicState3PropertiesEXT extended_dynamic_state3_properties{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_PROPERTIES_EXT,
+            };
+            VkPhysicalDeviceProperties2 properties2{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+                .pNext = &extended_dynamic_state3_properties,
+            };
+            vkGetPhysicalDeviceProperties2(mPhysicalDevice, &properties2);
+            mDynamicStateSupport.unrestrictedTopology = is_vulkan13 && extended_dynamic_state3_properties.dynamicPrimitiveTopologyUnrestricted;
+        }
+    }
+
+    // oChX: SẴeNX`ETv[EXg[Wobt@1̑傫ȃfBXNv^zɒu
+    // descriptor indexing  Vulkan 1.2 ̃RA@\Ȃ̂Ŋg̗L͕sv
+    mIsDescriptorIndexingEnabled =
+        isSupportVulkan12() &&
+        deviceFeatures.shaderSampledImageArrayDynamicIndexing &&
+        descriptor_indexing_features.runtimeDescriptorArray &&
+        descriptor_indexing_features.descriptorBindingPartiallyBound &&
+        descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind &&
+        descriptor_indexing_features.descriptorBindingStorageBufferUpdateAfterBind &&
+        descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing &&
+        descriptor_indexing_features.shaderStorageBufferArrayNonUniformIndexing;
+    mIsVariableDescriptorCountEnabled = mIsDescriptorIndexingEnabled && descriptor_indexing_features.descriptorBindingVariableDescriptorCount;
+    VkPhysicalDeviceDescriptorIndexingFeatures enable_descriptor_indexing{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES,
+        .shaderSampledImageArrayNonUniformIndexing = VK_TRUE,
+        .shaderStorageBufferArrayNonUniformIndexing = VK_TRUE,
+        .descriptorBindingSampledImageUpdateAfterBind = VK_TRUE,
+        .descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE,
+        .descriptorBindingPartiallyBound = VK_TRUE,
+        .descriptorBindingVariableDescriptorCount = mIsVariableDescriptorCountEnabled ? VK_TRUE : VK_FALSE,
+        .runtimeDescriptorArray = VK_TRUE,
+    };
+    if (mIsDescriptorIndexingEnabled)
+    {
+        append_feature(enable_descriptor_indexing);
+    }
+    else
+    {
+        fprintf(stderr, "[GfxDevice] descriptor indexing is not available, bindless descriptors are disabled\n");
+    }
+
+    // obt@̃foCXAhX (Vulkan 1.2 RA)
+    mIsBufferDeviceAddressEnabled = isSupportVulkan12() && buffer_device_address_features.bufferDeviceAddress;
+    VkPhysicalDeviceBufferDeviceAddressFeatures enable_buffer_device_address{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES,
+        .bufferDeviceAddress = VK_TRUE,
+    };
+    if (mIsBufferDeviceAddressEnabled)
+    {
+        append_feature(enable_buffer_device_address);
+    }
+
+    // fBXNv^obt@ɒڏ (fBXNv^v[Ƃ̔rpȂ̂ŗvꂽLɂ)
+    // oChX̃Zbgû descriptor indexing Kv
+    mIsDescriptorBufferEnabled =
+        initParams.requestDescriptorBuffer &&
+        mIsDescriptorIndexingEnabled &&
+        mIsBufferDeviceAddressEnabled &&
+        isDeviceExtensionAvailable(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME) &&
+        descriptor_buffer_features.descriptorBuffer;
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT enable_descriptor_buffer{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT,
+        .descriptorBuffer = VK_TRUE,
+    };
+    if (mIsDescriptorBufferEnabled)
+    {
+        mEnabledExtensions.push_back(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+        append_feature(enable_descriptor_buffer);
+    }
+    else if (initParams.requestDescriptorBuffer)
+    {
+        fprintf(stderr, "[GfxDevice] VK_EXT_descriptor_buffer is not available, falling back to descriptor pools\n");
+    }
+
+    // `斈̃fBXNv^Zbg蓖ĂɃR}hobt@֒ڏ (tB[`[͖)
+    mIsPushDescriptorEnabled = isDeviceExtensionAvailable(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+    if (mIsPushDescriptorEnabled)
+    {
+        mEnabledExtensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+
+        VkPhysicalDevicePushDescriptorPropertiesKHR push_descriptor_properties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR,
+        };
+        VkPhysicalDeviceProperties2 properties2{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+            .pNext = &push_descriptor_properties,
+        };
+        vkGetPhysicalDeviceProperties2(mPhysicalDevice, &properties2);
+        mMaxPushDescriptors = push_descriptor_properties.maxPushDescriptors;
+    }
+    else
+    {
+        fprintf(stderr, "[GfxDevice] VK_KHR_push_descriptor is not available, falling back to per-frame descriptor sets\n");
+    }
+
+    // `搔 GPU obt@ǂ (gLɂ drawIndirectCount LɂȂ̂ŃtB[`[͌qȂ)
+    mIsDrawIndirectCountEnabled = isDeviceExtensionAvailable(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    if (mIsDrawIndirectCountEnabled)
+    {
+        mEnabledExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    }
+    else
+    {
+        fprintf(stderr, "[GfxDevice] VK_KHR_draw_indirect_count is not available, indirect draws will cover every object\n");
+    }
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.pNext = &enabled_features2;
 
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
 
-    createInfo.pEnabledFeatures = &deviceFeatures;
+    // VkPhysicalDeviceFeatures2 `FCɊ܂߂̂ pEnabledFeatures ͎gȂ
+    createInfo.pEnabledFeatures = nullptr;
 
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(mEnabledExtensions.size());
+    createInfo.ppEnabledExtensionNames = mEnabledExtensions.data();
 
     if (enableValidationLayers) {
         createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
@@ -217,6 +816,16 @@ void GfxDevice::initVkDevice_()
 
     vkGetDeviceQueue(mVkDevice, indices.graphicsFamily.value(), 0, &mGraphicsQueue);
     vkGetDeviceQueue(mVkDevice, indices.presentFamily.value(), 0, &mPresentQueue);
+
+    // ]Ȃǂ̎ĝẴR}hobt@p
+    VkCommandPoolCreateInfo poolInfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+        .queueFamilyIndex = indices.graphicsFamily.value(),
+    };
+    if (vkCreateCommandPool(mVkDevice, &poolInfo, nullptr, &mCommandPool) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create command pool!");
+    }
 }
 //---------------------------------------------------------------------------
 void GfxDevice::initWindowSurface_(const DeviceInitParams& initParams)
@@ -229,6 +838,11 @@ void GfxDevice::initWindowSurface_(const DeviceInitParams& initParams)
 //---------------------------------------------------------------------------
 void GfxDevice::destroyVkDevice_()
 {
+    if (mCommandPool != VK_NULL_HANDLE)
+    {
+        vkDestroyCommandPool(mVkDevice, mCommandPool, nullptr);
+        mCommandPool = VK_NULL_HANDLE;
+    }
     vkDestroyDevice(mVkDevice, nullptr);
     mVkDevice = VK_NULL_HANDLE;
 }
@@ -2,6 +2,7 @@
 #include <memory>
 #include <vector>
 #include <optional>
+#include <source_location>
 
 #define VK_USE_PLATFORM_WIN32_KHR
 
@@ -17,6 +18,8 @@ const bool enableValidationLayers = true;
 //---------------------------------------------------------------------------
 class GfxDevice;
 std::unique_ptr<GfxDevice>& getGfxDevice();
+class MetricCounter;
+class MetricHistogram;
 
 //---------------------------------------------------------------------------
 const std::vector<const char*> validationLayers = {
@@ -36,12 +39,33 @@ struct QueueFamilyIndices {
 	}
 };
 //---------------------------------------------------------------------------
+/*
+ * pCvC̏Ԃ̂AR}hobt@Őݒł
+ */
+struct DynamicStateSupport
+{
+	// VK_EXT_extended_dynamic_state (1.3 RA): JO, \, g|W[, [xeXg//r
+	bool extendedDynamicState = false;
+	// VK_EXT_extended_dynamic_state2 (1.3 RA): v~eBuX^[g
+	bool extendedDynamicState2 = false;
+	// VK_EXT_extended_dynamic_state3: |S[h
+	bool polygonMode = false;
+	// VK_EXT_extended_dynamic_state3: uh̗L//݃}XN (3Ăꍇ̂)
+	bool colorBlend = false;
+	// g|W[ (_//Op`) ׂŐ؂ւ邩
+	bool unrestrictedTopology = false;
+};
+//---------------------------------------------------------------------------
 class GfxDevice
 {
 public:
 	struct DeviceInitParams
 	{
 		void* glfwWindow;
+		// VK_EXT_shader_object Lɂ (gꍇ̂݁ApCvCƂ̔rp)
+		bool requestShaderObject = false;
+		// VK_EXT_descriptor_buffer Lɂ (gꍇ̂݁AfBXNv^v[Ƃ̔rp)
+		bool requestDescriptorBuffer = false;
 	};
 
 public:
@@ -68,6 +92,39 @@ public:
 	inline VkQueue getPresentQueue() const { return mPresentQueue; }
 	inline uint32_t getGraphicsQueueFamily() const{ return mGraphicsQueueFamily; }
 	inline uint32_t getPresentQueueFamily() const{ return mPresentQueueFamily; }
+	// OtBbNXL[p̎ĝẴR}hobt@ (]Ȃ) ̃v[
+	inline VkCommandPool getCommandPool() const { return mCommandPool; }
+	inline const VkPhysicalDeviceFeatures& getEnabledFeatures() const { return mEnabledFeatures; }
+
+	/*
+	 * foCXg̑Ή
+	 * isDeviceExtensionEnabled ͎ۂɗL̂ true Ԃ
+	 */
+	bool isDeviceExtensionAvailable(const char* name) const;
+	bool isDeviceExtensionEnabled(const char* name) const;
+	inline const std::vector<const char*>& getEnabledExtensions() const { return mEnabledExtensions; }
+	// VK_KHR_present_id / VK_KHR_present_wait g邩
+	inline bool isPresentWaitEnabled() const { return mIsPresentWaitEnabled; }
+	// VK_EXT_graphics_pipeline_library g邩 (NɑΉĂ邩͕ʓr)
+	inline bool isGraphicsPipelineLibraryEnabled() const { return mIsGraphicsPipelineLibraryEnabled; }
+	inline bool hasGraphicsPipelineLibraryFastLinking() const { return mHasGraphicsPipelineLibraryFastLinking; }
+	// VK_EXT_shader_object g邩 (vꍇ̂݁A`ɂ Dynamic Rendering g)
+	inline bool isShaderObjectEnabled() const { return mIsShaderObjectEnabled; }
+	// descriptor indexing (oChXɕKvȋ@\) g邩
+	inline bool isDescriptorIndexingEnabled() const { return mIsDescriptorIndexingEnabled; }
+	// vfw̃fBXNv^z̐Zbg̊蓖ĎɌ߂邩
+	inline bool isVariableDescriptorCountEnabled() const { return mIsVariableDescriptorCountEnabled; }
+	// VK_EXT_descriptor_buffer g邩 (vꍇ̂)
+	inline bool isDescriptorBufferEnabled() const { return mIsDescriptorBufferEnabled; }
+	// obt@̃foCXAhXg邩
+	inline bool isBufferDeviceAddressEnabled() const { return mIsBufferDeviceAddressEnabled; }
+	// VK_KHR_push_descriptor g邩 (vbVłfBXNv^̏ getMaxPushDescriptors)
+	inline bool isPushDescriptorEnabled() const { return mIsPushDescriptorEnabled; }
+	inline uint32_t getMaxPushDescriptors() const { return mMaxPushDescriptors; }
+	// VK_KHR_draw_indirect_count g邩 (gȂꍇ vkCmdDrawIndexedIndirect őSIuWFNg`)
+	inline bool isDrawIndirectCountEnabled() const { return mIsDrawIndirectCountEnabled; }
+	// pCvCœIɂł
+	inline const DynamicStateSupport& getDynamicStateSupport() const { return mDynamicStateSupport; }
 
 	inline uint32_t getMemoryTypeIndex(VkMemoryRequirements reqs, VkMemoryPropertyFlags memoryPropFlags) {
 		auto requestBits = reqs.memoryTypeBits;
@@ -92,6 +149,18 @@ public:
 	 */
 	void waitForIdle();
 
+	inline bool isSupportVulkan12()
+	{
+		VkPhysicalDeviceProperties p{};
+		vkGetPhysicalDeviceProperties(mPhysicalDevice, &p);
+
+		if (p.apiVersion < VK_API_VERSION_1_2)
+		{
+			return false;
+		}
+		return true;
+	}
+
 	inline bool isSupportVulkan13()
 	{
 		VkPhysicalDeviceProperties p{};
@@ -107,14 +176,41 @@ public:
 	QueueFamilyIndices findQueueFamilies_();
 	void setObjectName(uint64_t handle, const char* name, VkObjectType type);
 
+	/*
+	 * 蓖č݂̃obt@/C[WƔj
+	 * ӏ VkObjectTracker ɌĂяoƂċL^
+	 */
+	void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& memory, std::source_location site = std::source_location::current());
+	void destroyBuffer(VkBuffer& buffer, VkDeviceMemory& memory);
+	// VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT Őobt@̃AhX
+	VkDeviceAddress getBufferDeviceAddress(VkBuffer buffer) const;
+	void createImage2D(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, VkImage& image, VkDeviceMemory& memory, std::source_location site = std::source_location::current());
+	void destroyImage(VkImage& image, VkDeviceMemory& memory);
+
+	/*
+	 * OtBbNXpCvC̐
+	 * 񐔂ƏvԂgNXɁALbVqbgXe[W̎Ԃ PipelineFeedback ɋL^
+	 */
+	VkResult createGraphicsPipeline(const VkGraphicsPipelineCreateInfo& createInfo, VkPipeline& pipeline, const char* name = nullptr, std::source_location site = std::source_location::current());
+
+	/*
+	 * pCvCLbV
+	 * NɃfBXNǂݍ݁AI (܂͔Cӂ̃^C~O) ɕۑ
+	 */
+	inline VkPipelineCache getPipelineCache() const { return mPipelineCache; }
+	bool savePipelineCache();
+
+	static constexpr const char* sPipelineCachePath = "pipeline_cache.bin";
+
 private:
 	/*
 	 * e평
 	 */
 	void initVkInstance_();
 	void initPhysicalDevice_();
-	void initVkDevice_();
+	void initVkDevice_(const DeviceInitParams& initParams);
 	void initWindowSurface_(const DeviceInitParams& initParams);
+	void initPipelineCache_();
 
 	/*
 	 * ej
@@ -122,12 +218,34 @@ private:
 	void destroyVkInstance_();
 	void destroyVkDevice_();
 	void destroyWindowSurface_();
+	void destroyPipelineCache_();
 
 private:
 	VkInstance mVkInstance = VK_NULL_HANDLE;
 	VkPhysicalDevice mPhysicalDevice = VK_NULL_HANDLE;
 	VkDevice mVkDevice = VK_NULL_HANDLE;
 	VkPhysicalDeviceMemoryProperties mMemoryProperties;
+	VkPhysicalDeviceFeatures mEnabledFeatures{};
+	std::vector<VkExtensionProperties> mAvailableExtensions;
+	std::vector<const char*> mEnabledExtensions;
+	bool mIsPresentWaitEnabled = false;
+	bool mIsGraphicsPipelineLibraryEnabled = false;
+	bool mHasGraphicsPipelineLibraryFastLinking = false;
+	bool mIsShaderObjectEnabled = false;
+	bool mIsDescriptorIndexingEnabled = false;
+	bool mIsVariableDescriptorCountEnabled = false;
+	bool mIsDescriptorBufferEnabled = false;
+	bool mIsBufferDeviceAddressEnabled = false;
+	bool mIsPushDescriptorEnabled = false;
+	uint32_t mMaxPushDescriptors = 0;
+	bool mIsDrawIndirectCountEnabled = false;
+	DynamicStateSupport mDynamicStateSupport;
+
+	VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
+	VkCommandPool mCommandPool = VK_NULL_HANDLE;
+
+	MetricCounter* mPipelineCompileCount = nullptr;
+	MetricHistogram* mPipelineCompileTime = nullptr;
 
 	VkSurfaceKHR mSurface = VK_NULL_HANDLE;
 	VkSurfaceFormatKHR mSurfaceFormat{};
@@ -0,0 +1,483 @@
+#include "GpuDrivenScene.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include "BindlessDescriptors.h"
+#include "OverdrawView.h"
+#include "PipelineLayoutCache.h"
+#include "ShaderSource.h"
+#include "VkObjectTracker.h"
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+// Llp`
+static const std::array<GpuDrivenVertex, 4> sQuadVertices = { {
+    { { -0.5f, -0.5f }, { 0.0f, 0.0f } },
+    { { 0.5f, -0.5f }, { 1.0f, 0.0f } },
+    { { 0.5f, 0.5f }, { 1.0f, 1.0f } },
+    { { -0.5f, 0.5f }, { 0.0f, 1.0f } },
+} };
+static const std::array<uint16_t, 6> sQuadIndices = { 0, 1, 2, 2, 3, 0 };
+
+// JÕVF[_[ (ShaderHotReload m点pXƓ`Ŏ)
+static constexpr const char* sCullShaderPath = "res/cull.comp.spv";
+
+// res/cull.comp  CullConstants ƍ킹邱
+struct CullConstants
+{
+    glm::vec4 frustumPlanes[6];
+    uint32_t sceneBuffer;
+    uint32_t commandBuffer;
+    uint32_t countBuffer;
+    uint32_t objectCount;
+    uint32_t compact;
+};
+// V[̃obt@̐擪ɒur[ˉes̑傫 (IuWFNg̔z͂̌납n܂)
+static constexpr VkDeviceSize sSceneHeaderSize = sizeof(glm::mat4);
+//---------------------------------------------------------------------------
+bool GpuDrivenScene::isSupported(GfxDevice* gfx_device)
+{
+    const VkPhysicalDeviceFeatures& features = gfx_device->getEnabledFeatures();
+    // V[ER}hẼobt@̓oChX̃Xg[Wobt@̔z񂩂vbV萔̔ԍň
+    return features.multiDrawIndirect && features.drawIndirectFirstInstance && features.shaderStorageBufferArrayDynamicIndexing &&
+        getBindlessDescriptors()->isEnabled();
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::initialize(GfxDevice* gfx_device, uint32_t frameCount, const GraphicsPipelineDesc& base, VkPipelineLayout overdrawLayout)
+{
+    mGfxDevice = gfx_device;
+    mUseDrawCount = gfx_device->isDrawIndirectCountEnabled();
+    createMesh_();
+    mCullPipeline = createCullPipeline_();
+
+    mDesc = base;
+    mDesc.vertexShader = "res/gpu_driven.vert.spv";
+    mDesc.fragmentShader = "res/rect_batch.frag.spv";
+    mDesc.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    // IuWFNg̒l̓Xg[Wobt@ǂނ̂ŁA_͂̓bV̒_
+    mDesc.vertexBindings = {
+        VkVertexInputBindingDescription{ .binding = 0, .stride = sizeof(GpuDrivenVertex), .inputRate = VK_VERTEX_INPUT_RATE_VERTEX },
+    };
+    mDesc.vertexAttributes = {
+        VkVertexInputAttributeDescription{ .location = 0, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT, .offset = offsetof(GpuDrivenVertex, corner) },
+        VkVertexInputAttributeDescription{ .location = 1, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT, .offset = offsetof(GpuDrivenVertex, texcoord) },
+    };
+    if (mDesc.debugName.empty())
+    {
+        mDesc.debugName = "GpuDrivenPipeline";
+    }
+    mPipeline = getPipelineManager()->requestPipeline(mDesc);
+    if (overdrawLayout != VK_NULL_HANDLE)
+    {
+        mOverdrawDesc = OverdrawView::makePipelineDesc(mDesc, overdrawLayout);
+        mOverdrawPipeline = getPipelineManager()->requestPipeline(mOverdrawDesc);
+    }
+
+    mFrames.assign(frameCount, FrameContext{});
+    for (auto& frame : mFrames)
+    {
+        createCountBuffer_(frame);
+        reserveObjects_(frame, sInitialCapacity);
+    }
+    mFrameIndex = 0;
+    mStats = Stats{};
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::shutdown()
+{
+    if (mGfxDevice == nullptr)
+    {
+        return;
+    }
+    auto device = mGfxDevice->getVkDevice();
+    auto& bindless = getBindlessDescriptors();
+    for (auto& frame : mFrames)
+    {
+        destroyObjects_(frame);
+        bindless->releaseStorageBuffer(frame.countIndex);
+        vkUnmapMemory(device, frame.countMemory);
+        mGfxDevice->destroyBuffer(frame.countBuffer, frame.countMemory);
+    }
+    mFrames.clear();
+    mObjects.clear();
+
+    // pCvCCAEg PipelineLayoutCache j
+    destroyRetiredCullPipelines_(true);
+    vkDestroyPipeline(device, mCullPipeline, nullptr);
+    getVkObjectTracker()->onDestroy(mCullPipeline, VK_OBJECT_TYPE_PIPELINE);
+    mCullPipeline = VK_NULL_HANDLE;
+    mCullPipelineLayout = VK_NULL_HANDLE;
+    mIsCullReloadRequested = false;
+    mPipeline = PipelineHandle{};
+    mOverdrawPipeline = PipelineHandle{};
+
+    getGeometryPool()->free(mQuadMesh);
+    mQuadMesh = GeometryPool::sInvalidMesh;
+    mGfxDevice = nullptr;
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::setObjects(const std::vector<GpuDrawObject>& objects)
+{
+    mObjects = objects;
+    resolveMeshes_();
+    mObjectsVersion++;
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::resolveMeshes_()
+{
+    auto& pool = getGeometryPool();
+    for (auto& object : mObjects)
+    {
+        if (!pool->isValid(object.mesh))
+        {
+            object.mesh = mQuadMesh;
+        }
+        const GeometryDrawArgs args = pool->getDrawArgs(object.mesh);
+        object.indexCount = args.indexCount;
+        object.firstIndex = args.firstIndex;
+        object.vertexOffset = args.vertexOffset;
+    }
+    mGeometryGeneration = pool->getGeneration();
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::beginFrame(uint32_t frameIndex)
+{
+    if (frameIndex >= mFrames.size())
+    {
+        return;
+    }
+    mFrameIndex = frameIndex;
+    FrameContext& frame = mFrames[frameIndex];
+
+    // JÕpCvC͋L^Ôłւ
+    destroyRetiredCullPipelines_(false);
+    if (mIsCullReloadRequested.exchange(false))
+    {
+        reloadCullPipeline_();
+    }
+
+    // tFX҂Ȃ̂ŁAO񂱂̃t[ReLXg GPU `搔ǂ߂
+    if (frame.isCulled)
+    {
+        mStats.visibleCount = *frame.countMapped;
+    }
+    frame.isCulled = false;
+
+    // GeometryPool lߒꍇ̓bV̈ʒuςĂ̂ŁASẴt[ReLXgɎʂ
+    if (mGeometryGeneration != getGeometryPool()->getGeneration())
+    {
+        resolveMeshes_();
+        mObjectsVersion++;
+    }
+
+    // IuWFNgς (ςȂ CPU ̓obt@ɐGȂ)
+    if (frame.version != mObjectsVersion)
+    {
+        const uint32_t count = static_cast<uint32_t>(mObjects.size());
+        reserveObjects_(frame, count);
+        if (count > 0)
+        {
+            memcpy(frame.sceneMapped + sSceneHeaderSize, mObjects.data(), mObjects.size() * sizeof(GpuDrawObject));
+        }
+        frame.objectCount = count;
+        frame.version = mObjectsVersion;
+        mStats.uploadCount++;
+    }
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::cull(VkCommandBuffer commandBuffer, const glm::mat4& viewProj)
+{
+    const auto record_start = std::chrono::steady_clock::now();
+    FrameContext& frame = mFrames[mFrameIndex];
+    mStats.objectCount = frame.objectCount;
+    mStats.capacity = frame.capacity;
+    if (frame.objectCount == 0)
+    {
+        return;
+    }
+    memcpy(frame.sceneMapped, &viewProj, sizeof(glm::mat4));
+
+    // s̍s̘aƍ王̕ʂo (@͓AZ  [0, 1])
+    CullConstants constants{
+        .sceneBuffer = frame.sceneIndex,
+        .commandBuffer = frame.commandIndex,
+        .countBuffer = frame.countIndex,
+        .objectCount = frame.objectCount,
+        .compact = mUseDrawCount ? 1u : 0u,
+    };
+    auto row = [&viewProj](int i) {
+        return glm::vec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+    };
+    constants.frustumPlanes[0] = row(3) + row(0);  // 
+    constants.frustumPlanes[1] = row(3) - row(0);  // E
+    constants.frustumPlanes[2] = row(3) + row(1);  // 
+    constants.frustumPlanes[3] = row(3) - row(1);  // 
+    constants.frustumPlanes[4] = row(2);           // O
+    constants.frustumPlanes[5] = row(3) - row(2);  // 
+    for (auto& plane : constants.frustumPlanes)
+    {
+        plane /= std::max(glm::length(glm::vec3(plane)), 1e-6f);
+    }
+
+    // `搔 0 ɖ߂ĂJO
+    vkCmdFillBuffer(commandBuffer, frame.countBuffer, 0, sizeof(uint32_t), 0);
+    VkMemoryBarrier clear_barrier{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+    };
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 1, &clear_barrier, 0, nullptr, 0, nullptr);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mCullPipeline);
+    getBindlessDescriptors()->bind(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mCullPipelineLayout);
+    vkCmdPushConstants(commandBuffer, mCullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullConstants), &constants);
+    vkCmdDispatch(commandBuffer, (frame.objectCount + sWorkGroupSize - 1) / sWorkGroupSize, 1, 1);
+
+    // 񂾃R}hԐڕ`悪ǂ݁A`搔͎ɂ̃t[ReLXggɃzXgǂ
+    VkMemoryBarrier cull_barrier{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_HOST_READ_BIT,
+    };
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+        0, 1, &cull_barrier, 0, nullptr, 0, nullptr);
+    frame.isCulled = true;
+
+    mStats.recordUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - record_start).count();
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::draw(VkCommandBuffer commandBuffer, DynamicStateCache& dynamicState, VkPipelineLayout layout, VkExtent2D extent, bool isOverdraw)
+{
+    const FrameContext& frame = mFrames[mFrameIndex];
+    VkPipeline pipeline = isOverdraw ? mOverdrawPipeline.get() : mPipeline.get();
+    if (!frame.isCulled || pipeline == VK_NULL_HANDLE)
+    {
+        return;
+    }
+    const auto record_start = std::chrono::steady_clock::now();
+
+    dynamicState.bindPipeline(pipeline);
+    dynamicState.setPipelineState(isOverdraw ? mOverdrawDesc : mDesc, extent);
+    getGeometryPool()->bind(commandBuffer);
+    const BindlessDrawConstants constants{
+        .bufferIndex = frame.sceneIndex,
+    };
+    vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(constants), &constants);
+
+    if (mUseDrawCount)
+    {
+        vkCmdDrawIndexedIndirectCountKHR(commandBuffer, frame.commandBuffer, 0, frame.countBuffer, 0,
+            frame.objectCount, sizeof(VkDrawIndexedIndirectCommand));
+    }
+    else
+    {
+        vkCmdDrawIndexedIndirect(commandBuffer, frame.commandBuffer, 0, frame.objectCount, sizeof(VkDrawIndexedIndirectCommand));
+    }
+
+    mStats.recordUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - record_start).count();
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::createMesh_()
+{
+    mQuadMesh = getGeometryPool()->allocate(sQuadVertices.data(), static_cast<uint32_t>(sQuadVertices.size()),
+        sizeof(GpuDrivenVertex), std::span<const uint16_t>(sQuadIndices));
+    mGeometryGeneration = getGeometryPool()->getGeneration();
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::reloadShader(const std::string& path)
+{
+    if (path == sCullShaderPath)
+    {
+        mIsCullReloadRequested = true;
+    }
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::reloadCullPipeline_()
+{
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    try
+    {
+        // `~߂ɍ蒼̂ŁAԂɓłsĂ悢
+        VkObjectTracker::SteadyStateExemption exemption;
+        pipeline = createCullPipeline_();
+    }
+    catch (const std::runtime_error& e)
+    {
+        // RpC͒ʂĂĂȂꍇ̂ŁAÂ̂g
+        fprintf(stderr, "[GpuDrivenScene] %s keeping the previous cull pipeline\n", e.what());
+        return;
+    }
+
+    // Â̂͑SẴt[ReLXgꏄɔj
+    mRetiredCullPipelines.push_back(RetiredPipeline{ .pipeline = mCullPipeline, .remainingFrames = static_cast<uint32_t>(mFrames.size()) });
+    mCullPipeline = pipeline;
+    fprintf(stderr, "[GpuDrivenScene] cull pipeline reloaded\n");
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::destroyRetiredCullPipelines_(bool destroyAll)
+{
+    auto device = mGfxDevice->getVkDevice();
+    std::erase_if(mRetiredCullPipelines, [device, destroyAll](RetiredPipeline& retired) {
+        if (!destroyAll && --retired.remainingFrames > 0)
+        {
+            return false;
+        }
+        vkDestroyPipeline(device, retired.pipeline, nullptr);
+        getVkObjectTracker()->onDestroy(retired.pipeline, VK_OBJECT_TYPE_PIPELINE);
+        return true;
+    });
+}
+//---------------------------------------------------------------------------
+VkPipeline GpuDrivenScene::createCullPipeline_()
+{
+    auto device = mGfxDevice->getVkDevice();
+    auto& bindless = getBindlessDescriptors();
+
+    // Zbg 0 ͕`ƓoChX̃ZbgŁAvbV萔Rs[gp
+    const VkPushConstantRange push_constant_range{
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .offset = 0,
+        .size = sizeof(CullConstants),
+    };
+    mCullPipelineLayout = getPipelineLayoutCache()->getPipelineLayout({ bindless->getDescriptorSetLayout() }, { push_constant_range });
+
+    std::vector<uint32_t> storage;
+    const auto code = getShaderSource()->load(sCullShaderPath, storage);
+    if (code.empty())
+    {
+        throw std::runtime_error("failed to load cull shader!");
+    }
+    VkShaderModuleCreateInfo module_info{
+        .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        .codeSize = code.size_bytes(),
+        .pCode = code.data(),
+    };
+    VkShaderModule shader_module = VK_NULL_HANDLE;
+    if (vkCreateShaderModule(device, &module_info, nullptr, &shader_module) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create shader module!");
+    }
+
+    VkComputePipelineCreateInfo pipeline_info{
+        .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+        .flags = bindless->getPipelineCreateFlags(),
+        .stage = VkPipelineShaderStageCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+            .module = shader_module,
+            .pName = "main",
+        },
+        .layout = mCullPipelineLayout,
+    };
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    const VkResult result = vkCreateComputePipelines(device, mGfxDevice->getPipelineCache(), 1, &pipeline_info, nullptr, &pipeline);
+    vkDestroyShaderModule(device, shader_module, nullptr);
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create cull pipeline!");
+    }
+    getVkObjectTracker()->onCreate(pipeline, VK_OBJECT_TYPE_PIPELINE);
+    mGfxDevice->setObjectName(uint64_t(pipeline), "GpuCullPipeline", VK_OBJECT_TYPE_PIPELINE);
+    return pipeline;
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::createCountBuffer_(FrameContext& frame)
+{
+    // Rs[gVF[_[Ag~bNɐAԐڕ`ƃzXgǂ
+    mGfxDevice->createBuffer(sizeof(uint32_t),
+        getStorageUsage_() | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, frame.countBuffer, frame.countMemory);
+    mGfxDevice->setObjectName(uint64_t(frame.countBuffer), "GpuDrivenDrawCount", VK_OBJECT_TYPE_BUFFER);
+    void* data = nullptr;
+    if (vkMapMemory(mGfxDevice->getVkDevice(), frame.countMemory, 0, sizeof(uint32_t), 0, &data) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to map draw count buffer!");
+    }
+    frame.countMapped = static_cast<uint32_t*>(data);
+    frame.countIndex = getBindlessDescriptors()->registerStorageBuffer(frame.countBuffer, 0, sizeof(uint32_t));
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::reserveObjects_(FrameContext& frame, uint32_t count)
+{
+    if (count <= frame.capacity)
+    {
+        return;
+    }
+    uint32_t capacity = std::max(frame.capacity, sInitialCapacity);
+    while (capacity < count)
+    {
+        capacity *= 2;
+    }
+    destroyObjects_(frame);
+
+    // IuWFNg̐ɍ킹čL̂͑z肵Ȃ̂ŁAԂɓłsĂ悢
+    VkObjectTracker::SteadyStateExemption exemption;
+    auto& bindless = getBindlessDescriptors();
+    const VkDeviceSize scene_size = sSceneHeaderSize + VkDeviceSize(capacity) * sizeof(GpuDrawObject);
+    mGfxDevice->createBuffer(scene_size, getStorageUsage_(),
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, frame.sceneBuffer, frame.sceneMemory);
+    mGfxDevice->setObjectName(uint64_t(frame.sceneBuffer), "GpuDrivenObjects", VK_OBJECT_TYPE_BUFFER);
+    void* data = nullptr;
+    if (vkMapMemory(mGfxDevice->getVkDevice(), frame.sceneMemory, 0, scene_size, 0, &data) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to map gpu driven object buffer!");
+    }
+    frame.sceneMapped = static_cast<uint8_t*>(data);
+    frame.sceneIndex = bindless->registerStorageBuffer(frame.sceneBuffer, 0, scene_size);
+
+    // GPU ǂݏ
+    const VkDeviceSize command_size = VkDeviceSize(capacity) * sizeof(VkDrawIndexedIndirectCommand);
+    mGfxDevice->createBuffer(command_size, getStorageUsage_() | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, frame.commandBuffer, frame.commandMemory);
+    mGfxDevice->setObjectName(uint64_t(frame.commandBuffer), "GpuDrivenCommands", VK_OBJECT_TYPE_BUFFER);
+    frame.commandIndex = bindless->registerStorageBuffer(frame.commandBuffer, 0, command_size);
+
+    frame.capacity = capacity;
+    // 蒼obt@͋Ȃ̂ŁAIuWFNgʂ
+    frame.version = 0;
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::destroyObjects_(FrameContext& frame)
+{
+    if (frame.sceneBuffer == VK_NULL_HANDLE)
+    {
+        return;
+    }
+    // ԍ̓oChXŎs̃t[I܂ōėpȂ
+    auto& bindless = getBindlessDescriptors();
+    bindless->releaseStorageBuffer(frame.sceneIndex);
+    bindless->releaseStorageBuffer(frame.commandIndex);
+    vkUnmapMemory(mGfxDevice->getVkDevice(), frame.sceneMemory);
+    mGfxDevice->destroyBuffer(frame.sceneBuffer, frame.sceneMemory);
+    mGfxDevice->destroyBuffer(frame.commandBuffer, frame.commandMemory);
+    frame.sceneMapped = nullptr;
+    frame.sceneIndex = UINT32_MAX;
+    frame.commandIndex = UINT32_MAX;
+    frame.capacity = 0;
+    frame.objectCount = 0;
+}
+//---------------------------------------------------------------------------
+VkBufferUsageFlags GpuDrivenScene::getStorageUsage_() const
+{
+    // descriptor buffer ł̓Xg[Wobt@AhXŎQƂ
+    VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if (mGfxDevice->isBufferDeviceAddressEnabled())
+    {
+        usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
+    return usage;
+}
+//---------------------------------------------------------------------------
+void GpuDrivenScene::drawImGui()
+{
+    ImGui::SeparatorText("GPU driven");
+    ImGui::Text("Path: %s", mUseDrawCount ? "vkCmdDrawIndexedIndirectCount" : "vkCmdDrawIndexedIndirect (no count)");
+    ImGui::Text("Objects: %u  Visible: %u  Capacity: %u", mStats.objectCount, mStats.visibleCount, mStats.capacity);
+    ImGui::Text("Uploads: %llu  Record: %.2f us", static_cast<unsigned long long>(mStats.uploadCount), mStats.recordUs);
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
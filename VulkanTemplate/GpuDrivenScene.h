@@ -0,0 +1,190 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <vector>
+#include "glm/glm.hpp"
+#include "GfxDevice.h"
+#include "PipelineManager.h"
+#include "DynamicStateCache.h"
+#include "GeometryPool.h"
+
+//---------------------------------------------------------------------------
+/*
+ * GPU 쓮̕`̃bV̒_ (res/gpu_driven.vert  inCorner, inTexCoord)
+ * bV͂̒_ GeometryPool ɓo^AGpuDrawObject::mesh ɔԍ
+ */
+struct GpuDrivenVertex
+{
+	glm::vec2 corner;
+	glm::vec2 texcoord;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * GPU `悷IuWFNg1 (res/cull.comp, res/gpu_driven.vert  DrawObject ƍ킹邱)
+ * `̈ (indexCount, firstIndex, vertexOffset) ̓IuWFNgɎAJÕVF[_[̂܂܃R}hɎʂ
+ *  GpuDrivenScene  mesh 疄߂̂ŁAĂяoŐݒ肷Kv͖
+ */
+struct GpuDrawObject
+{
+	glm::vec4 boundingSphere{ 0.0f };  // xyz: S ([h), w: a
+	glm::vec4 positionScale{ 0.0f };   // xy: S ([h), zw: 傫
+	uint32_t indexCount = 0;
+	uint32_t firstIndex = 0;
+	int32_t vertexOffset = 0;
+	uint32_t color = 0xffffffff;       // RGBA8 (R ŉʃoCg)
+	// BindlessDescriptors ɓo^ԍ
+	uint32_t textureIndex = 0;
+	uint32_t samplerIndex = 0;
+	// GeometryPool ̃bV (sInvalidMesh ̏ꍇ͋L̎lp`)
+	GeometryPool::MeshHandle mesh = GeometryPool::sInvalidMesh;
+	uint32_t padding = 0;
+};
+static_assert(sizeof(GpuDrawObject) == 64, "GpuDrawObject must match the std430 layout in the shaders");
+
+//---------------------------------------------------------------------------
+/*
+ * IuWFNg̋Eƕ`̈Xg[Wobt@ɒuAJO`R}h̐܂ł GPU ōs
+ *
+ * cull (_[pX̊O) ŃRs[gVF[_[ƃIuWFNg̋EׁA
+ * ̂ VkDrawIndexedIndirectCommand ƕ`搔obt@ɏ
+ * draw (_[pX̒)  vkCmdDrawIndexedIndirectCount 1L^邾Ȃ̂ŁA
+ * IuWFNgĂt[ CPU ׂ͕̕ςȂ
+ * VK_KHR_draw_indirect_count ꍇ͑SIuWFNg̃R}hAȂ̂̓CX^X 0 ɂ
+ * vkCmdDrawIndexedIndirect ŕ`
+ *
+ * IuWFNg setObjects œn CPU 珑 (t[ReLXg̃obt@ beginFrame Ŏʂ)
+ * ǂ̃obt@oChX̃Xg[Wobt@Ƃēo^AVF[_[̓vbV萔̔ԍň
+ * bV͑S GeometryPool ɒûŁAقȂ郁bṼIuWFNg1̊Ԑڕ`ŕ`
+ * GeometryPool lߒꍇ beginFrame ŕ`̈蒼
+ */
+class GpuDrivenScene
+{
+public:
+	static constexpr uint32_t sInitialCapacity = 4096;
+	// JÕVF[_[̃[NO[v̑傫 (res/cull.comp  local_size_x)
+	static constexpr uint32_t sWorkGroupSize = 64;
+
+	struct Stats
+	{
+		uint32_t objectCount = 0;   // JOIuWFNg̐
+		uint32_t visibleCount = 0;  // O񂱂̃t[ReLXg GPU Ɣ肵
+		uint32_t capacity = 0;
+		uint64_t uploadCount = 0;   // IuWFNgobt@ɏ񂾉
+		double recordUs = 0.0;      // JOƕ`̋L^ɂ CPU 
+	};
+
+public:
+	/*
+	 * }`h[̊Ԑڕ` firstInstanceAXg[Wobt@̔z̓IȓYgA
+	 * oChXLȏꍇ̂ݎg
+	 */
+	static bool isSupported(GfxDevice* gfx_device);
+
+	/*
+	 * base ̃VF[_[ƒ_͂ւ`p̃pCvCƃJOp̃Rs[gpCvC
+	 * base ̃pCvCCAEg̓Zbg 0  BindlessDescriptors ̃ZbgŁABindlessDrawConstants ̃vbV萔
+	 * overdrawLayout nƃI[o[h[vp̃oAg (OverdrawView::makePipelineDesc)
+	 */
+	void initialize(GfxDevice* gfx_device, uint32_t frameCount, const GraphicsPipelineDesc& base, VkPipelineLayout overdrawLayout = VK_NULL_HANDLE);
+	void shutdown();
+	inline bool isInitialized() const { return mGfxDevice != nullptr; }
+
+	/*
+	 * `悷IuWFNgւ (et[ReLXg̃obt@ɂ beginFrame Ŏʂ)
+	 * bVȃIuWFNgɂ͋L̎lp`蓖Ă
+	 */
+	void setObjects(const std::vector<GpuDrawObject>& objects);
+	inline uint32_t getObjectCount() const { return static_cast<uint32_t>(mObjects.size()); }
+	inline GeometryPool::MeshHandle getQuadMesh() const { return mQuadMesh; }
+
+	/*
+	 * frameIndex ̃t[̋L^n߂
+	 * ̃t[̃CtCgtFX҂ɌĂԂ
+	 */
+	void beginFrame(uint32_t frameIndex);
+	/*
+	 * JOƕ`R}h̐L^ (_[pX̊OŁAdraw OɌĂԂ)
+	 * viewProj ̓NbvԂ Z  [0, 1] ̂
+	 */
+	void cull(VkCommandBuffer commandBuffer, const glm::mat4& viewProj);
+	/*
+	 * cull ŐR}hŕ`悷 (oChX̃Zbg͌ς݂ł邱)
+	 * isOverdraw ̏ꍇ̓I[o[h[vp̃oAgŕ` (I[o[h[̃Zbg͌ς݂ł邱)
+	 */
+	void draw(VkCommandBuffer commandBuffer, DynamicStateCache& dynamicState, VkPipelineLayout layout, VkExtent2D extent, bool isOverdraw = false);
+
+	/*
+	 * VF[_[RpCꂽɌĂ (ShaderHotReload ̊ĎXbhĂł悢)
+	 * JÕVF[_[łΎ beginFrame ŃRs[gpCvC蒼
+	 */
+	void reloadShader(const std::string& path);
+
+	inline const Stats& getStats() const { return mStats; }
+	void drawImGui();
+
+private:
+	struct FrameContext
+	{
+		// r[ˉesƃIuWFNg̔z (zXg猩郁ɒuAiIɃ}bvĂ)
+		VkBuffer sceneBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory sceneMemory = VK_NULL_HANDLE;
+		uint8_t* sceneMapped = nullptr;
+		uint32_t sceneIndex = UINT32_MAX;
+		// JÕVF[_[ފԐڕ`̃R}h
+		VkBuffer commandBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory commandMemory = VK_NULL_HANDLE;
+		uint32_t commandIndex = UINT32_MAX;
+		// `搔 (v̂߂Ɏɂ̃t[ReLXggɓǂݕԂ)
+		VkBuffer countBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory countMemory = VK_NULL_HANDLE;
+		uint32_t* countMapped = nullptr;
+		uint32_t countIndex = UINT32_MAX;
+
+		uint32_t capacity = 0;
+		uint32_t objectCount = 0;
+		uint64_t version = 0;  // ʂIuWFNg̔ (mObjectsVersion ƈႦΎʂ)
+		bool isCulled = false;
+	};
+
+	void createMesh_();
+	// IuWFNg̕`̈ GeometryPool 蒼
+	void resolveMeshes_();
+	VkPipeline createCullPipeline_();
+	void reloadCullPipeline_();
+	void destroyRetiredCullPipelines_(bool destroyAll);
+	void createCountBuffer_(FrameContext& frame);
+	void reserveObjects_(FrameContext& frame, uint32_t count);
+	void destroyObjects_(FrameContext& frame);
+	VkBufferUsageFlags getStorageUsage_() const;
+
+private:
+	GfxDevice* mGfxDevice = nullptr;
+	GraphicsPipelineDesc mDesc;
+	PipelineHandle mPipeline;
+	GraphicsPipelineDesc mOverdrawDesc;
+	PipelineHandle mOverdrawPipeline;
+	VkPipelineLayout mCullPipelineLayout = VK_NULL_HANDLE;
+	VkPipeline mCullPipeline = VK_NULL_HANDLE;
+	bool mUseDrawCount = false;
+
+	// 蒼ÕJÕpCvC (L^ς݂̃t[gI܂Ŏc)
+	struct RetiredPipeline
+	{
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		uint32_t remainingFrames = 0;
+	};
+	std::vector<RetiredPipeline> mRetiredCullPipelines;
+	std::atomic<bool> mIsCullReloadRequested = false;
+
+	// L̎lp` (GeometryPool ɒu)
+	GeometryPool::MeshHandle mQuadMesh = GeometryPool::sInvalidMesh;
+	uint64_t mGeometryGeneration = 0;  // `̈ GeometryPool ̐
+
+	std::vector<GpuDrawObject> mObjects;
+	uint64_t mObjectsVersion = 1;
+	std::vector<FrameContext> mFrames;
+	uint32_t mFrameIndex = 0;
+	Stats mStats;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
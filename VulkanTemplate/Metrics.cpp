@@ -0,0 +1,299 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "FileLoader.h"
+
+//---------------------------------------------------------------------------
+static std::unique_ptr<MetricsRegistry> metricsRegistry = nullptr;
+std::unique_ptr<MetricsRegistry>& getMetricsRegistry()
+{
+    if (metricsRegistry == nullptr)
+    {
+        metricsRegistry = std::make_unique<MetricsRegistry>();
+    }
+    return metricsRegistry;
+}
+//---------------------------------------------------------------------------
+MetricHistogram::MetricHistogram(std::vector<double> bounds)
+    : mBounds(std::move(bounds))
+{
+    std::sort(mBounds.begin(), mBounds.end());
+    //  +Inf ̃oPbg
+    mCounts = std::make_unique<std::atomic<uint64_t>[]>(mBounds.size() + 1);
+    for (size_t i = 0; i <= mBounds.size(); ++i)
+    {
+        mCounts[i].store(0, std::memory_order_relaxed);
+    }
+}
+//---------------------------------------------------------------------------
+void MetricHistogram::observe(double value)
+{
+    const size_t index = std::lower_bound(mBounds.begin(), mBounds.end(), value) - mBounds.begin();
+    mCounts[index].fetch_add(1, std::memory_order_relaxed);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(value, std::memory_order_relaxed);
+}
+//---------------------------------------------------------------------------
+MetricHistogram::Snapshot MetricHistogram::snapshot() const
+{
+    // el͌ʂɓǂނ̂ŌɈтXibvVbgł͂Ȃ
+    Snapshot snapshot{
+        .bounds = mBounds,
+        .count = mCount.load(std::memory_order_relaxed),
+        .sum = mSum.load(std::memory_order_relaxed),
+    };
+    snapshot.counts.resize(mBounds.size() + 1);
+    for (size_t i = 0; i <= mBounds.size(); ++i)
+    {
+        snapshot.counts[i] = mCounts[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+//---------------------------------------------------------------------------
+double MetricHistogram::Snapshot::percentile(double p) const
+{
+    uint64_t total = 0;
+    for (uint64_t c : counts)
+    {
+        total += c;
+    }
+    if (total == 0)
+    {
+        return 0.0;
+    }
+    const double target = p * double(total);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < bounds.size(); ++i)
+    {
+        cumulative += counts[i];
+        if (double(cumulative) >= target)
+        {
+            return bounds[i];
+        }
+    }
+    // +Inf ̃oPbgɓꍇ͍ő̏lԂ
+    return bounds.empty() ? 0.0 : bounds.back();
+}
+//---------------------------------------------------------------------------
+MetricsRegistry::MetricsRegistry()
+{
+}
+//---------------------------------------------------------------------------
+MetricsRegistry::~MetricsRegistry()
+{
+    stopExport();
+}
+//---------------------------------------------------------------------------
+MetricsRegistry::Entry& MetricsRegistry::findOrCreate_(const char* name, const char* help, MetricType type)
+{
+    auto [it, inserted] = mEntries.try_emplace(name);
+    auto& entry = it->second;
+    if (inserted)
+    {
+        entry.help = help != nullptr ? help : "";
+        entry.type = type;
+    }
+    else if (entry.type != type)
+    {
+        throw std::runtime_error("metric registered with a different type!");
+    }
+    return entry;
+}
+//---------------------------------------------------------------------------
+MetricCounter* MetricsRegistry::counter(const char* name, const char* help)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto& entry = findOrCreate_(name, help, MetricType::Counter);
+    if (entry.counter == nullptr)
+    {
+        entry.counter = std::make_unique<MetricCounter>();
+    }
+    return entry.counter.get();
+}
+//---------------------------------------------------------------------------
+MetricGauge* MetricsRegistry::gauge(const char* name, const char* help)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto& entry = findOrCreate_(name, help, MetricType::Gauge);
+    if (entry.gauge == nullptr)
+    {
+        entry.gauge = std::make_unique<MetricGauge>();
+    }
+    return entry.gauge.get();
+}
+//---------------------------------------------------------------------------
+MetricHistogram* MetricsRegistry::histogram(const char* name, const char* help, std::vector<double> bounds)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto& entry = findOrCreate_(name, help, MetricType::Histogram);
+    if (entry.histogram == nullptr)
+    {
+        entry.histogram = std::make_unique<MetricHistogram>(std::move(bounds));
+    }
+    return entry.histogram.get();
+}
+//---------------------------------------------------------------------------
+void MetricsRegistry::addCollector(Collector collector)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCollectors.push_back(std::move(collector));
+}
+//---------------------------------------------------------------------------
+void MetricsRegistry::startExport(const char* path, ExportFormat format, std::chrono::milliseconds interval)
+{
+    stopExport();
+
+    mExportPath = path;
+    mExportFormat = format;
+    mExportInterval = interval;
+    mIsCsvHeaderWritten = false;
+    mIsExportRequested = true;
+    mExportThread = std::thread([this]() { exportThread_(); });
+}
+//---------------------------------------------------------------------------
+void MetricsRegistry::stopExport()
+{
+    if (!mExportThread.joinable())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mExportMutex);
+        mIsExportRequested = false;
+    }
+    mExportCondition.notify_all();
+    mExportThread.join();
+
+    // IO̒lc
+    flush();
+}
+//---------------------------------------------------------------------------
+void MetricsRegistry::exportThread_()
+{
+    std::unique_lock<std::mutex> lock(mExportMutex);
+    while (mIsExportRequested)
+    {
+        mExportCondition.wait_for(lock, mExportInterval, [this]() { return !mIsExportRequested; });
+        if (!mIsExportRequested)
+        {
+            break;
+        }
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+//---------------------------------------------------------------------------
+void MetricsRegistry::flush()
+{
+    if (mExportPath.empty())
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto& collector : mCollectors)
+    {
+        collector();
+    }
+    switch (mExportFormat)
+    {
+    case ExportFormat::Prometheus: writePrometheus_(); break;
+    case ExportFormat::Csv: writeCsv_(); break;
+    }
+}
+//---------------------------------------------------------------------------
+void MetricsRegistry::writePrometheus_()
+{
+    std::ostringstream out;
+    char buf[256];
+    for (const auto& [name, entry] : mEntries)
+    {
+        out << "# HELP " << name << " " << entry.help << "\n";
+        switch (entry.type)
+        {
+        case MetricType::Counter:
+            out << "# TYPE " << name << " counter\n";
+            snprintf(buf, sizeof(buf), "%s %llu\n", name.c_str(), static_cast<unsigned long long>(entry.counter->get()));
+            out << buf;
+            break;
+        case MetricType::Gauge:
+            out << "# TYPE " << name << " gauge\n";
+            snprintf(buf, sizeof(buf), "%s %.6g\n", name.c_str(), entry.gauge->get());
+            out << buf;
+            break;
+        case MetricType::Histogram:
+        {
+            out << "# TYPE " << name << " histogram\n";
+            const auto snapshot = entry.histogram->snapshot();
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < snapshot.bounds.size(); ++i)
+            {
+                cumulative += snapshot.counts[i];
+                snprintf(buf, sizeof(buf), "%s_bucket{le=\"%g\"} %llu\n", name.c_str(), snapshot.bounds[i], static_cast<unsigned long long>(cumulative));
+                out << buf;
+            }
+            cumulative += snapshot.counts.back();
+            snprintf(buf, sizeof(buf), "%s_bucket{le=\"+Inf\"} %llu\n", name.c_str(), static_cast<unsigned long long>(cumulative));
+            out << buf;
+            snprintf(buf, sizeof(buf), "%s_sum %.6g\n%s_count %llu\n", name.c_str(), snapshot.sum, name.c_str(), static_cast<unsigned long long>(snapshot.count));
+            out << buf;
+            break;
+        }
+        }
+    }
+
+    // XNCp[ݓr̃t@Cǂ܂Ȃ悤ꎞt@Cu
+    if (!getFileLoader()->WriteAtomic(mExportPath, out.str()))
+    {
+        fprintf(stderr, "[Metrics] failed to write %s\n", mExportPath.c_str());
+    }
+}
+//---------------------------------------------------------------------------
+void MetricsRegistry::writeCsv_()
+{
+    // Ԃ̌vŗ񂪑Ă悤A1s1l̏cŒǋL
+    std::ofstream out(mExportPath, mIsCsvHeaderWritten ? std::ios::app : std::ios::trunc);
+    if (!out)
+    {
+        fprintf(stderr, "[Metrics] failed to write %s\n", mExportPath.c_str());
+        return;
+    }
+    if (!mIsCsvHeaderWritten)
+    {
+        out << "timestamp_ms,name,value\n";
+        mIsCsvHeaderWritten = true;
+    }
+
+    const auto timestamp_ms = static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    char buf[256];
+    auto write_row = [&](const std::string& name, const char* suffix, double value) {
+        snprintf(buf, sizeof(buf), "%lld,%s%s,%.6g\n", timestamp_ms, name.c_str(), suffix, value);
+        out << buf;
+    };
+    for (const auto& [name, entry] : mEntries)
+    {
+        switch (entry.type)
+        {
+        case MetricType::Counter:
+            write_row(name, "", double(entry.counter->get()));
+            break;
+        case MetricType::Gauge:
+            write_row(name, "", entry.gauge->get());
+            break;
+        case MetricType::Histogram:
+        {
+            const auto snapshot = entry.histogram->snapshot();
+            write_row(name, "_count", double(snapshot.count));
+            write_row(name, "_sum", snapshot.sum);
+            write_row(name, "_p50", snapshot.percentile(0.50));
+            write_row(name, "_p99", snapshot.percentile(0.99));
+            break;
+        }
+        }
+    }
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
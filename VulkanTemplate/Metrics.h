@@ -0,0 +1,159 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//---------------------------------------------------------------------------
+class MetricsRegistry;
+std::unique_ptr<MetricsRegistry>& getMetricsRegistry();
+
+//---------------------------------------------------------------------------
+/*
+ * PJE^
+ * XV̓Ag~bN݂̂Ȃ̂ŁAǂ̃XbhłĂяo
+ */
+class MetricCounter
+{
+public:
+	inline void add(uint64_t value = 1) { mValue.fetch_add(value, std::memory_order_relaxed); }
+	inline uint64_t get() const { return mValue.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<uint64_t> mValue = 0;
+};
+//---------------------------------------------------------------------------
+/*
+ * Cӂ̒lQ[W
+ */
+class MetricGauge
+{
+public:
+	inline void set(double value) { mValue.store(value, std::memory_order_relaxed); }
+	inline void add(double value) { mValue.fetch_add(value, std::memory_order_relaxed); }
+	inline double get() const { return mValue.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<double> mValue = 0.0;
+};
+//---------------------------------------------------------------------------
+/*
+ * ŒoPbg̃qXgO
+ * oPbg̏l͐Ɍ߂ (Prometheus  le ƓӖ)
+ */
+class MetricHistogram
+{
+public:
+	struct Snapshot
+	{
+		std::vector<double> bounds;
+		std::vector<uint64_t> counts;   // oPbǧ (ݐςł͂ȂA +Inf)
+		uint64_t count = 0;
+		double sum = 0.0;
+
+		// oPbg̏l狁߂ߎ̃p[Z^C
+		double percentile(double p) const;
+	};
+
+public:
+	explicit MetricHistogram(std::vector<double> bounds);
+
+	void observe(double value);
+	Snapshot snapshot() const;
+
+private:
+	std::vector<double> mBounds;
+	std::unique_ptr<std::atomic<uint64_t>[]> mCounts;
+	std::atomic<uint64_t> mCount = 0;
+	std::atomic<double> mSum = 0.0;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * gNX̓o^ƒIȃt@Co
+ * o^Oɑ΂Ĉ肵|C^Ԃ̂ŁAeTuVXe͕ێčXV
+ * o͂̓obNOEhXbhōsAPrometheus ̃eLXg` CSV Iׂ
+ */
+class MetricsRegistry
+{
+public:
+	enum class ExportFormat
+	{
+		Prometheus,     // t@CŜu (node_exporter  textfile collector )
+		Csv,            // timestamp_ms,name,value ǋLĂ
+	};
+
+	using Collector = std::function<void()>;
+
+public:
+	MetricsRegistry();
+	~MetricsRegistry();
+
+	/*
+	 * gNX̓o^ (̂̂΂Ԃ)
+	 */
+	MetricCounter* counter(const char* name, const char* help);
+	MetricGauge* gauge(const char* name, const char* help);
+	MetricHistogram* histogram(const char* name, const char* help, std::vector<double> bounds);
+
+	/*
+	 * o͂̒OɃobNOEhXbhŌĂ΂
+	 * t[XVKv̂ȂQ[W (gpʂȂ) ̎WɎg
+	 */
+	void addCollector(Collector collector);
+
+	/*
+	 * o͂̊Jnƒ~ (~ɍŌ̏o͂s)
+	 */
+	void startExport(const char* path, ExportFormat format, std::chrono::milliseconds interval);
+	void stopExport();
+
+	/*
+	 * ɏo͂
+	 */
+	void flush();
+
+	inline bool isExporting() const { return mExportThread.joinable(); }
+
+private:
+	enum class MetricType
+	{
+		Counter,
+		Gauge,
+		Histogram,
+	};
+	struct Entry
+	{
+		std::string help;
+		MetricType type;
+		std::unique_ptr<MetricCounter> counter;
+		std::unique_ptr<MetricGauge> gauge;
+		std::unique_ptr<MetricHistogram> histogram;
+	};
+
+	Entry& findOrCreate_(const char* name, const char* help, MetricType type);
+	void exportThread_();
+	void writePrometheus_();
+	void writeCsv_();
+
+private:
+	std::mutex mMutex;
+	std::map<std::string, Entry> mEntries;
+	std::vector<Collector> mCollectors;
+
+	std::mutex mExportMutex;
+	std::condition_variable mExportCondition;
+	std::thread mExportThread;
+	bool mIsExportRequested = false;
+	std::string mExportPath;
+	ExportFormat mExportFormat = ExportFormat::Prometheus;
+	std::chrono::milliseconds mExportInterval{ 1000 };
+	bool mIsCsvHeaderWritten = false;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,518 @@
+#include "OverdrawView.h"
+#include <stdexcept>
+#include "ShaderSource.h"
+#include "VkObjectTracker.h"
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+void OverdrawView::initialize(GfxDevice* gfx_device, VkRenderPass renderPass, VkExtent2D extent)
+{
+    mDevice = gfx_device->getVkDevice();
+    mExtent = extent;
+
+    // tOgVF[_[݂̏oȂł͖
+    mIsSupported = gfx_device->getEnabledFeatures().fragmentStoresAndAtomics == VK_TRUE;
+    if (!mIsSupported)
+    {
+        return;
+    }
+
+    createDescriptors_(gfx_device);
+    createHeatmapPipeline_(gfx_device, renderPass);
+    createFrameResources_(gfx_device);
+    updateDescriptorSets_(gfx_device);
+}
+//---------------------------------------------------------------------------
+void OverdrawView::destroy(GfxDevice* gfx_device)
+{
+    if (!mIsSupported)
+    {
+        return;
+    }
+    auto& tracker = getVkObjectTracker();
+
+    destroyFrameResources_(gfx_device);
+
+    vkDestroyPipeline(mDevice, mHeatmapPipeline, nullptr);
+    vkDestroyPipelineLayout(mDevice, mHeatmapPipelineLayout, nullptr);
+    vkDestroyDescriptorPool(mDevice, mDescriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(mDevice, mDescriptorSetLayout, nullptr);
+    tracker->onDestroy(mHeatmapPipeline, VK_OBJECT_TYPE_PIPELINE);
+    tracker->onDestroy(mHeatmapPipelineLayout, VK_OBJECT_TYPE_PIPELINE_LAYOUT);
+    tracker->onDestroy(mDescriptorPool, VK_OBJECT_TYPE_DESCRIPTOR_POOL);
+    tracker->onDestroy(mDescriptorSetLayout, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+    mHeatmapPipeline = VK_NULL_HANDLE;
+    mHeatmapPipelineLayout = VK_NULL_HANDLE;
+    mDescriptorPool = VK_NULL_HANDLE;
+    mDescriptorSetLayout = VK_NULL_HANDLE;
+}
+//---------------------------------------------------------------------------
+void OverdrawView::resize(GfxDevice* gfx_device, VkExtent2D extent)
+{
+    mExtent = extent;
+    if (!mIsSupported)
+    {
+        return;
+    }
+    destroyFrameResources_(gfx_device);
+    createFrameResources_(gfx_device);
+    updateDescriptorSets_(gfx_device);
+}
+//---------------------------------------------------------------------------
+void OverdrawView::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    auto& frame = mFrames[frameIndex];
+
+    // ̃t[̃tFX͑ҋ@ς݂Ȃ̂őȌWvʂǂݏo
+    if (frame.hasResult)
+    {
+        mStats.maxCount = frame.mappedStats->maxCount;
+        mStats.totalCount = frame.mappedStats->totalCount;
+        mStats.coveredPixels = frame.mappedStats->coveredPixels;
+        mStats.totalPixels = mExtent.width * mExtent.height;
+    }
+    *frame.mappedStats = StatsBuffer{};
+    frame.hasResult = true;
+
+    VkImageSubresourceRange range{
+        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        .baseMipLevel = 0,
+        .levelCount = 1,
+        .baseArrayLayer = 0,
+        .layerCount = 1,
+    };
+
+    // O̓e͕svȂ̂ UNDEFINED Jڂ
+    VkImageMemoryBarrier to_clear{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = frame.image,
+        .subresourceRange = range,
+    };
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &to_clear);
+
+    VkClearColorValue zero{};
+    vkCmdClearColorImage(commandBuffer, frame.image, VK_IMAGE_LAYOUT_GENERAL, &zero, 1, &range);
+
+    VkImageMemoryBarrier to_shader{
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = frame.image,
+        .subresourceRange = range,
+    };
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &to_shader);
+}
+//---------------------------------------------------------------------------
+void OverdrawView::drawHeatmap(VkCommandBuffer commandBuffer, uint32_t frameIndex)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    auto& frame = mFrames[frameIndex];
+
+    // sNZ̓ǂݏ݂̂Ȃ̂ŃTupX̎Ȉˑ(BY_REGION)ő
+    VkMemoryBarrier barrier{
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+    };
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        VK_DEPENDENCY_BY_REGION_BIT, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mHeatmapPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mHeatmapPipelineLayout, 0, 1, &frame.descriptorSet, 0, nullptr);
+
+    // V[̃pCvCRpCƃr[|[gݒ肳ĂȂƂ̂ŁAŐݒ肷
+    const VkViewport viewport{
+        .x = 0.0f,
+        .y = 0.0f,
+        .width = static_cast<float>(mExtent.width),
+        .height = static_cast<float>(mExtent.height),
+        .minDepth = 0.0f,
+        .maxDepth = 1.0f,
+    };
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    const VkRect2D scissor{
+        .offset = { 0, 0 },
+        .extent = mExtent,
+    };
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    HeatmapParams params{
+        .maxScale = mMaxScale,
+        .opacity = mOpacity,
+    };
+    vkCmdPushConstants(commandBuffer, mHeatmapPipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(params), &params);
+
+    // tXN[Op`
+    vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+}
+//---------------------------------------------------------------------------
+GraphicsPipelineDesc OverdrawView::makePipelineDesc(const GraphicsPipelineDesc& desc, VkPipelineLayout layout)
+{
+    // tOgVF[_[ƃCAEgւAJ[ɂ͏܂Ȃ
+    // uh͊ۂƊlɂāAuhقȂLqpCvCɂ܂Ƃ܂悤ɂ
+    GraphicsPipelineDesc overdraw_desc = desc;
+    overdraw_desc.fragmentShader = "res/overdraw.frag.spv";
+    overdraw_desc.colorBlend = VkPipelineColorBlendAttachmentState{
+        .blendEnable = VK_FALSE,
+        .colorWriteMask = 0,
+    };
+    overdraw_desc.layout = layout;
+    overdraw_desc.debugName = desc.debugName + "Overdraw";
+    return overdraw_desc;
+}
+//---------------------------------------------------------------------------
+void OverdrawView::drawImGui()
+{
+    if (!mIsSupported)
+    {
+        ImGui::Text("Overdraw: not supported");
+        return;
+    }
+    ImGui::Checkbox("Overdraw heatmap", &mIsEnabled);
+    if (!mIsEnabled)
+    {
+        return;
+    }
+    ImGui::SliderFloat("Ramp max", &mMaxScale, 1.0f, 32.0f, "%.0f");
+    ImGui::SliderFloat("Opacity", &mOpacity, 0.0f, 1.0f);
+
+    const double avg_covered = mStats.coveredPixels > 0 ? double(mStats.totalCount) / mStats.coveredPixels : 0.0;
+    const double avg_screen = mStats.totalPixels > 0 ? double(mStats.totalCount) / mStats.totalPixels : 0.0;
+    ImGui::Text("Max overdraw: %u", mStats.maxCount);
+    ImGui::Text("Avg overdraw: %.2f (covered) / %.2f (screen)", avg_covered, avg_screen);
+}
+//---------------------------------------------------------------------------
+void OverdrawView::createDescriptors_(GfxDevice* gfx_device)
+{
+    auto& tracker = getVkObjectTracker();
+
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings{
+        VkDescriptorSetLayoutBinding{
+            .binding = 0,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+        },
+        VkDescriptorSetLayoutBinding{
+            .binding = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+        },
+    };
+    VkDescriptorSetLayoutCreateInfo layout_create_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .bindingCount = static_cast<uint32_t>(bindings.size()),
+        .pBindings = bindings.data(),
+    };
+    if (vkCreateDescriptorSetLayout(mDevice, &layout_create_info, nullptr, &mDescriptorSetLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create overdraw descriptor set layout!");
+    }
+    tracker->onCreate(mDescriptorSetLayout, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+
+    std::array<VkDescriptorPoolSize, 2> pool_sizes{
+        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, sFrameCount },
+        VkDescriptorPoolSize{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, sFrameCount },
+    };
+    VkDescriptorPoolCreateInfo pool_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .maxSets = sFrameCount,
+        .poolSizeCount = static_cast<uint32_t>(pool_sizes.size()),
+        .pPoolSizes = pool_sizes.data(),
+    };
+    if (vkCreateDescriptorPool(mDevice, &pool_info, nullptr, &mDescriptorPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create overdraw descriptor pool!");
+    }
+    tracker->onCreate(mDescriptorPool, VK_OBJECT_TYPE_DESCRIPTOR_POOL);
+
+    std::array<VkDescriptorSetLayout, sFrameCount> layouts;
+    layouts.fill(mDescriptorSetLayout);
+    VkDescriptorSetAllocateInfo alloc_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .descriptorPool = mDescriptorPool,
+        .descriptorSetCount = sFrameCount,
+        .pSetLayouts = layouts.data(),
+    };
+    std::array<VkDescriptorSet, sFrameCount> sets;
+    if (vkAllocateDescriptorSets(mDevice, &alloc_info, sets.data()) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to allocate overdraw descriptor sets!");
+    }
+    for (uint32_t i = 0; i < sFrameCount; ++i)
+    {
+        mFrames[i].descriptorSet = sets[i];
+    }
+}
+//---------------------------------------------------------------------------
+void OverdrawView::createHeatmapPipeline_(GfxDevice* gfx_device, VkRenderPass renderPass)
+{
+    auto& tracker = getVkObjectTracker();
+
+    auto createShaderModule_ = [this, &tracker](const char* path) -> VkShaderModule {
+        std::vector<uint32_t> storage;
+        const auto code = getShaderSource()->load(path, storage);
+        if (code.empty())
+        {
+            throw std::runtime_error("failed to load overdraw shader!");
+        }
+        VkShaderModuleCreateInfo create_info{
+            .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+            .codeSize = code.size_bytes(),
+            .pCode = code.data(),
+        };
+        VkShaderModule shader_module;
+        if (vkCreateShaderModule(mDevice, &create_info, nullptr, &shader_module) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create shader module!");
+        }
+        tracker->onCreate(shader_module, VK_OBJECT_TYPE_SHADER_MODULE);
+        return shader_module;
+    };
+    auto vert_shader_module = createShaderModule_("res/heatmap.vert.spv");
+    auto frag_shader_module = createShaderModule_("res/heatmap.frag.spv");
+
+    std::array<VkPipelineShaderStageCreateInfo, 2> shader_stages{
+        VkPipelineShaderStageCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage = VK_SHADER_STAGE_VERTEX_BIT,
+            .module = vert_shader_module,
+            .pName = "main",
+        },
+        VkPipelineShaderStageCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage = VK_SHADER_STAGE_FRAGMENT_BIT,
+            .module = frag_shader_module,
+            .pName = "main",
+        },
+    };
+
+    // _ gl_VertexIndex 琶
+    VkPipelineVertexInputStateCreateInfo vertex_input_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+    };
+    VkPipelineInputAssemblyStateCreateInfo input_assembly_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        .primitiveRestartEnable = VK_FALSE,
+    };
+    VkPipelineViewportStateCreateInfo viewport_state_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+        .viewportCount = 1,
+        .scissorCount = 1,
+    };
+    VkPipelineRasterizationStateCreateInfo rasterizer_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+        .depthClampEnable = VK_FALSE,
+        .rasterizerDiscardEnable = VK_FALSE,
+        .polygonMode = VK_POLYGON_MODE_FILL,
+        .cullMode = VK_CULL_MODE_NONE,
+        .frontFace = VK_FRONT_FACE_CLOCKWISE,
+        .depthBiasEnable = VK_FALSE,
+        .lineWidth = 1.0f,
+    };
+    VkPipelineMultisampleStateCreateInfo multisampling_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+        .sampleShadingEnable = VK_FALSE,
+    };
+    // t[̏ɃAt@uhŏd˂
+    VkPipelineColorBlendAttachmentState color_blend_attachment{
+        .blendEnable = VK_TRUE,
+        .srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+        .dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+        .colorBlendOp = VK_BLEND_OP_ADD,
+        .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+        .dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
+        .alphaBlendOp = VK_BLEND_OP_ADD,
+        .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+    };
+    VkPipelineColorBlendStateCreateInfo color_blending_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+        .logicOpEnable = VK_FALSE,
+        .attachmentCount = 1,
+        .pAttachments = &color_blend_attachment,
+    };
+    std::array<VkDynamicState, 2> dynamic_states = {
+        VK_DYNAMIC_STATE_VIEWPORT,
+        VK_DYNAMIC_STATE_SCISSOR,
+    };
+    VkPipelineDynamicStateCreateInfo dynamic_state_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+        .dynamicStateCount = static_cast<uint32_t>(dynamic_states.size()),
+        .pDynamicStates = dynamic_states.data(),
+    };
+
+    VkPushConstantRange push_constant_range{
+        .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+        .offset = 0,
+        .size = sizeof(HeatmapParams),
+    };
+    VkPipelineLayoutCreateInfo pipeline_layout_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = 1,
+        .pSetLayouts = &mDescriptorSetLayout,
+        .pushConstantRangeCount = 1,
+        .pPushConstantRanges = &push_constant_range,
+    };
+    if (vkCreatePipelineLayout(mDevice, &pipeline_layout_info, nullptr, &mHeatmapPipelineLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create heatmap pipeline layout!");
+    }
+    tracker->onCreate(mHeatmapPipelineLayout, VK_OBJECT_TYPE_PIPELINE_LAYOUT);
+
+    VkGraphicsPipelineCreateInfo pipeline_info{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .stageCount = static_cast<uint32_t>(shader_stages.size()),
+        .pStages = shader_stages.data(),
+        .pVertexInputState = &vertex_input_info,
+        .pInputAssemblyState = &input_assembly_info,
+        .pViewportState = &viewport_state_info,
+        .pRasterizationState = &rasterizer_info,
+        .pMultisampleState = &multisampling_info,
+        .pColorBlendState = &color_blending_info,
+        .pDynamicState = &dynamic_state_info,
+        .layout = mHeatmapPipelineLayout,
+        .renderPass = renderPass,
+        .subpass = 0,
+    };
+    if (gfx_device->createGraphicsPipeline(pipeline_info, mHeatmapPipeline, "OverdrawHeatmapPipeline") != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create heatmap pipeline!");
+    }
+    gfx_device->setObjectName(uint64_t(mHeatmapPipeline), "OverdrawHeatmapPipeline", VK_OBJECT_TYPE_PIPELINE);
+
+    vkDestroyShaderModule(mDevice, vert_shader_module, nullptr);
+    vkDestroyShaderModule(mDevice, frag_shader_module, nullptr);
+    tracker->onDestroy(vert_shader_module, VK_OBJECT_TYPE_SHADER_MODULE);
+    tracker->onDestroy(frag_shader_module, VK_OBJECT_TYPE_SHADER_MODULE);
+}
+//---------------------------------------------------------------------------
+void OverdrawView::createFrameResources_(GfxDevice* gfx_device)
+{
+    auto& tracker = getVkObjectTracker();
+
+    for (auto& frame : mFrames)
+    {
+        gfx_device->createImage2D(
+            mExtent.width,
+            mExtent.height,
+            VK_FORMAT_R32_UINT,
+            VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+            frame.image,
+            frame.imageMemory);
+        gfx_device->setObjectName(uint64_t(frame.image), "OverdrawCounter", VK_OBJECT_TYPE_IMAGE);
+
+        VkImageViewCreateInfo view_info{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            .image = frame.image,
+            .viewType = VK_IMAGE_VIEW_TYPE_2D,
+            .format = VK_FORMAT_R32_UINT,
+            .subresourceRange = {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .baseMipLevel = 0,
+                .levelCount = 1,
+                .baseArrayLayer = 0,
+                .layerCount = 1,
+            },
+        };
+        if (vkCreateImageView(mDevice, &view_info, nullptr, &frame.imageView) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create overdraw image view!");
+        }
+        tracker->onCreate(frame.imageView, VK_OBJECT_TYPE_IMAGE_VIEW);
+
+        gfx_device->createBuffer(
+            sizeof(StatsBuffer),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            frame.statsBuffer,
+            frame.statsMemory);
+        void* data;
+        vkMapMemory(mDevice, frame.statsMemory, 0, sizeof(StatsBuffer), 0, &data);
+        frame.mappedStats = static_cast<StatsBuffer*>(data);
+        *frame.mappedStats = StatsBuffer{};
+        frame.hasResult = false;
+    }
+}
+//---------------------------------------------------------------------------
+void OverdrawView::destroyFrameResources_(GfxDevice* gfx_device)
+{
+    auto& tracker = getVkObjectTracker();
+
+    for (auto& frame : mFrames)
+    {
+        if (frame.mappedStats != nullptr)
+        {
+            vkUnmapMemory(mDevice, frame.statsMemory);
+            frame.mappedStats = nullptr;
+        }
+        gfx_device->destroyBuffer(frame.statsBuffer, frame.statsMemory);
+
+        vkDestroyImageView(mDevice, frame.imageView, nullptr);
+        tracker->onDestroy(frame.imageView, VK_OBJECT_TYPE_IMAGE_VIEW);
+        frame.imageView = VK_NULL_HANDLE;
+        gfx_device->destroyImage(frame.image, frame.imageMemory);
+    }
+}
+//---------------------------------------------------------------------------
+void OverdrawView::updateDescriptorSets_(GfxDevice* gfx_device)
+{
+    for (auto& frame : mFrames)
+    {
+        VkDescriptorImageInfo image_info{
+            .sampler = VK_NULL_HANDLE,
+            .imageView = frame.imageView,
+            .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
+        };
+        VkDescriptorBufferInfo buffer_info{
+            .buffer = frame.statsBuffer,
+            .offset = 0,
+            .range = sizeof(StatsBuffer),
+        };
+        std::array<VkWriteDescriptorSet, 2> writes{
+            VkWriteDescriptorSet{
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .dstSet = frame.descriptorSet,
+                .dstBinding = 0,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                .pImageInfo = &image_info,
+            },
+            VkWriteDescriptorSet{
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .dstSet = frame.descriptorSet,
+                .dstBinding = 1,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                .pBufferInfo = &buffer_info,
+            },
+        };
+        vkUpdateDescriptorSets(mDevice, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "GfxDevice.h"
+#include "PipelineState.h"
+
+//---------------------------------------------------------------------------
+/*
+ * I[o[h[(sNZ̃tOgs)̃q[g}bv\
+ * L̓V[̃tOgo͂Xg[WC[Wւ̃Ag~bNZɒuA
+ * t[̍ŌɃJ[vƂďd˂ĕ`悷
+ */
+class OverdrawView
+{
+public:
+	static constexpr uint32_t sFrameCount = 2;
+
+	struct Stats
+	{
+		uint32_t maxCount = 0;
+		uint64_t totalCount = 0;
+		uint32_t coveredPixels = 0;
+		uint32_t totalPixels = 0;
+	};
+
+public:
+	void initialize(GfxDevice* gfx_device, VkRenderPass renderPass, VkExtent2D extent);
+	void destroy(GfxDevice* gfx_device);
+
+	/*
+	 * Xbv`FC̃TCYύXɍ킹ăJE^C[W蒼
+	 */
+	void resize(GfxDevice* gfx_device, VkExtent2D extent);
+
+	/*
+	 * _[pXJnO: ȌWvʂǂݏoAJE^NA
+	 */
+	void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+	/*
+	 * V[`ATupXŃq[g}bvd˂
+	 * r[|[gƃVU[͂Őݒ肷̂ŁA܂łɃpCvCĂȂĂ悢
+	 */
+	void drawHeatmap(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+	void drawImGui();
+
+	/*
+	 * I[o[h[ppCvC set = 1 ɎgCAEgƃZbg
+	 */
+	inline VkDescriptorSetLayout getDescriptorSetLayout() const { return mDescriptorSetLayout; }
+	inline VkDescriptorSet getDescriptorSet(uint32_t frameIndex) const { return mFrames[frameIndex].descriptorSet; }
+	/*
+	 * desc ̃tOgVF[_[JE^ւ̉ZɍւLq (_̏͂̂܂)
+	 * layout  set 0 ƃvbV萔 desc.layout ƓŁAset 1  getDescriptorSetLayout 
+	 */
+	static GraphicsPipelineDesc makePipelineDesc(const GraphicsPipelineDesc& desc, VkPipelineLayout layout);
+
+	inline bool isSupported() const { return mIsSupported; }
+	inline bool isEnabled() const { return mIsSupported && mIsEnabled; }
+	inline void setEnabled(bool enabled) { mIsEnabled = enabled; }
+	inline const Stats& getStats() const { return mStats; }
+
+private:
+	void createDescriptors_(GfxDevice* gfx_device);
+	void createHeatmapPipeline_(GfxDevice* gfx_device, VkRenderPass renderPass);
+	void createFrameResources_(GfxDevice* gfx_device);
+	void destroyFrameResources_(GfxDevice* gfx_device);
+	void updateDescriptorSets_(GfxDevice* gfx_device);
+
+	// VF[_[ƈv邱 (heatmap.frag  OverdrawStats)
+	struct StatsBuffer
+	{
+		uint32_t maxCount;
+		uint32_t totalCount;
+		uint32_t coveredPixels;
+	};
+	struct HeatmapParams
+	{
+		float maxScale;
+		float opacity;
+	};
+
+	struct FrameResource
+	{
+		VkImage image = VK_NULL_HANDLE;
+		VkDeviceMemory imageMemory = VK_NULL_HANDLE;
+		VkImageView imageView = VK_NULL_HANDLE;
+		VkBuffer statsBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory statsMemory = VK_NULL_HANDLE;
+		StatsBuffer* mappedStats = nullptr;
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		bool hasResult = false;
+	};
+	std::array<FrameResource, sFrameCount> mFrames;
+
+	VkDevice mDevice = VK_NULL_HANDLE;
+	VkExtent2D mExtent{};
+	VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;
+	VkDescriptorPool mDescriptorPool = VK_NULL_HANDLE;
+	VkPipelineLayout mHeatmapPipelineLayout = VK_NULL_HANDLE;
+	VkPipeline mHeatmapPipeline = VK_NULL_HANDLE;
+
+	Stats mStats;
+	float mMaxScale = 8.0f;
+	float mOpacity = 0.75f;
+	bool mIsSupported = false;
+	bool mIsEnabled = false;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include "PipelineFeedback.h"
+#include <cstdio>
+#include "StartupProfiler.h"
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+static std::unique_ptr<PipelineFeedback> pipelineFeedback = nullptr;
+std::unique_ptr<PipelineFeedback>& getPipelineFeedback()
+{
+    if (pipelineFeedback == nullptr)
+    {
+        pipelineFeedback = std::make_unique<PipelineFeedback>();
+    }
+    return pipelineFeedback;
+}
+//---------------------------------------------------------------------------
+static const char* getKindName(PipelineCreateKind kind)
+{
+    switch (kind)
+    {
+    case PipelineCreateKind::Library: return "library";
+    case PipelineCreateKind::Link: return "link";
+    default: return "complete";
+    }
+}
+//---------------------------------------------------------------------------
+static void writeJsonString(std::ostream& out, const std::string& text)
+{
+    // pCvC̖O͌ĂяoRɕt̂ŁAJSON ̕ƂĕKvȂ̂GXP[v
+    out << '"';
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\r': out << "\\r"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                out << escaped;
+            }
+            else
+            {
+                out << c;
+            }
+            break;
+        }
+    }
+    out << '"';
+}
+//---------------------------------------------------------------------------
+static const char* getStageName(VkShaderStageFlagBits stage)
+{
+    switch (stage)
+    {
+    case VK_SHADER_STAGE_VERTEX_BIT: return "VS";
+    case VK_SHADER_STAGE_FRAGMENT_BIT: return "FS";
+    case VK_SHADER_STAGE_GEOMETRY_BIT: return "GS";
+    case VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT: return "TCS";
+    case VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT: return "TES";
+    default: return "?";
+    }
+}
+//---------------------------------------------------------------------------
+bool PipelineFeedbackRecord::isSlow() const
+{
+    return (isValid ? driverMs : wallMs) >= PipelineFeedback::sSlowThresholdMs;
+}
+//---------------------------------------------------------------------------
+void PipelineFeedback::begin(Scope& scope, const VkGraphicsPipelineCreateInfo& createInfo)
+{
+    // Xe[W̃tB[hobN pStages Ɠpӂ
+    scope.stages.clear();
+    for (uint32_t i = 0; i < createInfo.stageCount; ++i)
+    {
+        scope.stages.push_back(createInfo.pStages[i].stage);
+    }
+    scope.stageFeedbacks.assign(scope.stages.size(), VkPipelineCreationFeedback{});
+    scope.pipelineFeedback = VkPipelineCreationFeedback{};
+
+    if (createInfo.flags & VK_PIPELINE_CREATE_LIBRARY_BIT_KHR)
+    {
+        scope.kind = PipelineCreateKind::Library;
+    }
+    else if (createInfo.stageCount == 0)
+    {
+        scope.kind = PipelineCreateKind::Link;
+    }
+    else
+    {
+        scope.kind = PipelineCreateKind::Complete;
+    }
+
+    scope.createInfo = VkPipelineCreationFeedbackCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+        .pNext = createInfo.pNext,
+        .pPipelineCreationFeedback = &scope.pipelineFeedback,
+        .pipelineStageCreationFeedbackCount = static_cast<uint32_t>(scope.stageFeedbacks.size()),
+        .pPipelineStageCreationFeedbacks = scope.stageFeedbacks.empty() ? nullptr : scope.stageFeedbacks.data(),
+    };
+}
+//---------------------------------------------------------------------------
+void PipelineFeedback::end(const Scope& scope, const char* name, double wallMs)
+{
+    auto& profiler = getStartupProfiler();
+    const VkPipelineCreationFeedback& feedback = scope.pipelineFeedback;
+
+    PipelineFeedbackRecord record{
+        .name = name != nullptr ? name : "",
+        .kind = scope.kind,
+        .createdAtMs = profiler->getElapsedMs(),
+        .isStartup = !profiler->isFinished(),
+        .wallMs = wallMs,
+        .driverMs = feedback.duration / 1000000.0,
+        .isValid = (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT) != 0,
+        .isCacheHit = (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT) != 0,
+        .isBasePipelineAccelerated = (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_BASE_PIPELINE_ACCELERATION_BIT) != 0,
+    };
+    for (size_t i = 0; i < scope.stages.size(); ++i)
+    {
+        const auto& stage_feedback = scope.stageFeedbacks[i];
+        record.stages.push_back(PipelineStageFeedback{
+            .stage = scope.stages[i],
+            .durationMs = stage_feedback.duration / 1000000.0,
+            .isValid = (stage_feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT) != 0,
+            .isCacheHit = (stage_feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT) != 0,
+        });
+    }
+
+    // Ǒ͂̏ŃOɏo
+    const bool is_slow = record.isSlow();
+    const bool is_uncached = record.isUncached();
+    if (is_slow || is_uncached)
+    {
+        fprintf(stderr, "[PipelineFeedback] \"%s\" (%s) %.3f ms%s%s\n",
+            record.name.c_str(),
+            getKindName(record.kind),
+            record.isValid ? record.driverMs : record.wallMs,
+            is_slow ? " slow" : "",
+            is_uncached ? " uncached" : "");
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSlowCount += is_slow ? 1 : 0;
+    mUncachedCount += is_uncached ? 1 : 0;
+    mRecords.push_back(std::move(record));
+    if (mRecords.size() > sMaxRecords)
+    {
+        mRecords.pop_front();
+    }
+}
+//---------------------------------------------------------------------------
+std::vector<PipelineFeedbackRecord> PipelineFeedback::getRecords()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return { mRecords.begin(), mRecords.end() };
+}
+//---------------------------------------------------------------------------
+void PipelineFeedback::drawImGui()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    ImGui::Begin("Pipeline Feedback");
+    ImGui::Text("Pipelines: %zu  Slow (>= %.0f ms): %u  Uncached: %u", mRecords.size(), sSlowThresholdMs, mSlowCount, mUncachedCount);
+    ImGui::Checkbox("Flagged only", &mShowFlaggedOnly);
+
+    if (ImGui::BeginTable("feedback", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("Kind");
+        ImGui::TableSetupColumn("At ms");
+        ImGui::TableSetupColumn("Wall ms");
+        ImGui::TableSetupColumn("Driver ms");
+        ImGui::TableSetupColumn("Cache");
+        ImGui::TableSetupColumn("Stages");
+        ImGui::TableHeadersRow();
+        for (const auto& record : mRecords)
+        {
+            const bool is_flagged = record.isSlow() || record.isUncached();
+            if (mShowFlaggedOnly && !is_flagged)
+            {
+                continue;
+            }
+            ImGui::TableNextRow();
+            if (is_flagged)
+            {
+                ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, IM_COL32(120, 40, 40, 255));
+            }
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(record.name.c_str());
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(getKindName(record.kind));
+            ImGui::TableNextColumn(); ImGui::Text("%.1f%s", record.createdAtMs, record.isStartup ? " (startup)" : "");
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", record.wallMs);
+            ImGui::TableNextColumn();
+            if (record.isValid)
+            {
+                ImGui::Text("%.3f", record.driverMs);
+            }
+            else
+            {
+                ImGui::TextUnformatted("-");
+            }
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(!record.isValid ? "-" : record.isCacheHit ? "hit" : "miss");
+            ImGui::TableNextColumn();
+            for (const auto& stage : record.stages)
+            {
+                ImGui::Text("%s %.3f%s", getStageName(stage.stage), stage.durationMs, stage.isCacheHit ? " (hit)" : "");
+                ImGui::SameLine();
+            }
+            ImGui::NewLine();
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+//---------------------------------------------------------------------------
+void PipelineFeedback::writeJson(std::ostream& out)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    char buf[512];
+    out << "[\n";
+    for (size_t i = 0; i < mRecords.size(); ++i)
+    {
+        const auto& record = mRecords[i];
+        out << "    { \"name\": ";
+        writeJsonString(out, record.name);
+        snprintf(buf, sizeof(buf),
+            ", \"kind\": \"%s\", \"startup\": %s, \"at_ms\": %.3f, \"wall_ms\": %.3f, \"driver_ms\": %.3f, "
+            "\"feedback_valid\": %s, \"cache_hit\": %s, \"slow\": %s, \"uncached\": %s, \"stages\": [",
+            getKindName(record.kind),
+            record.isStartup ? "true" : "false",
+            record.createdAtMs,
+            record.wallMs,
+            record.driverMs,
+            record.isValid ? "true" : "false",
+            record.isCacheHit ? "true" : "false",
+            record.isSlow() ? "true" : "false",
+            record.isUncached() ? "true" : "false");
+        out << buf;
+        for (size_t j = 0; j < record.stages.size(); ++j)
+        {
+            const auto& stage = record.stages[j];
+            snprintf(buf, sizeof(buf), "%s{ \"stage\": \"%s\", \"duration_ms\": %.3f, \"cache_hit\": %s }",
+                j > 0 ? ", " : "",
+                getStageName(stage.stage),
+                stage.durationMs,
+                stage.isCacheHit ? "true" : "false");
+            out << buf;
+        }
+        out << "] }" << (i + 1 < mRecords.size() ? "," : "") << "\n";
+    }
+    out << "  ]";
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "GfxDevice.h"
+
+//---------------------------------------------------------------------------
+class PipelineFeedback;
+std::unique_ptr<PipelineFeedback>& getPipelineFeedback();
+
+//---------------------------------------------------------------------------
+enum class PipelineCreateKind
+{
+	Complete,   // ʏ̃pCvC
+	Library,    // pCvCCu
+	Link,       // CũN
+};
+//---------------------------------------------------------------------------
+struct PipelineStageFeedback
+{
+	VkShaderStageFlagBits stage = VK_SHADER_STAGE_VERTEX_BIT;
+	double durationMs = 0.0;
+	bool isValid = false;
+	bool isCacheHit = false;
+};
+//---------------------------------------------------------------------------
+/*
+ * pCvC1̐ (VkPipelineCreationFeedback ƌv)
+ */
+struct PipelineFeedbackRecord
+{
+	std::string name;
+	PipelineCreateKind kind = PipelineCreateKind::Complete;
+	double createdAtMs = 0.0;  // Ňoߎ
+	bool isStartup = false;    // N (StartupProfiler ̏IO) ōꂽ
+	double wallMs = 0.0;       // vkCreateGraphicsPipelines ̌Ăяoɂ
+	double driverMs = 0.0;     // hCo[񍐂
+	bool isValid = false;      // hCo[tB[hobNԂ
+	bool isCacheHit = false;   // pCvCLbVꂽ
+	bool isBasePipelineAccelerated = false;
+	std::vector<PipelineStageFeedback> stages;
+
+	bool isSlow() const;
+	bool isUncached() const { return isValid && !isCacheHit; }
+};
+
+//---------------------------------------------------------------------------
+/*
+ * pCvC VkPipelineCreationFeedback W߂
+ * LbVɓȂ̂⎞Ԃ͎̂̂ǑƂăOɏo
+ * GfxDevice::createGraphicsPipeline Ă΂̂ŁASẴpCvCΏۂɂȂ
+ */
+class PipelineFeedback
+{
+public:
+	// ȏォ̂xƂ݂Ȃ
+	static constexpr double sSlowThresholdMs = 10.0;
+	// ێL^̏ (Â̂̂Ă)
+	static constexpr size_t sMaxRecords = 512;
+
+public:
+	/*
+	 * createInfo  pNext ɌqtB[hobN̏o͐
+	 * begin  createInfo ɍ킹ďA end ŋL^
+	 */
+	struct Scope
+	{
+		VkPipelineCreationFeedbackCreateInfo createInfo{};
+		VkPipelineCreationFeedback pipelineFeedback{};
+		std::vector<VkPipelineCreationFeedback> stageFeedbacks;
+		std::vector<VkShaderStageFlagBits> stages;
+		PipelineCreateKind kind = PipelineCreateKind::Complete;
+	};
+	static void begin(Scope& scope, const VkGraphicsPipelineCreateInfo& createInfo);
+	void end(const Scope& scope, const char* name, double wallMs);
+
+	std::vector<PipelineFeedbackRecord> getRecords();
+	void drawImGui();
+	/*
+	 * N|[g (startup_report.json)  "pipelines" ɏo͂
+	 */
+	void writeJson(std::ostream& out);
+
+private:
+	std::mutex mMutex;
+	std::deque<PipelineFeedbackRecord> mRecords;
+	uint32_t mSlowCount = 0;
+	uint32_t mUncachedCount = 0;
+	bool mShowFlaggedOnly = false;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,508 @@
+#include "PipelineLayoutCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include "PipelineState.h"
+#include "VkObjectTracker.h"
+
+//---------------------------------------------------------------------------
+static std::unique_ptr<PipelineLayoutCache> pipelineLayoutCache = nullptr;
+std::unique_ptr<PipelineLayoutCache>& getPipelineLayoutCache()
+{
+    if (pipelineLayoutCache == nullptr)
+    {
+        pipelineLayoutCache = std::make_unique<PipelineLayoutCache>();
+    }
+    return pipelineLayoutCache;
+}
+//---------------------------------------------------------------------------
+static bool isSameBinding(const ReflectedBinding& a, const ReflectedBinding& b)
+{
+    return a.binding == b.binding && a.type == b.type && a.count == b.count && a.stages == b.stages && a.isRuntimeArray == b.isRuntimeArray;
+}
+//---------------------------------------------------------------------------
+const ReflectedBinding* ShaderLayout::findBinding(uint32_t set, uint32_t binding) const
+{
+    for (const auto& reflected : bindings)
+    {
+        if (reflected.set == set && reflected.binding == binding)
+        {
+            return &reflected;
+        }
+    }
+    return nullptr;
+}
+//---------------------------------------------------------------------------
+std::vector<VkDescriptorPoolSize> ShaderLayout::getPoolSizes(uint32_t set, uint32_t setCount) const
+{
+    std::vector<VkDescriptorPoolSize> pool_sizes;
+    for (const auto& reflected : bindings)
+    {
+        if (reflected.set != set)
+        {
+            continue;
+        }
+        auto it = std::find_if(pool_sizes.begin(), pool_sizes.end(), [&](const VkDescriptorPoolSize& size) { return size.type == reflected.type; });
+        if (it == pool_sizes.end())
+        {
+            pool_sizes.push_back(VkDescriptorPoolSize{ .type = reflected.type, .descriptorCount = 0 });
+            it = pool_sizes.end() - 1;
+        }
+        it->descriptorCount += reflected.count * setCount;
+    }
+    return pool_sizes;
+}
+//---------------------------------------------------------------------------
+uint32_t ShaderLayout::getDescriptorDataIndex(uint32_t set, uint32_t binding) const
+{
+    // PipelineLayoutCache::getDescriptorUpdateTemplate ƓoCfBOɋl߂ĕׂ
+    uint32_t index = 0;
+    for (const auto& reflected : bindings)
+    {
+        if (reflected.set != set)
+        {
+            continue;
+        }
+        if (reflected.binding == binding)
+        {
+            return index;
+        }
+        index += reflected.count;
+    }
+    return UINT32_MAX;
+}
+//---------------------------------------------------------------------------
+uint32_t ShaderLayout::getDescriptorDataCount(uint32_t set) const
+{
+    uint32_t count = 0;
+    for (const auto& reflected : bindings)
+    {
+        if (reflected.set == set)
+        {
+            count += reflected.count;
+        }
+    }
+    return count;
+}
+//---------------------------------------------------------------------------
+uint32_t ShaderLayout::getVariableDescriptorCount(uint32_t set) const
+{
+    // PipelineLayoutCache::getDescriptorSetLayout ŉϒɂ̂ set ̍Ō̃oCfBO
+    const ReflectedBinding* last = nullptr;
+    for (const auto& reflected : bindings)
+    {
+        if (reflected.set == set)
+        {
+            last = &reflected;
+        }
+    }
+    return last != nullptr && last->isRuntimeArray ? last->count : 0;
+}
+//---------------------------------------------------------------------------
+bool ShaderLayout::isPermutationSupported(const ShaderPermutation& permutation) const
+{
+    for (const auto& constant : permutation.getConstants())
+    {
+        if (!std::binary_search(specializationConstantIds.begin(), specializationConstantIds.end(), constant.constantId))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+//---------------------------------------------------------------------------
+void ShaderLayout::getVertexInputDescription(uint32_t binding, VkVertexInputBindingDescription& bindingDescription, std::vector<VkVertexInputAttributeDescription>& attributeDescriptions) const
+{
+    uint32_t offset = 0;
+    attributeDescriptions.clear();
+    for (const auto& input : vertexInputs)
+    {
+        attributeDescriptions.push_back(VkVertexInputAttributeDescription{
+            .location = input.location,
+            .binding = binding,
+            .format = input.format,
+            .offset = offset,
+        });
+        offset += input.size;
+    }
+    bindingDescription = VkVertexInputBindingDescription{
+        .binding = binding,
+        .stride = offset,
+        .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
+    };
+}
+//---------------------------------------------------------------------------
+void PipelineLayoutCache::initialize(GfxDevice* gfx_device)
+{
+    mGfxDevice = gfx_device;
+}
+//---------------------------------------------------------------------------
+void PipelineLayoutCache::shutdown()
+{
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    if (mGfxDevice == nullptr)
+    {
+        return;
+    }
+    auto device = mGfxDevice->getVkDevice();
+    auto& tracker = getVkObjectTracker();
+
+    // ev[gƃpCvCCAEg͎QƂZbgCAEgɔj
+    for (auto& entry : mUpdateTemplates)
+    {
+        vkDestroyDescriptorUpdateTemplate(device, entry.updateTemplate, nullptr);
+        tracker->onDestroy(entry.updateTemplate, VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE);
+    }
+    for (auto& [hash, entries] : mPipelineLayouts)
+    {
+        for (auto& entry : entries)
+        {
+            vkDestroyPipelineLayout(device, entry.layout, nullptr);
+            tracker->onDestroy(entry.layout, VK_OBJECT_TYPE_PIPELINE_LAYOUT);
+        }
+    }
+    for (auto& [hash, entries] : mSetLayouts)
+    {
+        for (auto& entry : entries)
+        {
+            vkDestroyDescriptorSetLayout(device, entry.layout, nullptr);
+            tracker->onDestroy(entry.layout, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+        }
+    }
+    mUpdateTemplates.clear();
+    mPipelineLayouts.clear();
+    mSetLayouts.clear();
+    mShaderLayouts.clear();
+    mSetLayoutCount = 0;
+    mPipelineLayoutCount = 0;
+    mGfxDevice = nullptr;
+}
+//---------------------------------------------------------------------------
+const ShaderLayout& PipelineLayoutCache::getShaderLayout(const std::vector<std::string>& spvPaths)
+{
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    std::string key;
+    for (const auto& path : spvPaths)
+    {
+        key += path;
+        key += ';';
+    }
+    if (auto it = mShaderLayouts.find(key); it != mShaderLayouts.end())
+    {
+        return *it->second;
+    }
+
+    auto layout = std::make_unique<ShaderLayout>();
+    for (const auto& path : spvPaths)
+    {
+        ShaderReflection reflection;
+        if (!reflection.loadFromFile(path))
+        {
+            throw std::runtime_error("failed to reflect shader " + path + "!");
+        }
+
+        // oCfBO𕡐̃Xe[WŎgꍇ̓Xe[W܂Ƃ߂
+        for (const auto& binding : reflection.getBindings())
+        {
+            auto it = std::find_if(layout->bindings.begin(), layout->bindings.end(), [&](const ReflectedBinding& merged) {
+                return merged.set == binding.set && merged.binding == binding.binding;
+            });
+            if (it == layout->bindings.end())
+            {
+                layout->bindings.push_back(binding);
+                continue;
+            }
+            if (it->type != binding.type)
+            {
+                throw std::runtime_error("descriptor type mismatch between shader stages at set " + std::to_string(binding.set) + " binding " + std::to_string(binding.binding) + "!");
+            }
+            it->stages |= binding.stages;
+            it->count = std::max(it->count, binding.count);
+        }
+
+        // ͈͂vbV萔̓Xe[W܂Ƃ߂
+        for (const auto& range : reflection.getPushConstantRanges())
+        {
+            auto it = std::find_if(layout->pushConstantRanges.begin(), layout->pushConstantRanges.end(), [&](const VkPushConstantRange& merged) {
+                return merged.offset == range.offset && merged.size == range.size;
+            });
+            if (it != layout->pushConstantRanges.end())
+            {
+                it->stageFlags |= range.stageFlags;
+            }
+            else
+            {
+                layout->pushConstantRanges.push_back(range);
+            }
+        }
+
+        if (reflection.getStage() == VK_SHADER_STAGE_VERTEX_BIT)
+        {
+            layout->vertexInputs = reflection.getVertexInputs();
+        }
+        const auto& constant_ids = reflection.getSpecializationConstantIds();
+        layout->specializationConstantIds.insert(layout->specializationConstantIds.end(), constant_ids.begin(), constant_ids.end());
+    }
+    std::sort(layout->specializationConstantIds.begin(), layout->specializationConstantIds.end());
+    layout->specializationConstantIds.erase(
+        std::unique(layout->specializationConstantIds.begin(), layout->specializationConstantIds.end()),
+        layout->specializationConstantIds.end());
+    std::sort(layout->bindings.begin(), layout->bindings.end(), [](const ReflectedBinding& a, const ReflectedBinding& b) {
+        return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+    });
+
+    // set ɃCAEg (r̎gĂȂ set ̃CAEgŖ߂)
+    const uint32_t set_count = layout->bindings.empty() ? 0 : layout->bindings.back().set + 1;
+    for (uint32_t set = 0; set < set_count; ++set)
+    {
+        std::vector<ReflectedBinding> set_bindings;
+        std::copy_if(layout->bindings.begin(), layout->bindings.end(), std::back_inserter(set_bindings), [set](const ReflectedBinding& binding) {
+            return binding.set == set;
+        });
+        layout->setLayouts.push_back(getDescriptorSetLayout(set_bindings));
+    }
+    layout->pipelineLayout = getPipelineLayout(layout->setLayouts, layout->pushConstantRanges);
+
+    return *mShaderLayouts.emplace(key, std::move(layout)).first->second;
+}
+//---------------------------------------------------------------------------
+VkDescriptorSetLayout PipelineLayoutCache::getDescriptorSetLayout(const std::vector<ReflectedBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags)
+{
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    StateHasher hasher;
+    hasher.add(flags);
+    for (const auto& binding : bindings)
+    {
+        hasher.add(binding.binding);
+        hasher.add(binding.type);
+        hasher.add(binding.count);
+        hasher.add(binding.stages);
+        hasher.add(binding.isRuntimeArray);
+    }
+    auto& entries = mSetLayouts[hasher.get()];
+    for (const auto& entry : entries)
+    {
+        if (entry.flags == flags && std::equal(entry.bindings.begin(), entry.bindings.end(), bindings.begin(), bindings.end(), isSameBinding))
+        {
+            return entry.layout;
+        }
+    }
+
+    std::vector<VkDescriptorSetLayoutBinding> layout_bindings;
+    for (const auto& binding : bindings)
+    {
+        layout_bindings.push_back(VkDescriptorSetLayoutBinding{
+            .binding = binding.binding,
+            .descriptorType = binding.type,
+            .descriptorCount = binding.count,
+            .stageFlags = binding.stages,
+            .pImmutableSamplers = nullptr,
+        });
+    }
+    // vfw̔z͑SĂނƂ͌Ȃ̂ PARTIALLY_BOUND ɂA
+    // Ō̃oCfBOłΊ蓖Ďɗvf߂悤ɂ (ShaderLayout::getVariableDescriptorCount)
+    std::vector<VkDescriptorBindingFlags> binding_flags(bindings.size(), 0);
+    bool has_runtime_array = false;
+    for (size_t i = 0; i < bindings.size(); ++i)
+    {
+        if (!bindings[i].isRuntimeArray)
+        {
+            continue;
+        }
+        if (!mGfxDevice->isDescriptorIndexingEnabled())
+        {
+            throw std::runtime_error("runtime descriptor arrays require descriptor indexing!");
+        }
+        has_runtime_array = true;
+        binding_flags[i] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+        // vbVfBXNv^̃Zbg͉ϒɂłȂ
+        const bool is_push_descriptor = (flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR) != 0;
+        if (i + 1 == bindings.size() && !is_push_descriptor && mGfxDevice->isVariableDescriptorCountEnabled())
+        {
+            binding_flags[i] |= VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT;
+        }
+    }
+    VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        .bindingCount = static_cast<uint32_t>(binding_flags.size()),
+        .pBindingFlags = binding_flags.data(),
+    };
+    VkDescriptorSetLayoutCreateInfo layout_create_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext = has_runtime_array ? &binding_flags_info : nullptr,
+        .flags = flags,
+        .bindingCount = static_cast<uint32_t>(layout_bindings.size()),
+        .pBindings = layout_bindings.data(),
+    };
+
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    if (vkCreateDescriptorSetLayout(mGfxDevice->getVkDevice(), &layout_create_info, nullptr, &layout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create descriptor set layout!");
+    }
+    getVkObjectTracker()->onCreate(layout, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+    const std::string name = "ReflectedSetLayout" + std::to_string(mSetLayoutCount);
+    mGfxDevice->setObjectName(uint64_t(layout), name.c_str(), VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT);
+
+    entries.push_back(SetLayoutEntry{ .bindings = bindings, .flags = flags, .layout = layout });
+    mSetLayoutCount++;
+    return layout;
+}
+//---------------------------------------------------------------------------
+VkPipelineLayout PipelineLayoutCache::getPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts, const std::vector<VkPushConstantRange>& pushConstantRanges)
+{
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    StateHasher hasher;
+    hasher.add(setLayouts);
+    hasher.add(pushConstantRanges);
+    auto& entries = mPipelineLayouts[hasher.get()];
+    for (const auto& entry : entries)
+    {
+        if (entry.setLayouts == setLayouts &&
+            entry.pushConstantRanges.size() == pushConstantRanges.size() &&
+            memcmp(entry.pushConstantRanges.data(), pushConstantRanges.data(), pushConstantRanges.size() * sizeof(VkPushConstantRange)) == 0)
+        {
+            return entry.layout;
+        }
+    }
+
+    VkPipelineLayoutCreateInfo pipeline_layout_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = static_cast<uint32_t>(setLayouts.size()),
+        .pSetLayouts = setLayouts.data(),
+        .pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size()),
+        .pPushConstantRanges = pushConstantRanges.data(),
+    };
+
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    if (vkCreatePipelineLayout(mGfxDevice->getVkDevice(), &pipeline_layout_info, nullptr, &layout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create pipeline layout!");
+    }
+    getVkObjectTracker()->onCreate(layout, VK_OBJECT_TYPE_PIPELINE_LAYOUT);
+    const std::string name = "ReflectedPipelineLayout" + std::to_string(mPipelineLayoutCount);
+    mGfxDevice->setObjectName(uint64_t(layout), name.c_str(), VK_OBJECT_TYPE_PIPELINE_LAYOUT);
+
+    entries.push_back(PipelineLayoutEntry{ .setLayouts = setLayouts, .pushConstantRanges = pushConstantRanges, .layout = layout });
+    mPipelineLayoutCount++;
+    return layout;
+}
+//---------------------------------------------------------------------------
+bool PipelineLayoutCache::findPipelineLayout(VkPipelineLayout layout, std::vector<VkDescriptorSetLayout>& setLayouts, std::vector<VkPushConstantRange>& pushConstantRanges)
+{
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    for (const auto& [hash, entries] : mPipelineLayouts)
+    {
+        for (const auto& entry : entries)
+        {
+            if (entry.layout == layout)
+            {
+                setLayouts = entry.setLayouts;
+                pushConstantRanges = entry.pushConstantRanges;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+//---------------------------------------------------------------------------
+VkDescriptorUpdateTemplate PipelineLayoutCache::getDescriptorUpdateTemplate(VkDescriptorSetLayout setLayout, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, uint32_t set)
+{
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    const SetLayoutEntry* set_layout = findSetLayout_(setLayout);
+    if (set_layout == nullptr)
+    {
+        throw std::runtime_error("descriptor set layout is not created by PipelineLayoutCache!");
+    }
+    if (set_layout->bindings.empty())
+    {
+        return VK_NULL_HANDLE;
+    }
+
+    // ʏ̃Zbgp̃ev[g̓vbVɈ˂Ȃ̂ŁAL[OċL
+    const bool is_push = (set_layout->flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR) != 0;
+    if (!is_push)
+    {
+        bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        pipelineLayout = VK_NULL_HANDLE;
+        set = 0;
+    }
+    else if (pipelineLayout == VK_NULL_HANDLE)
+    {
+        throw std::runtime_error("push descriptor template requires a pipeline layout!");
+    }
+    for (const auto& entry : mUpdateTemplates)
+    {
+        if (entry.setLayout == setLayout && entry.bindPoint == bindPoint && entry.pipelineLayout == pipelineLayout && entry.set == set)
+        {
+            return entry.updateTemplate;
+        }
+    }
+
+    // DescriptorData oCfBOɋl߂ĕׂzǂ (ShaderLayout::getDescriptorDataIndex Ɠ)
+    std::vector<VkDescriptorUpdateTemplateEntry> template_entries;
+    size_t offset = 0;
+    for (const auto& binding : set_layout->bindings)
+    {
+        template_entries.push_back(VkDescriptorUpdateTemplateEntry{
+            .dstBinding = binding.binding,
+            .dstArrayElement = 0,
+            .descriptorCount = binding.count,
+            .descriptorType = binding.type,
+            .offset = offset,
+            .stride = sizeof(DescriptorData),
+        });
+        offset += binding.count * sizeof(DescriptorData);
+    }
+    VkDescriptorUpdateTemplateCreateInfo create_info{
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+        .descriptorUpdateEntryCount = static_cast<uint32_t>(template_entries.size()),
+        .pDescriptorUpdateEntries = template_entries.data(),
+        .templateType = is_push ? VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR : VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET,
+        .descriptorSetLayout = setLayout,
+        .pipelineBindPoint = bindPoint,
+        .pipelineLayout = pipelineLayout,
+        .set = set,
+    };
+
+    VkDescriptorUpdateTemplate update_template = VK_NULL_HANDLE;
+    if (vkCreateDescriptorUpdateTemplate(mGfxDevice->getVkDevice(), &create_info, nullptr, &update_template) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to create descriptor update template!");
+    }
+    getVkObjectTracker()->onCreate(update_template, VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE);
+    const std::string name = (is_push ? "PushDescriptorTemplate" : "DescriptorUpdateTemplate") + std::to_string(mUpdateTemplates.size());
+    mGfxDevice->setObjectName(uint64_t(update_template), name.c_str(), VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE);
+
+    mUpdateTemplates.push_back(UpdateTemplateEntry{
+        .setLayout = setLayout,
+        .bindPoint = bindPoint,
+        .pipelineLayout = pipelineLayout,
+        .set = set,
+        .updateTemplate = update_template,
+    });
+    return update_template;
+}
+//---------------------------------------------------------------------------
+const PipelineLayoutCache::SetLayoutEntry* PipelineLayoutCache::findSetLayout_(VkDescriptorSetLayout layout) const
+{
+    for (const auto& [hash, entries] : mSetLayouts)
+    {
+        for (const auto& entry : entries)
+        {
+            if (entry.layout == layout)
+            {
+                return &entry;
+            }
+        }
+    }
+    return nullptr;
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
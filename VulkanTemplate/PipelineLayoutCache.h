@@ -0,0 +1,153 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "GfxDevice.h"
+#include "ShaderPermutation.h"
+#include "ShaderReflection.h"
+
+//---------------------------------------------------------------------------
+class PipelineLayoutCache;
+std::unique_ptr<PipelineLayoutCache>& getPipelineLayoutCache();
+
+//---------------------------------------------------------------------------
+/*
+ * fBXNv^XVev[gɓnfBXNv^1̃f[^
+ * Zbg̃oCfBO (z͗vf) ɌԂȂׂzev[g̓͂ɂ
+ * oCfBOz̉Ԗڂɗ邩 ShaderLayout::getDescriptorDataIndex ŋ߂
+ */
+union DescriptorData
+{
+	VkDescriptorImageInfo image;
+	VkDescriptorBufferInfo buffer;
+	VkBufferView texelBufferView;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * Xe[W̃tNVʂ܂Ƃ߂
+ * CAEg̃nh PipelineLayoutCache L
+ * ꉻ萔̃oAg͑SēCAEgL (oAgԂŃfBXNv^Zbgg񂹂)
+ */
+struct ShaderLayout
+{
+	// set, binding ̏ɕ񂾑SXe[W̃oCfBO
+	std::vector<ReflectedBinding> bindings;
+	// set ԍYƂ郌CAEg (gĂȂ set ͋̃CAEg)
+	std::vector<VkDescriptorSetLayout> setLayouts;
+	std::vector<VkPushConstantRange> pushConstantRanges;
+	VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+	// _VF[_[̓ (location )
+	std::vector<ReflectedVertexInput> vertexInputs;
+	// ꂩ̃Xe[WŐ錾Ăꉻ萔 constant_id
+	std::vector<uint32_t> specializationConstantIds;
+
+	const ReflectedBinding* findBinding(uint32_t set, uint32_t binding) const;
+	/*
+	 * set ̃fBXNv^Zbg setCount mۂ̂ɕKvȃv[TCY
+	 */
+	std::vector<VkDescriptorPoolSize> getPoolSizes(uint32_t set, uint32_t setCount) const;
+	/*
+	 * XVev[gɓn set  DescriptorData zł binding ̈ʒuƁAz̗vf
+	 * binding ꍇ UINT32_MAX Ԃ
+	 */
+	uint32_t getDescriptorDataIndex(uint32_t set, uint32_t binding) const;
+	uint32_t getDescriptorDataCount(uint32_t set) const;
+	/*
+	 * set ̍Ō̃oCfBOvfw̔z̏ꍇA̗vf (ȊO 0)
+	 * DescriptorAllocator::allocate ɓnƁAϒ̃oCfBOɑSĂ̗vf蓖Ă
+	 */
+	uint32_t getVariableDescriptorCount(uint32_t set) const;
+	/*
+	 * oAg̓ꉻ萔SăVF[_[ɐ錾Ă邩 (SPIR-V ÂꍇȂǂ false)
+	 */
+	bool isPermutationSupported(const ShaderPermutation& permutation) const;
+	/*
+	 * _͂1̃oCfBOɋl߂ĕׂꍇ̋Lq
+	 */
+	void getVertexInputDescription(uint32_t binding, VkVertexInputBindingDescription& bindingDescription, std::vector<VkVertexInputAttributeDescription>& attributeDescriptions) const;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * SPIR-V ̃tNVfBXNv^ZbgCAEgƃpCvCCAEg𐶐
+ * ẽCAEg̓nbVŏdċL
+ */
+class PipelineLayoutCache
+{
+public:
+	void initialize(GfxDevice* gfx_device);
+	void shutdown();
+
+	/*
+	 * VF[_[ (SPIR-V ̃pX) ̑gݍ킹ɑ΂郌CAEg擾
+	 * ǂݍ݂Xe[WԂ̕sŎsꍇ͗O𓊂
+	 */
+	const ShaderLayout& getShaderLayout(const std::vector<std::string>& spvPaths);
+
+	/*
+	 * 1 set ɑoCfBO烌CAEg擾
+	 * flags  VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR nƃvbVfBXNv^p̃CAEgɂȂ
+	 */
+	VkDescriptorSetLayout getDescriptorSetLayout(const std::vector<ReflectedBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags = 0);
+	VkPipelineLayout getPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts, const std::vector<VkPushConstantRange>& pushConstantRanges);
+	/*
+	 * ̃LbVŐpCvCCAEg̍\擾
+	 * VF[_[IuWFNg̓pCvCCAEgł͂ȂZbgCAEgƃvbV萔𒼐ڎ󂯎̂ŁA̕ϊɎg
+	 */
+	bool findPipelineLayout(VkPipelineLayout layout, std::vector<VkDescriptorSetLayout>& setLayouts, std::vector<VkPushConstantRange>& pushConstantRanges);
+	/*
+	 * ̃LbVŐZbgCAEg̑SoCfBO DescriptorData ̔z񂩂珑ރev[g擾
+	 * VkWriteDescriptorSet 𖈉gݗĂ vkUpdateDescriptorSetWithTemplate ɔznōς
+	 * vbVfBXNv^p̃CAEg̏ꍇ vkCmdPushDescriptorSetWithTemplateKHR p̃ev[gɂȂA
+	 * vbV bindPoint, pipelineLayout, set KvɂȂ (ʏ̃Zbg̏ꍇ͎gȂ)
+	 * oCfBOCAEg̏ꍇ VK_NULL_HANDLE Ԃ
+	 */
+	VkDescriptorUpdateTemplate getDescriptorUpdateTemplate(VkDescriptorSetLayout setLayout,
+		VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t set = 0);
+
+	inline size_t getDescriptorSetLayoutCount() const { return mSetLayoutCount; }
+	inline size_t getPipelineLayoutCount() const { return mPipelineLayoutCount; }
+	inline size_t getDescriptorUpdateTemplateCount() const { return mUpdateTemplates.size(); }
+
+private:
+	struct SetLayoutEntry
+	{
+		std::vector<ReflectedBinding> bindings;
+		VkDescriptorSetLayoutCreateFlags flags;
+		VkDescriptorSetLayout layout;
+	};
+	struct PipelineLayoutEntry
+	{
+		std::vector<VkDescriptorSetLayout> setLayouts;
+		std::vector<VkPushConstantRange> pushConstantRanges;
+		VkPipelineLayout layout;
+	};
+	struct UpdateTemplateEntry
+	{
+		VkDescriptorSetLayout setLayout;
+		VkPipelineBindPoint bindPoint;
+		VkPipelineLayout pipelineLayout;
+		uint32_t set;
+		VkDescriptorUpdateTemplate updateTemplate;
+	};
+
+	const SetLayoutEntry* findSetLayout_(VkDescriptorSetLayout layout) const;
+
+private:
+	GfxDevice* mGfxDevice = nullptr;
+	std::recursive_mutex mMutex;
+
+	// nbVՓ˂ꍇɔēnbVׂ͕̂̂Ď
+	std::unordered_map<uint64_t, std::vector<SetLayoutEntry>> mSetLayouts;
+	std::unordered_map<uint64_t, std::vector<PipelineLayoutEntry>> mPipelineLayouts;
+	std::map<std::string, std::unique_ptr<ShaderLayout>> mShaderLayouts;
+	// ev[g͏Ɏ擾ănhĂ̂Ȃ̂Ő`ɒT
+	std::vector<UpdateTemplateEntry> mUpdateTemplates;
+	size_t mSetLayoutCount = 0;
+	size_t mPipelineLayoutCount = 0;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
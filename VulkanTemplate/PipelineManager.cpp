@@ -0,0 +1,785 @@
+#include "PipelineManager.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include "ShaderSource.h"
+#include "VkObjectTracker.h"
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+static std::unique_ptr<PipelineManager> pipelineManager = nullptr;
+std::unique_ptr<PipelineManager>& getPipelineManager()
+{
+    if (pipelineManager == nullptr)
+    {
+        pipelineManager = std::make_unique<PipelineManager>();
+    }
+    return pipelineManager;
+}
+//---------------------------------------------------------------------------
+void PipelineManager::initialize(GfxDevice* gfx_device, uint32_t workerCount)
+{
+    mGfxDevice = gfx_device;
+
+    // `Xbh̎זȂx̃[J[ɂ
+    if (workerCount == 0)
+    {
+        workerCount = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+    }
+    mIsRunning = true;
+    for (uint32_t i = 0; i < workerCount; ++i)
+    {
+        mWorkers.emplace_back([this]() { workerThread_(); });
+    }
+}
+//---------------------------------------------------------------------------
+void PipelineManager::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsRunning = false;
+        mQueue.clear();
+        mOptimizeQueue.clear();
+    }
+    mQueueCondition.notify_all();
+    for (auto& worker : mWorkers)
+    {
+        worker.join();
+    }
+    mWorkers.clear();
+
+    for (auto& swap : mReadyToSwap)
+    {
+        destroyPipeline_(swap.pipeline);
+    }
+    mReadyToSwap.clear();
+    for (auto& retired : mRetiredPipelines)
+    {
+        destroyPipeline_(retired.pipeline);
+    }
+    mRetiredPipelines.clear();
+    for (auto& [desc, entry] : mEntries)
+    {
+        destroyPipeline_(entry->pipeline.exchange(VK_NULL_HANDLE));
+    }
+    mEntries.clear();
+
+    // Nς݂̃pCvCjĂ烉Cuj
+    for (auto& [key, libraries] : mLibraries)
+    {
+        for (auto& library : libraries)
+        {
+            destroyPipeline_(library.pipeline);
+        }
+    }
+    mLibraries.clear();
+    for (auto& library : mStaleLibraries)
+    {
+        destroyPipeline_(library.pipeline);
+    }
+    mStaleLibraries.clear();
+}
+//---------------------------------------------------------------------------
+void PipelineManager::destroyPipeline_(VkPipeline pipeline)
+{
+    if (pipeline == VK_NULL_HANDLE)
+    {
+        return;
+    }
+    vkDestroyPipeline(mGfxDevice->getVkDevice(), pipeline, nullptr);
+    getVkObjectTracker()->onDestroy(pipeline, VK_OBJECT_TYPE_PIPELINE);
+}
+//---------------------------------------------------------------------------
+PipelineHandle PipelineManager::requestPipeline(const GraphicsPipelineDesc& desc)
+{
+    // IXe[gɂłl𑵂ĂT̂ŁAlقȂLq͓pCvCɂȂ
+    GraphicsPipelineDesc pipeline_desc = desc.withDynamicState(mGfxDevice->getDynamicStateSupport());
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRequestCount++;
+    mVariantHashes.insert(desc.hash());
+
+    auto it = mEntries.find(pipeline_desc);
+    if (it != mEntries.end())
+    {
+        mDedupCount++;
+        return PipelineHandle(it->second.get());
+    }
+
+    auto entry = std::make_unique<PipelineEntry>();
+    entry->desc = pipeline_desc;
+    PipelineEntry* entry_ptr = entry.get();
+    mEntries.emplace(std::move(pipeline_desc), std::move(entry));
+
+    mQueue.push_back(CompileJob{ .entry = entry_ptr });
+    mQueueCondition.notify_one();
+    return PipelineHandle(entry_ptr);
+}
+//---------------------------------------------------------------------------
+void PipelineManager::reloadShader(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    {
+        // ÂVF[_[ōCu͈ȍ~̃NɎgȂ
+        std::lock_guard<std::mutex> library_lock(mLibraryMutex);
+        for (auto& [key, libraries] : mLibraries)
+        {
+            std::erase_if(libraries, [this, &path](const LibraryEntry& library) {
+                if (library.shaderPath != path)
+                {
+                    return false;
+                }
+                mStaleLibraries.push_back(RetiredPipeline{ .pipeline = library.pipeline, .retireFrame = mFrameNumber });
+                return true;
+            });
+        }
+    }
+    for (auto& [desc, entry] : mEntries)
+    {
+        if (desc.vertexShader == path || desc.fragmentShader == path)
+        {
+            mQueue.push_back(CompileJob{ .entry = entry.get(), .isReload = true });
+        }
+    }
+    mQueueCondition.notify_all();
+}
+//---------------------------------------------------------------------------
+void PipelineManager::beginFrame()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFrameNumber++;
+
+    // ւ: ÂpCvC͎gp̉\̂ŁA΂炭oĂj
+    for (auto& swap : mReadyToSwap)
+    {
+        VkPipeline old_pipeline = swap.entry->pipeline.exchange(swap.pipeline, std::memory_order_acq_rel);
+        swap.entry->status.store(PipelineStatus::Ready, std::memory_order_release);
+        if (old_pipeline != VK_NULL_HANDLE)
+        {
+            mRetiredPipelines.push_back(RetiredPipeline{ .pipeline = old_pipeline, .retireFrame = mFrameNumber });
+        }
+        if (swap.isOptimized)
+        {
+            mOptimizedCount++;
+        }
+        else
+        {
+            mReloadCount++;
+        }
+    }
+    mReadyToSwap.clear();
+
+    std::erase_if(mRetiredPipelines, [this](const RetiredPipeline& retired) {
+        if (mFrameNumber < retired.retireFrame + sRetireFrameDelay)
+        {
+            return false;
+        }
+        destroyPipeline_(retired.pipeline);
+        return true;
+    });
+
+    // ւOɎ擾CuŃÑ[J[邩Ȃ̂ŁARpC̃Wuɔj
+    if (mCompilingCount == 0)
+    {
+        for (auto& library : mStaleLibraries)
+        {
+            destroyPipeline_(library.pipeline);
+        }
+        mStaleLibraries.clear();
+    }
+}
+//---------------------------------------------------------------------------
+VkPipeline PipelineManager::waitPipeline(PipelineHandle handle)
+{
+    if (!handle.isValid())
+    {
+        return VK_NULL_HANDLE;
+    }
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCompletedCondition.wait(lock, [&handle]() { return handle.getStatus() != PipelineStatus::Pending; });
+    return handle.get();
+}
+//---------------------------------------------------------------------------
+void PipelineManager::workerThread_()
+{
+    while (true)
+    {
+        CompileJob job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mQueueCondition.wait(lock, [this]() { return !mIsRunning || !mQueue.empty() || !mOptimizeQueue.empty(); });
+            if (!mIsRunning)
+            {
+                break;
+            }
+            auto& queue = !mQueue.empty() ? mQueue : mOptimizeQueue;
+            job = queue.front();
+            queue.pop_front();
+            mCompilingCount++;
+        }
+
+        PipelineEntry& entry = *job.entry;
+        // NɑΉĂȂꍇ͍ŏœKN
+        const bool use_library = mGfxDevice->isGraphicsPipelineLibraryEnabled();
+        const bool is_fast_link = use_library && !job.isOptimize && mGfxDevice->hasGraphicsPipelineLibraryFastLinking();
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        {
+            // [J[ł̃RpC͕`~߂Ȃ̂ŁAԂɓ̗v
+            // (߂ĎgꂽoAgzbg[h) łsĂ悢
+            VkObjectTracker::SteadyStateExemption exemption;
+            pipeline = compile_(entry, use_library && !is_fast_link);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mCompilingCount--;
+        }
+
+        // N̂͌ōœKNčւ
+        auto queue_optimize = [&]() {
+            if (is_fast_link && pipeline != VK_NULL_HANDLE)
+            {
+                mFastLinkCount++;
+                mOptimizeQueue.push_back(CompileJob{ .entry = &entry, .isOptimize = true });
+                mQueueCondition.notify_one();
+            }
+        };
+
+        if (job.isReload || job.isOptimize)
+        {
+            // 蒼Ɏsꍇ͌ÂpCvCg
+            if (pipeline != VK_NULL_HANDLE)
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mReadyToSwap.push_back(SwapRequest{ .entry = &entry, .pipeline = pipeline, .isOptimized = job.isOptimize });
+                queue_optimize();
+            }
+            continue;
+        }
+
+        {
+            // waitPipeline 肱ڂȂ悤bNŏԂXVĒʒm
+            std::lock_guard<std::mutex> lock(mMutex);
+            entry.pipeline.store(pipeline, std::memory_order_release);
+            entry.status.store(pipeline != VK_NULL_HANDLE ? PipelineStatus::Ready : PipelineStatus::Failed, std::memory_order_release);
+            queue_optimize();
+        }
+        mCompletedCondition.notify_all();
+    }
+}
+//---------------------------------------------------------------------------
+VkShaderModule PipelineManager::loadShaderModule_(const std::string& path)
+{
+    std::vector<uint32_t> storage;
+    const auto code = getShaderSource()->load(path, storage);
+    if (code.empty())
+    {
+        fprintf(stderr, "[PipelineManager] failed to load %s\n", path.c_str());
+        return VK_NULL_HANDLE;
+    }
+    VkShaderModuleCreateInfo create_info{
+        .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        .codeSize = code.size_bytes(),
+        .pCode = code.data(),
+    };
+    VkShaderModule shader_module = VK_NULL_HANDLE;
+    if (vkCreateShaderModule(mGfxDevice->getVkDevice(), &create_info, nullptr, &shader_module) != VK_SUCCESS)
+    {
+        return VK_NULL_HANDLE;
+    }
+    getVkObjectTracker()->onCreate(shader_module, VK_OBJECT_TYPE_SHADER_MODULE);
+    return shader_module;
+}
+//---------------------------------------------------------------------------
+namespace
+{
+    /*
+     * GraphicsPipelineDesc pCvC̃Xe[gꎮ
+     * ݂Ƀ|C^ŎQƂ̂ŃRs[Ȃ
+     */
+    struct PipelineCreateState
+    {
+        VkSpecializationInfo specializationInfo{};
+        std::vector<VkSpecializationMapEntry> specializationEntries;
+        std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages{};
+        VkPipelineVertexInputStateCreateInfo vertexInput{};
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        VkPipelineViewportStateCreateInfo viewport{};
+        VkPipelineRasterizationStateCreateInfo rasterizer{};
+        VkPipelineMultisampleStateCreateInfo multisampling{};
+        VkPipelineDepthStencilStateCreateInfo depthStencil{};
+        VkPipelineColorBlendStateCreateInfo colorBlending{};
+        VkPipelineDynamicStateCreateInfo dynamicState{};
+        // Dynamic Rendering p
+        VkPipelineRenderingCreateInfo rendering{};
+
+        PipelineCreateState(const GraphicsPipelineDesc& desc, VkShaderModule vertShaderModule, VkShaderModule fragShaderModule)
+        {
+            desc.permutation.getSpecializationInfo(specializationInfo, specializationEntries);
+            const VkSpecializationInfo* specialization = desc.permutation.empty() ? nullptr : &specializationInfo;
+
+            shaderStages[0] = VkPipelineShaderStageCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                .stage = VK_SHADER_STAGE_VERTEX_BIT,
+                .module = vertShaderModule,
+                .pName = "main",
+                .pSpecializationInfo = specialization,
+            };
+            shaderStages[1] = VkPipelineShaderStageCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                .stage = VK_SHADER_STAGE_FRAGMENT_BIT,
+                .module = fragShaderModule,
+                .pName = "main",
+                .pSpecializationInfo = specialization,
+            };
+            vertexInput = VkPipelineVertexInputStateCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+                .vertexBindingDescriptionCount = static_cast<uint32_t>(desc.vertexBindings.size()),
+                .pVertexBindingDescriptions = desc.vertexBindings.data(),
+                .vertexAttributeDescriptionCount = static_cast<uint32_t>(desc.vertexAttributes.size()),
+                .pVertexAttributeDescriptions = desc.vertexAttributes.data(),
+            };
+            inputAssembly = VkPipelineInputAssemblyStateCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+                .topology = desc.topology,
+                .primitiveRestartEnable = desc.primitiveRestartEnable,
+            };
+            viewport = VkPipelineViewportStateCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+                .viewportCount = 1,
+                .scissorCount = 1,
+            };
+            rasterizer = VkPipelineRasterizationStateCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+                .depthClampEnable = VK_FALSE,
+                .rasterizerDiscardEnable = VK_FALSE,
+                .polygonMode = desc.polygonMode,
+                .cullMode = desc.cullMode,
+                .frontFace = desc.frontFace,
+                .depthBiasEnable = VK_FALSE,
+                .lineWidth = 1.0f,
+            };
+            multisampling = VkPipelineMultisampleStateCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+                .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+                .sampleShadingEnable = VK_FALSE,
+            };
+            depthStencil = VkPipelineDepthStencilStateCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+                .depthTestEnable = desc.depthTestEnable,
+                .depthWriteEnable = desc.depthWriteEnable,
+                .depthCompareOp = desc.depthCompareOp,
+            };
+            colorBlending = VkPipelineColorBlendStateCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+                .logicOpEnable = VK_FALSE,
+                .attachmentCount = 1,
+                .pAttachments = &desc.colorBlend,
+            };
+            dynamicState = VkPipelineDynamicStateCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+                .dynamicStateCount = static_cast<uint32_t>(desc.dynamicStates.size()),
+                .pDynamicStates = desc.dynamicStates.data(),
+            };
+            rendering = VkPipelineRenderingCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+                .colorAttachmentCount = 1,
+                .pColorAttachmentFormats = &desc.colorFormat,
+                .depthAttachmentFormat = desc.depthFormat,
+            };
+        }
+        PipelineCreateState(const PipelineCreateState&) = delete;
+        PipelineCreateState& operator=(const PipelineCreateState&) = delete;
+    };
+}
+//---------------------------------------------------------------------------
+VkPipeline PipelineManager::compile_(PipelineEntry& entry, bool isOptimize)
+{
+    const auto& desc = entry.desc;
+    const auto start_time = std::chrono::steady_clock::now();
+
+    VkPipeline pipeline = mGfxDevice->isGraphicsPipelineLibraryEnabled()
+        ? linkLibraries_(desc, isOptimize)
+        : compileMonolithic_(desc);
+
+    entry.compileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+    if (pipeline == VK_NULL_HANDLE)
+    {
+        fprintf(stderr, "[PipelineManager] failed to create pipeline \"%s\"\n", desc.debugName.c_str());
+        return VK_NULL_HANDLE;
+    }
+    if (!desc.debugName.empty())
+    {
+        mGfxDevice->setObjectName(uint64_t(pipeline), desc.debugName.c_str(), VK_OBJECT_TYPE_PIPELINE);
+    }
+    return pipeline;
+}
+//---------------------------------------------------------------------------
+VkPipeline PipelineManager::compileMonolithic_(const GraphicsPipelineDesc& desc)
+{
+    auto device = mGfxDevice->getVkDevice();
+    auto& tracker = getVkObjectTracker();
+
+    VkShaderModule vert_shader_module = loadShaderModule_(desc.vertexShader);
+    VkShaderModule frag_shader_module = loadShaderModule_(desc.fragmentShader);
+    auto destroy_shader_modules = [&]() {
+        for (VkShaderModule shader_module : { vert_shader_module, frag_shader_module })
+        {
+            if (shader_module != VK_NULL_HANDLE)
+            {
+                vkDestroyShaderModule(device, shader_module, nullptr);
+                tracker->onDestroy(shader_module, VK_OBJECT_TYPE_SHADER_MODULE);
+            }
+        }
+    };
+    if (vert_shader_module == VK_NULL_HANDLE || frag_shader_module == VK_NULL_HANDLE)
+    {
+        destroy_shader_modules();
+        return VK_NULL_HANDLE;
+    }
+
+    PipelineCreateState state(desc, vert_shader_module, frag_shader_module);
+    VkGraphicsPipelineCreateInfo pipeline_info{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = desc.renderPass == VK_NULL_HANDLE ? &state.rendering : nullptr,
+        .flags = desc.flags,
+        .stageCount = static_cast<uint32_t>(state.shaderStages.size()),
+        .pStages = state.shaderStages.data(),
+        .pVertexInputState = &state.vertexInput,
+        .pInputAssemblyState = &state.inputAssembly,
+        .pViewportState = &state.viewport,
+        .pRasterizationState = &state.rasterizer,
+        .pMultisampleState = &state.multisampling,
+        .pDepthStencilState = &state.depthStencil,
+        .pColorBlendState = &state.colorBlending,
+        .pDynamicState = &state.dynamicState,
+        .layout = desc.layout,
+        .renderPass = desc.renderPass,
+        .subpass = desc.subpass,
+    };
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkResult result = mGfxDevice->createGraphicsPipeline(pipeline_info, pipeline, desc.debugName.c_str());
+    destroy_shader_modules();
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr, "[PipelineManager] vkCreateGraphicsPipelines failed (%d)\n", int(result));
+        return VK_NULL_HANDLE;
+    }
+    return pipeline;
+}
+//---------------------------------------------------------------------------
+VkPipeline PipelineManager::linkLibraries_(const GraphicsPipelineDesc& desc, bool isOptimize)
+{
+    std::array<VkPipeline, size_t(LibraryPart::Count)> libraries{};
+    for (size_t i = 0; i < libraries.size(); ++i)
+    {
+        libraries[i] = getLibrary_(desc, LibraryPart(i));
+        if (libraries[i] == VK_NULL_HANDLE)
+        {
+            return VK_NULL_HANDLE;
+        }
+    }
+
+    VkPipelineLibraryCreateInfoKHR library_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+        .libraryCount = static_cast<uint32_t>(libraries.size()),
+        .pLibraries = libraries.data(),
+    };
+    VkGraphicsPipelineCreateInfo pipeline_info{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = &library_info,
+        .flags = desc.flags | (isOptimize ? VkPipelineCreateFlags(VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT) : 0),
+        .layout = desc.layout,
+    };
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkResult result = mGfxDevice->createGraphicsPipeline(pipeline_info, pipeline, desc.debugName.c_str());
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr, "[PipelineManager] failed to link pipeline libraries (%d)\n", int(result));
+        return VK_NULL_HANDLE;
+    }
+    return pipeline;
+}
+//---------------------------------------------------------------------------
+uint64_t PipelineManager::getLibraryKey_(const GraphicsPipelineDesc& desc, LibraryPart part)
+{
+    // CuɊ܂܂ԂŃnbV߂
+    StateHasher hasher;
+    hasher.add(part);
+    hasher.add(desc.dynamicStates);
+    // tO̓NSẴCuőKv
+    hasher.add(desc.flags);
+    switch (part)
+    {
+    case LibraryPart::VertexInput:
+        hasher.add(desc.vertexBindings);
+        hasher.add(desc.vertexAttributes);
+        hasher.add(desc.topology);
+        hasher.add(desc.primitiveRestartEnable);
+        break;
+    case LibraryPart::PreRasterization:
+        hasher.add(desc.vertexShader);
+        hasher.add(desc.permutation.getKey());
+        hasher.add(desc.polygonMode);
+        hasher.add(desc.cullMode);
+        hasher.add(desc.frontFace);
+        hasher.add(desc.layout);
+        break;
+    case LibraryPart::FragmentShader:
+        hasher.add(desc.fragmentShader);
+        hasher.add(desc.permutation.getKey());
+        hasher.add(desc.depthTestEnable);
+        hasher.add(desc.depthWriteEnable);
+        hasher.add(desc.depthCompareOp);
+        hasher.add(desc.layout);
+        break;
+    case LibraryPart::FragmentOutput:
+        hasher.add(desc.colorBlend);
+        break;
+    default:
+        break;
+    }
+    if (part != LibraryPart::VertexInput)
+    {
+        hasher.add(desc.renderPass);
+        hasher.add(desc.subpass);
+        hasher.add(desc.colorFormat);
+        hasher.add(desc.depthFormat);
+    }
+    return hasher.get();
+}
+//---------------------------------------------------------------------------
+bool PipelineManager::isSameLibrary_(const GraphicsPipelineDesc& a, const GraphicsPipelineDesc& b, LibraryPart part)
+{
+    // getLibraryKey_ nbVɊ܂߂Ԃׂ
+    auto same_bytes = [](const auto& x, const auto& y) {
+        return x.size() == y.size() && (x.empty() || memcmp(x.data(), y.data(), x.size() * sizeof(x[0])) == 0);
+    };
+    if (a.dynamicStates != b.dynamicStates || a.flags != b.flags)
+    {
+        return false;
+    }
+    if (part != LibraryPart::VertexInput &&
+        (a.renderPass != b.renderPass || a.subpass != b.subpass || a.colorFormat != b.colorFormat || a.depthFormat != b.depthFormat))
+    {
+        return false;
+    }
+    switch (part)
+    {
+    case LibraryPart::VertexInput:
+        return same_bytes(a.vertexBindings, b.vertexBindings) &&
+            same_bytes(a.vertexAttributes, b.vertexAttributes) &&
+            a.topology == b.topology &&
+            a.primitiveRestartEnable == b.primitiveRestartEnable;
+    case LibraryPart::PreRasterization:
+        return a.vertexShader == b.vertexShader &&
+            a.permutation == b.permutation &&
+            a.polygonMode == b.polygonMode &&
+            a.cullMode == b.cullMode &&
+            a.frontFace == b.frontFace &&
+            a.layout == b.layout;
+    case LibraryPart::FragmentShader:
+        return a.fragmentShader == b.fragmentShader &&
+            a.permutation == b.permutation &&
+            a.depthTestEnable == b.depthTestEnable &&
+            a.depthWriteEnable == b.depthWriteEnable &&
+            a.depthCompareOp == b.depthCompareOp &&
+            a.layout == b.layout;
+    case LibraryPart::FragmentOutput:
+        return memcmp(&a.colorBlend, &b.colorBlend, sizeof(a.colorBlend)) == 0;
+    default:
+        return false;
+    }
+}
+//---------------------------------------------------------------------------
+VkPipeline PipelineManager::getLibrary_(const GraphicsPipelineDesc& desc, LibraryPart part)
+{
+    const uint64_t key = getLibraryKey_(desc, part);
+    auto find_library = [&](const std::vector<LibraryEntry>& libraries) -> const LibraryEntry* {
+        for (const auto& library : libraries)
+        {
+            if (library.part == part && isSameLibrary_(library.desc, desc, part))
+            {
+                return &library;
+            }
+        }
+        return nullptr;
+    };
+    {
+        std::lock_guard<std::mutex> lock(mLibraryMutex);
+        if (auto it = mLibraries.find(key); it != mLibraries.end())
+        {
+            if (const LibraryEntry* library = find_library(it->second))
+            {
+                return library->pipeline;
+            }
+        }
+    }
+
+    // VF[_[܂ރCuW[ǂݍ
+    const std::string* shader_path = nullptr;
+    if (part == LibraryPart::PreRasterization)
+    {
+        shader_path = &desc.vertexShader;
+    }
+    else if (part == LibraryPart::FragmentShader)
+    {
+        shader_path = &desc.fragmentShader;
+    }
+    VkShaderModule shader_module = VK_NULL_HANDLE;
+    if (shader_path != nullptr)
+    {
+        shader_module = loadShaderModule_(*shader_path);
+        if (shader_module == VK_NULL_HANDLE)
+        {
+            return VK_NULL_HANDLE;
+        }
+    }
+
+    PipelineCreateState state(desc, shader_module, shader_module);
+    VkGraphicsPipelineLibraryCreateInfoEXT library_info{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+        .pNext = desc.renderPass == VK_NULL_HANDLE ? &state.rendering : nullptr,
+    };
+    // œKNp̏cĂ
+    VkGraphicsPipelineCreateInfo pipeline_info{
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = &library_info,
+        .flags = desc.flags | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT,
+        .pDynamicState = &state.dynamicState,
+    };
+    switch (part)
+    {
+    case LibraryPart::VertexInput:
+        library_info.flags = VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT;
+        pipeline_info.pVertexInputState = &state.vertexInput;
+        pipeline_info.pInputAssemblyState = &state.inputAssembly;
+        break;
+    case LibraryPart::PreRasterization:
+        library_info.flags = VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT;
+        pipeline_info.stageCount = 1;
+        pipeline_info.pStages = &state.shaderStages[0];
+        pipeline_info.pViewportState = &state.viewport;
+        pipeline_info.pRasterizationState = &state.rasterizer;
+        break;
+    case LibraryPart::FragmentShader:
+        library_info.flags = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT;
+        pipeline_info.stageCount = 1;
+        pipeline_info.pStages = &state.shaderStages[1];
+        pipeline_info.pMultisampleState = &state.multisampling;
+        pipeline_info.pDepthStencilState = &state.depthStencil;
+        break;
+    case LibraryPart::FragmentOutput:
+        library_info.flags = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT;
+        pipeline_info.pMultisampleState = &state.multisampling;
+        pipeline_info.pColorBlendState = &state.colorBlending;
+        break;
+    default:
+        break;
+    }
+    if (part == LibraryPart::PreRasterization || part == LibraryPart::FragmentShader)
+    {
+        pipeline_info.layout = desc.layout;
+    }
+    if (part != LibraryPart::VertexInput)
+    {
+        pipeline_info.renderPass = desc.renderPass;
+        pipeline_info.subpass = desc.subpass;
+    }
+
+    // Cũ͕pCvCŋL邪AO͍ŏɗv̂t
+    static constexpr const char* sPartNames[] = { "VertexInput", "PreRasterization", "FragmentShader", "FragmentOutput" };
+    const std::string library_name = desc.debugName + "." + sPartNames[size_t(part)];
+    VkPipeline library = VK_NULL_HANDLE;
+    VkResult result = mGfxDevice->createGraphicsPipeline(pipeline_info, library, library_name.c_str());
+    if (shader_module != VK_NULL_HANDLE)
+    {
+        vkDestroyShaderModule(mGfxDevice->getVkDevice(), shader_module, nullptr);
+        getVkObjectTracker()->onDestroy(shader_module, VK_OBJECT_TYPE_SHADER_MODULE);
+    }
+    if (result != VK_SUCCESS)
+    {
+        fprintf(stderr, "[PipelineManager] failed to create pipeline library (%d)\n", int(result));
+        return VK_NULL_HANDLE;
+    }
+
+    // ̃[J[ɓCuĂꍇ͂g
+    std::lock_guard<std::mutex> lock(mLibraryMutex);
+    auto& libraries = mLibraries[key];
+    if (const LibraryEntry* existing = find_library(libraries))
+    {
+        destroyPipeline_(library);
+        return existing->pipeline;
+    }
+    libraries.push_back(LibraryEntry{
+        .part = part,
+        .desc = desc,
+        .pipeline = library,
+        .shaderPath = shader_path != nullptr ? *shader_path : std::string(),
+    });
+    return library;
+}
+//---------------------------------------------------------------------------
+PipelineManager::Stats PipelineManager::getStats()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    Stats stats{
+        .pipelineCount = static_cast<uint32_t>(mEntries.size()),
+        .variantCount = static_cast<uint32_t>(mVariantHashes.size()),
+        .requestCount = mRequestCount,
+        .dedupCount = mDedupCount,
+        .reloadCount = mReloadCount,
+        .isLibraryEnabled = mGfxDevice != nullptr && mGfxDevice->isGraphicsPipelineLibraryEnabled(),
+        .fastLinkCount = mFastLinkCount,
+        .optimizedCount = mOptimizedCount,
+    };
+    {
+        std::lock_guard<std::mutex> library_lock(mLibraryMutex);
+        for (const auto& [key, libraries] : mLibraries)
+        {
+            stats.libraryCount += static_cast<uint32_t>(libraries.size());
+        }
+    }
+    for (const auto& [desc, entry] : mEntries)
+    {
+        switch (entry->status.load(std::memory_order_acquire))
+        {
+        case PipelineStatus::Pending: stats.pendingCount++; break;
+        case PipelineStatus::Failed: stats.failedCount++; break;
+        default: break;
+        }
+    }
+    return stats;
+}
+//---------------------------------------------------------------------------
+void PipelineManager::drawImGui()
+{
+    const Stats stats = getStats();
+
+    ImGui::SeparatorText("Pipelines");
+    ImGui::Text("Pipelines: %u (pending %u, failed %u)", stats.pipelineCount, stats.pendingCount, stats.failedCount);
+    ImGui::Text("State variants: %u (%.1fx collapsed by dynamic state)",
+        stats.variantCount,
+        stats.pipelineCount > 0 ? double(stats.variantCount) / double(stats.pipelineCount) : 0.0);
+    ImGui::Text("Requests: %llu (dedup %llu)  Reloaded: %llu",
+        static_cast<unsigned long long>(stats.requestCount),
+        static_cast<unsigned long long>(stats.dedupCount),
+        static_cast<unsigned long long>(stats.reloadCount));
+    if (stats.isLibraryEnabled)
+    {
+        ImGui::Text("Pipeline libraries: %u  Fast linked: %llu  Optimized: %llu",
+            stats.libraryCount,
+            static_cast<unsigned long long>(stats.fastLinkCount),
+            static_cast<unsigned long long>(stats.optimizedCount));
+    }
+    else
+    {
+        ImGui::Text("Pipeline libraries: unsupported (monolithic)");
+    }
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,203 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "GfxDevice.h"
+#include "PipelineState.h"
+
+//---------------------------------------------------------------------------
+class PipelineManager;
+std::unique_ptr<PipelineManager>& getPipelineManager();
+
+//---------------------------------------------------------------------------
+enum class PipelineStatus
+{
+	Pending,
+	Ready,
+	Failed,
+};
+//---------------------------------------------------------------------------
+/*
+ * PipelineManager ێpCvC1̏
+ */
+struct PipelineEntry
+{
+	GraphicsPipelineDesc desc;
+	std::atomic<VkPipeline> pipeline = VK_NULL_HANDLE;
+	std::atomic<PipelineStatus> status = PipelineStatus::Pending;
+	double compileMs = 0.0;
+};
+//---------------------------------------------------------------------------
+/*
+ * pCvCւ̎Q
+ * t[̎擾̓bNōs
+ */
+class PipelineHandle
+{
+public:
+	PipelineHandle() = default;
+
+	/*
+	 * RpC܂͎sĂꍇ VK_NULL_HANDLE
+	 */
+	inline VkPipeline get() const { return mEntry != nullptr ? mEntry->pipeline.load(std::memory_order_acquire) : VK_NULL_HANDLE; }
+	inline PipelineStatus getStatus() const { return mEntry != nullptr ? mEntry->status.load(std::memory_order_acquire) : PipelineStatus::Failed; }
+	inline bool isValid() const { return mEntry != nullptr; }
+
+private:
+	friend class PipelineManager;
+	explicit PipelineHandle(PipelineEntry* entry) : mEntry(entry) {}
+
+	PipelineEntry* mEntry = nullptr;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * GraphicsPipelineDesc pCvC𐶐EǗ
+ * Lq̗v1̃pCvCɂ܂Ƃ߁Â̂̓[J[XbhŃRpC
+ * RpC̃nh VK_NULL_HANDLE Ԃ̂ŁAĂяo͕`XLbv
+ *
+ * VK_EXT_graphics_pipeline_library gꍇ́A_́EvX^CYEtOgVF[_[E
+ * tOgo͂4̃CuʁXɃRpCċLA܂N̂Ԃ
+ * ̌obNOEhōœKNAôɍւ
+ */
+class PipelineManager
+{
+public:
+	// ւŕsvɂȂpCvCj܂ł̃t[
+	// CtCgt[傫Ă΁AGPUgp̂̂j邱Ƃ͂Ȃ
+	static constexpr uint32_t sRetireFrameDelay = 3;
+
+	struct Stats
+	{
+		uint32_t pipelineCount = 0;
+		uint32_t variantCount = 0;   // vꂽLq̎ (IXe[g̒l̈Ⴂ܂)
+		uint32_t pendingCount = 0;
+		uint32_t failedCount = 0;
+		uint64_t requestCount = 0;
+		uint64_t dedupCount = 0;     // ̃Ggōς񂾗v
+		uint64_t reloadCount = 0;    // zbg[hōւ
+		// VK_EXT_graphics_pipeline_library gp
+		bool isLibraryEnabled = false;
+		uint32_t libraryCount = 0;
+		uint64_t fastLinkCount = 0;
+		uint64_t optimizedCount = 0; // œKNōւ
+	};
+
+public:
+	void initialize(GfxDevice* gfx_device, uint32_t workerCount = 0);
+	void shutdown();
+
+	/*
+	 * pCvCv (ubNȂ)
+	 * Lqɂ΂̃nhA΃RpCJnănhԂ
+	 * foCXIɂł (GfxDevice::getDynamicStateSupport) ͋Lq菜Ĕr̂ŁA
+	 * `掞 DynamicStateCache  desc ̒lݒ肷邱
+	 */
+	PipelineHandle requestPipeline(const GraphicsPipelineDesc& desc);
+	/*
+	 * RpC܂ő҂ (NȂǁAKKvȂ̗p)
+	 */
+	VkPipeline waitPipeline(PipelineHandle handle);
+
+	/*
+	 * w肵VF[_[ (SPIR-V ̃pX) gpCvC蒼
+	 * VpCvC͎ beginFrame ōւA܂ł͌Â̂g
+	 */
+	void reloadShader(const std::string& path);
+	/*
+	 * t[̋E (CtCgtFX̑ҋ@AR}hL^O) ŌĂяo
+	 * 蒼pCvCւ̍ւƁAÂpCvC̒xjs
+	 */
+	void beginFrame();
+
+	Stats getStats();
+	void drawImGui();
+
+private:
+	struct CompileJob
+	{
+		PipelineEntry* entry = nullptr;
+		bool isReload = false;
+		bool isOptimize = false;   // Nς݂̂̂œKN
+	};
+	struct SwapRequest
+	{
+		PipelineEntry* entry = nullptr;
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		bool isOptimized = false;
+	};
+	enum class LibraryPart
+	{
+		VertexInput,
+		PreRasterization,
+		FragmentShader,
+		FragmentOutput,
+		Count,
+	};
+	struct LibraryEntry
+	{
+		// nbVՓ˂ꍇɔׂ邽߂̋Lq (part Ɋ܂܂Ԃ)
+		LibraryPart part = LibraryPart::Count;
+		GraphicsPipelineDesc desc;
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		// VF[_[܂ރCu̓zbg[hō蒼
+		std::string shaderPath;
+	};
+	struct RetiredPipeline
+	{
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		uint64_t retireFrame = 0;
+	};
+
+	void workerThread_();
+	VkPipeline compile_(PipelineEntry& entry, bool isOptimize);
+	VkPipeline compileMonolithic_(const GraphicsPipelineDesc& desc);
+	VkPipeline linkLibraries_(const GraphicsPipelineDesc& desc, bool isOptimize);
+	VkPipeline getLibrary_(const GraphicsPipelineDesc& desc, LibraryPart part);
+	static uint64_t getLibraryKey_(const GraphicsPipelineDesc& desc, LibraryPart part);
+	static bool isSameLibrary_(const GraphicsPipelineDesc& a, const GraphicsPipelineDesc& b, LibraryPart part);
+	void destroyPipeline_(VkPipeline pipeline);
+	VkShaderModule loadShaderModule_(const std::string& path);
+
+private:
+	GfxDevice* mGfxDevice = nullptr;
+
+	std::mutex mMutex;
+	std::unordered_map<GraphicsPipelineDesc, std::unique_ptr<PipelineEntry>, GraphicsPipelineDescHasher> mEntries;
+	std::deque<CompileJob> mQueue;
+	// œKN͐VK̃RpCs
+	std::deque<CompileJob> mOptimizeQueue;
+	// [J[ō蒼ς݁Ãt[Eōւ
+	std::vector<SwapRequest> mReadyToSwap;
+	std::vector<RetiredPipeline> mRetiredPipelines;
+	// zbg[hŕsvɂȂCu
+	// Nς݂̃pCvC̓CuQƂȂ̂ŁAÑ[J[ȂΔjł
+	std::vector<RetiredPipeline> mStaleLibraries;
+	// RpC̃Wu̐ (Cu擾Ă烊NI܂ł܂)
+	uint32_t mCompilingCount = 0;
+	uint64_t mFrameNumber = 0;
+	std::condition_variable mQueueCondition;
+	std::condition_variable mCompletedCondition;
+	std::vector<std::thread> mWorkers;
+	bool mIsRunning = false;
+
+	uint64_t mRequestCount = 0;
+	std::unordered_set<uint64_t> mVariantHashes;
+	uint64_t mDedupCount = 0;
+	uint64_t mReloadCount = 0;
+	uint64_t mFastLinkCount = 0;
+	uint64_t mOptimizedCount = 0;
+
+	// Xe[W̃pCvCCu (nbV̂͋Lqׂċʂ)
+	std::mutex mLibraryMutex;
+	std::unordered_map<uint64_t, std::vector<LibraryEntry>> mLibraries;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
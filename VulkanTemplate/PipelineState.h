@@ -0,0 +1,221 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "GfxDevice.h"
+#include "ShaderPermutation.h"
+
+//---------------------------------------------------------------------------
+/*
+ * FNV-1a ɂnbV̐ςݏグ
+ */
+class StateHasher
+{
+public:
+	inline void addBytes(const void* data, size_t size)
+	{
+		const auto* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			mHash ^= bytes[i];
+			mHash *= 0x100000001b3ull;
+		}
+	}
+	template<typename T>
+	inline void add(const T& value) { addBytes(&value, sizeof(T)); }
+	inline void add(const std::string& value) { add(value.size()); addBytes(value.data(), value.size()); }
+	template<typename T>
+	inline void add(const std::vector<T>& values) { add(values.size()); addBytes(values.data(), values.size() * sizeof(T)); }
+
+	inline uint64_t get() const { return mHash; }
+
+private:
+	uint64_t mHash = 0xcbf29ce484222325ull;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * OtBbNXpCvC̐ɕKvȏԂ܂Ƃ߂
+ * e̋Lq͓nbVɂȂAPipelineManager œ̃pCvCƂĈ
+ * Ɋ܂܂ Vulkan \̂̓pfBOȂ̂Ɍ (oCgŔr邽)
+ */
+struct GraphicsPipelineDesc
+{
+	// VF[_[ (SPIR-V ̃pX)
+	std::string vertexShader;
+	std::string fragmentShader;
+	// ꉻ萔 (̃Xe[Wɓ̂nAVF[_[ɖ constant_id ͖)
+	ShaderPermutation permutation;
+
+	// _
+	std::vector<VkVertexInputBindingDescription> vertexBindings;
+	std::vector<VkVertexInputAttributeDescription> vertexAttributes;
+	VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	VkBool32 primitiveRestartEnable = VK_FALSE;
+
+	// X^CY
+	VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+	VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+	VkFrontFace frontFace = VK_FRONT_FACE_CLOCKWISE;
+	VkBool32 depthTestEnable = VK_FALSE;
+	VkBool32 depthWriteEnable = VK_FALSE;
+	VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+
+	// uh (J[A^b`g1)
+	VkPipelineColorBlendAttachmentState colorBlend{
+		.blendEnable = VK_FALSE,
+		.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+	};
+
+	std::vector<VkDynamicState> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+	// A^b`g
+	// renderPass  VK_NULL_HANDLE ̏ꍇ Dynamic Rendering ƂătH[}bgg
+	VkRenderPass renderPass = VK_NULL_HANDLE;
+	uint32_t subpass = 0;
+	VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+	VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+
+	VkPipelineLayout layout = VK_NULL_HANDLE;
+	// ǉ̐tO (descriptor buffer ̃CAEggꍇ VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT Ȃ)
+	VkPipelineCreateFlags flags = 0;
+
+	// fobOp̖O (nbVɂ͊܂߂Ȃ)
+	std::string debugName;
+
+	/*
+	 * `挋ʂɉeSĂ̏ԂnbV߂
+	 */
+	uint64_t hash() const
+	{
+		StateHasher hasher;
+		hasher.add(vertexShader);
+		hasher.add(fragmentShader);
+		hasher.add(permutation.getKey());
+		hasher.add(vertexBindings);
+		hasher.add(vertexAttributes);
+		hasher.add(topology);
+		hasher.add(primitiveRestartEnable);
+		hasher.add(polygonMode);
+		hasher.add(cullMode);
+		hasher.add(frontFace);
+		hasher.add(depthTestEnable);
+		hasher.add(depthWriteEnable);
+		hasher.add(depthCompareOp);
+		hasher.add(colorBlend);
+		hasher.add(dynamicStates);
+		hasher.add(renderPass);
+		hasher.add(subpass);
+		hasher.add(colorFormat);
+		hasher.add(depthFormat);
+		hasher.add(layout);
+		hasher.add(flags);
+		return hasher.get();
+	}
+
+	bool operator==(const GraphicsPipelineDesc& other) const
+	{
+		auto same_bytes = [](const auto& a, const auto& b) {
+			return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(a[0])) == 0);
+		};
+		return vertexShader == other.vertexShader &&
+			fragmentShader == other.fragmentShader &&
+			permutation == other.permutation &&
+			same_bytes(vertexBindings, other.vertexBindings) &&
+			same_bytes(vertexAttributes, other.vertexAttributes) &&
+			topology == other.topology &&
+			primitiveRestartEnable == other.primitiveRestartEnable &&
+			polygonMode == other.polygonMode &&
+			cullMode == other.cullMode &&
+			frontFace == other.frontFace &&
+			depthTestEnable == other.depthTestEnable &&
+			depthWriteEnable == other.depthWriteEnable &&
+			depthCompareOp == other.depthCompareOp &&
+			memcmp(&colorBlend, &other.colorBlend, sizeof(colorBlend)) == 0 &&
+			dynamicStates == other.dynamicStates &&
+			renderPass == other.renderPass &&
+			subpass == other.subpass &&
+			colorFormat == other.colorFormat &&
+			depthFormat == other.depthFormat &&
+			layout == other.layout &&
+			flags == other.flags;
+	}
+
+	/*
+	 * support œIɂłԂlɑAdynamicStates ɉLqԂ
+	 * IXe[g̒lقȂLq͓pCvCɂȂ̂ŁAl̓R}hobt@ɐݒ肷邱 (DynamicStateCache)
+	 */
+	GraphicsPipelineDesc withDynamicState(const DynamicStateSupport& support) const
+	{
+		GraphicsPipelineDesc desc = *this;
+		const GraphicsPipelineDesc defaults;
+		auto add_dynamic_state = [&desc](VkDynamicState state) {
+			if (std::find(desc.dynamicStates.begin(), desc.dynamicStates.end(), state) == desc.dynamicStates.end())
+			{
+				desc.dynamicStates.push_back(state);
+			}
+		};
+
+		if (support.extendedDynamicState)
+		{
+			// ނׂ؂ւłȂꍇ́AނƂ̑\ɑ
+			desc.topology = support.unrestrictedTopology ? defaults.topology : getTopologyClass(topology);
+			desc.cullMode = defaults.cullMode;
+			desc.frontFace = defaults.frontFace;
+			desc.depthTestEnable = defaults.depthTestEnable;
+			desc.depthWriteEnable = defaults.depthWriteEnable;
+			desc.depthCompareOp = defaults.depthCompareOp;
+			add_dynamic_state(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY);
+			add_dynamic_state(VK_DYNAMIC_STATE_CULL_MODE);
+			add_dynamic_state(VK_DYNAMIC_STATE_FRONT_FACE);
+			add_dynamic_state(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE);
+			add_dynamic_state(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE);
+			add_dynamic_state(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP);
+		}
+		if (support.extendedDynamicState2)
+		{
+			desc.primitiveRestartEnable = defaults.primitiveRestartEnable;
+			add_dynamic_state(VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE);
+		}
+		if (support.polygonMode)
+		{
+			desc.polygonMode = defaults.polygonMode;
+			add_dynamic_state(VK_DYNAMIC_STATE_POLYGON_MODE_EXT);
+		}
+		if (support.colorBlend)
+		{
+			desc.colorBlend = defaults.colorBlend;
+			add_dynamic_state(VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT);
+			add_dynamic_state(VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT);
+			add_dynamic_state(VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT);
+		}
+		// ǉԂŃnbVςȂ悤ɂ
+		std::sort(desc.dynamicStates.begin(), desc.dynamicStates.end());
+		return desc;
+	}
+
+	static VkPrimitiveTopology getTopologyClass(VkPrimitiveTopology topology)
+	{
+		switch (topology)
+		{
+		case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
+			return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+		case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+		case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+		case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+		case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+			return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+		case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+			return VK_PRIMITIVE_TOPOLOGY_PATCH_LIST;
+		default:
+			return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		}
+	}
+};
+//---------------------------------------------------------------------------
+struct GraphicsPipelineDescHasher
+{
+	size_t operator()(const GraphicsPipelineDesc& desc) const { return static_cast<size_t>(desc.hash()); }
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "PresentLatency.h"
+#include <algorithm>
+#include <cstdio>
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+PresentLatencyTracker::~PresentLatencyTracker()
+{
+    stop();
+}
+//---------------------------------------------------------------------------
+void PresentLatencyTracker::initialize(GfxDevice* gfx_device)
+{
+    mDevice = gfx_device->getVkDevice();
+    mIsPresentWaitEnabled = gfx_device->isPresentWaitEnabled();
+    mSamples.reserve(sSampleWindow);
+
+    const std::vector<double> bounds = { 5.0, 10.0, 16.7, 25.0, 33.3, 50.0, 75.0, 100.0, 150.0, 250.0 };
+    auto& metrics = getMetricsRegistry();
+    mInputToPhotonMetric = metrics->histogram("present_input_to_photon_ms", "Input sample to display latency in milliseconds", bounds);
+    mSubmitToPhotonMetric = metrics->histogram("present_submit_to_photon_ms", "Queue submit to display latency in milliseconds", bounds);
+    mMeasuredMetric = metrics->gauge("present_latency_measured", "1 if latency comes from VK_KHR_present_wait, 0 if estimated");
+    mMeasuredMetric->set(mIsPresentWaitEnabled ? 1.0 : 0.0);
+
+    fprintf(stderr, "[PresentLatency] %s\n", mIsPresentWaitEnabled
+        ? "using VK_KHR_present_wait"
+        : "present_wait not supported, using fence based estimate");
+}
+//---------------------------------------------------------------------------
+void PresentLatencyTracker::start(VkSwapchainKHR swapchain)
+{
+    stop();
+    mSwapchain = swapchain;
+    for (auto& frame : mFrames)
+    {
+        frame.isPending = false;
+    }
+    if (!mIsPresentWaitEnabled)
+    {
+        return;
+    }
+    mIsRunning = true;
+    mWatchThread = std::thread([this]() { watchThread_(); });
+}
+//---------------------------------------------------------------------------
+void PresentLatencyTracker::stop()
+{
+    if (mWatchThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mPendingMutex);
+            mIsRunning = false;
+        }
+        mPendingCondition.notify_all();
+        mWatchThread.join();
+    }
+
+    // \mFłȂ͎̂̂Ă
+    std::lock_guard<std::mutex> lock(mPendingMutex);
+    if (!mPendingPresents.empty())
+    {
+        std::lock_guard<std::mutex> sample_lock(mSampleMutex);
+        mDroppedCount += mPendingPresents.size();
+        mPendingPresents.clear();
+    }
+    mSwapchain = VK_NULL_HANDLE;
+}
+//---------------------------------------------------------------------------
+void PresentLatencyTracker::beginFrame(uint32_t frameIndex)
+{
+    const auto now = Clock::now();
+    auto& frame = mFrames[frameIndex];
+
+    // tH[obN: ̃Xbg̃tFXOt[̕\Ƃ݂Ȃ
+    if (!mIsPresentWaitEnabled && frame.isPending)
+    {
+        addSample_(frame, now);
+    }
+    frame = FrameRecord{
+        .inputTime = now,
+    };
+}
+//---------------------------------------------------------------------------
+void PresentLatencyTracker::onSubmit(uint32_t frameIndex)
+{
+    mFrames[frameIndex].submitTime = Clock::now();
+}
+//---------------------------------------------------------------------------
+const void* PresentLatencyTracker::preparePresent(uint32_t frameIndex)
+{
+    auto& frame = mFrames[frameIndex];
+    frame.presentId = mNextPresentId++;
+    frame.presentTime = Clock::now();
+    if (!mIsPresentWaitEnabled)
+    {
+        return nullptr;
+    }
+    mPresentIdInfo = VkPresentIdKHR{
+        .sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR,
+        .swapchainCount = 1,
+        .pPresentIds = &frame.presentId,
+    };
+    return &mPresentIdInfo;
+}
+//---------------------------------------------------------------------------
+void PresentLatencyTracker::onPresented(uint32_t frameIndex, VkResult result)
+{
+    auto& frame = mFrames[frameIndex];
+    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+    {
+        return;
+    }
+    if (!mIsPresentWaitEnabled)
+    {
+        frame.isPending = true;
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mPendingMutex);
+        mPendingPresents.push_back(frame);
+    }
+    mPendingCondition.notify_one();
+}
+//---------------------------------------------------------------------------
+void PresentLatencyTracker::watchThread_()
+{
+    // present_wait ͕ʃXbh̑ҋ@z肵 API Ȃ̂ŁApresent ƕsđ҂Ă悢
+    // ~vɉ邽ߒZԂŋ؂đҋ@
+    while (true)
+    {
+        FrameRecord record;
+        {
+            std::unique_lock<std::mutex> lock(mPendingMutex);
+            mPendingCondition.wait(lock, [this]() { return !mIsRunning || !mPendingPresents.empty(); });
+            if (!mIsRunning)
+            {
+                break;
+            }
+            record = mPendingPresents.front();
+        }
+
+        VkResult result = vkWaitForPresentKHR(mDevice, mSwapchain, record.presentId, sWaitSliceNs);
+        if (result == VK_TIMEOUT)
+        {
+            continue;
+        }
+        const auto display_time = Clock::now();
+
+        {
+            std::lock_guard<std::mutex> lock(mPendingMutex);
+            mPendingPresents.pop_front();
+        }
+        if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR)
+        {
+            addSample_(record, display_time);
+        }
+        else
+        {
+            // Xbv`FCɂȂ
+            std::lock_guard<std::mutex> lock(mSampleMutex);
+            mDroppedCount++;
+        }
+    }
+}
+//---------------------------------------------------------------------------
+void PresentLatencyTracker::addSample_(const FrameRecord& record, Clock::time_point displayTime)
+{
+    Sample sample{
+        .inputToPhotonMs = toMs_(displayTime - record.inputTime),
+        .submitToPhotonMs = toMs_(displayTime - record.submitTime),
+        .presentToPhotonMs = toMs_(displayTime - record.presentTime),
+    };
+    mInputToPhotonMetric->observe(sample.inputToPhotonMs);
+    mSubmitToPhotonMetric->observe(sample.submitToPhotonMs);
+
+    std::lock_guard<std::mutex> lock(mSampleMutex);
+    if (mSamples.size() < sSampleWindow)
+    {
+        mSamples.push_back(sample);
+    }
+    else
+    {
+        mSamples[mSampleHead] = sample;
+        mSampleHead = (mSampleHead + 1) % sSampleWindow;
+    }
+}
+//---------------------------------------------------------------------------
+PresentLatencyTracker::Stats PresentLatencyTracker::getStats() const
+{
+    std::vector<Sample> samples;
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(mSampleMutex);
+        samples = mSamples;
+        stats.droppedCount = mDroppedCount;
+    }
+    stats.isMeasured = mIsPresentWaitEnabled;
+    stats.sampleCount = static_cast<uint32_t>(samples.size());
+    if (samples.empty())
+    {
+        return stats;
+    }
+
+    std::vector<double> input_to_photon;
+    input_to_photon.reserve(samples.size());
+    double submit_sum = 0.0;
+    double present_sum = 0.0;
+    for (const auto& sample : samples)
+    {
+        input_to_photon.push_back(sample.inputToPhotonMs);
+        submit_sum += sample.submitToPhotonMs;
+        present_sum += sample.presentToPhotonMs;
+    }
+    std::sort(input_to_photon.begin(), input_to_photon.end());
+
+    double input_sum = 0.0;
+    for (double v : input_to_photon)
+    {
+        input_sum += v;
+    }
+    const double count = double(samples.size());
+    const size_t p99_index = std::min(input_to_photon.size() - 1, size_t(count * 0.99));
+    stats.avgInputToPhotonMs = input_sum / count;
+    stats.minInputToPhotonMs = input_to_photon.front();
+    stats.maxInputToPhotonMs = input_to_photon.back();
+    stats.p99InputToPhotonMs = input_to_photon[p99_index];
+    stats.avgSubmitToPhotonMs = submit_sum / count;
+    stats.avgPresentToPhotonMs = present_sum / count;
+    return stats;
+}
+//---------------------------------------------------------------------------
+void PresentLatencyTracker::drawImGui()
+{
+    const Stats stats = getStats();
+
+    ImGui::SeparatorText("Present latency");
+    ImGui::Text("Source: %s", stats.isMeasured ? "VK_KHR_present_wait" : "fence estimate");
+    if (stats.sampleCount == 0)
+    {
+        ImGui::Text("No samples yet");
+        return;
+    }
+    ImGui::Text("Input to photon: %.2f ms (min %.2f / max %.2f / p99 %.2f)",
+        stats.avgInputToPhotonMs,
+        stats.minInputToPhotonMs,
+        stats.maxInputToPhotonMs,
+        stats.p99InputToPhotonMs);
+    ImGui::Text("Submit to photon: %.2f ms", stats.avgSubmitToPhotonMs);
+    ImGui::Text("Present to photon: %.2f ms", stats.avgPresentToPhotonMs);
+    ImGui::Text("Samples: %u  Dropped: %llu", stats.sampleCount, static_cast<unsigned long long>(stats.droppedCount));
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
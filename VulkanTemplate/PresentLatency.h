@@ -0,0 +1,123 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "GfxDevice.h"
+#include "Metrics.h"
+
+//---------------------------------------------------------------------------
+/*
+ * ͂\܂ł̒x(present latency)v
+ * VK_KHR_present_wait gꍇ͊e present  ID tA
+ * ĎXbh vkWaitForPresentKHR ҂Ďۂ̕\L^
+ * gȂꍇ̓t[̃tFX\Ƃ݂ȂlɂȂ
+ */
+class PresentLatencyTracker
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr uint32_t sFrameCount = 2;
+	// v钼߂̃Tv
+	static constexpr size_t sSampleWindow = 240;
+	// ĎXbh1̑ҋ@ (~vɉł悤Z߂ɂ)
+	static constexpr uint64_t sWaitSliceNs = 10'000'000;
+
+	struct Stats
+	{
+		bool isMeasured = false;       // false ̏ꍇ͐l
+		uint32_t sampleCount = 0;
+		double avgInputToPhotonMs = 0.0;
+		double minInputToPhotonMs = 0.0;
+		double maxInputToPhotonMs = 0.0;
+		double p99InputToPhotonMs = 0.0;
+		double avgSubmitToPhotonMs = 0.0;
+		double avgPresentToPhotonMs = 0.0;
+		uint64_t droppedCount = 0;     // \mFłɔj
+	};
+
+public:
+	PresentLatencyTracker() = default;
+	~PresentLatencyTracker();
+	PresentLatencyTracker(const PresentLatencyTracker&) = delete;
+	PresentLatencyTracker& operator=(const PresentLatencyTracker&) = delete;
+
+	void initialize(GfxDevice* gfx_device);
+
+	/*
+	 * Xbv`FCɊJnAjOɒ~
+	 * ĎXbh͑Ώۂ̃Xbv`FCQƂ邽߁AjɎ~߂邱
+	 */
+	void start(VkSwapchainKHR swapchain);
+	void stop();
+
+	/*
+	 * t[̊e^C~OŌĂяo
+	 * beginFrame ̓CtCgtFX̑ҋ@ (͂TvƂĈ)
+	 */
+	void beginFrame(uint32_t frameIndex);
+	void onSubmit(uint32_t frameIndex);
+	/*
+	 * present OɌĂяoAVkPresentInfoKHR  pNext Ɍq\̂Ԃ
+	 * present_wait gȂꍇ nullptr
+	 */
+	const void* preparePresent(uint32_t frameIndex);
+	void onPresented(uint32_t frameIndex, VkResult result);
+
+	Stats getStats() const;
+	void drawImGui();
+
+	inline bool isPresentWaitEnabled() const { return mIsPresentWaitEnabled; }
+
+private:
+	struct FrameRecord
+	{
+		uint64_t presentId = 0;
+		Clock::time_point inputTime{};
+		Clock::time_point submitTime{};
+		Clock::time_point presentTime{};
+		bool isPending = false;
+	};
+	struct Sample
+	{
+		double inputToPhotonMs;
+		double submitToPhotonMs;
+		double presentToPhotonMs;
+	};
+
+	void watchThread_();
+	void addSample_(const FrameRecord& record, Clock::time_point displayTime);
+
+	static double toMs_(Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); }
+
+private:
+	VkDevice mDevice = VK_NULL_HANDLE;
+	VkSwapchainKHR mSwapchain = VK_NULL_HANDLE;
+	bool mIsPresentWaitEnabled = false;
+
+	std::array<FrameRecord, sFrameCount> mFrames;
+	uint64_t mNextPresentId = 1;
+	VkPresentIdKHR mPresentIdInfo{};
+
+	// ĎXbh\҂Ă present (Â)
+	std::deque<FrameRecord> mPendingPresents;
+	std::mutex mPendingMutex;
+	std::condition_variable mPendingCondition;
+	std::thread mWatchThread;
+	std::atomic<bool> mIsRunning = false;
+
+	mutable std::mutex mSampleMutex;
+	std::vector<Sample> mSamples;
+	size_t mSampleHead = 0;
+	uint64_t mDroppedCount = 0;
+
+	MetricHistogram* mInputToPhotonMetric = nullptr;
+	MetricHistogram* mSubmitToPhotonMetric = nullptr;
+	MetricGauge* mMeasuredMetric = nullptr;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
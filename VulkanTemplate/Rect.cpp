@@ -1,6 +1,30 @@
 #include "Rect.h"
 #include <stdexcept>
 #include <stb_image.h>
+#include "VkObjectTracker.h"
+#include "Metrics.h"
+#include <chrono>
+
+//---------------------------------------------------------------------------
+// Xe[WOobt@̓]ʂƏvԂgNXɋL^
+static void recordUpload(VkDeviceSize bytes, std::chrono::steady_clock::time_point startTime)
+{
+	auto& metrics = getMetricsRegistry();
+	static MetricCounter* upload_bytes = metrics->counter("upload_bytes_total", "Bytes uploaded to device local memory");
+	static MetricCounter* upload_time = metrics->counter("upload_time_us_total", "Time spent in blocking uploads in microseconds");
+	upload_bytes->add(bytes);
+	upload_time->add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count()));
+}
+
+//---------------------------------------------------------------------------
+// _vœǂވk_ (VertexStreamLayout::Compressed)
+struct CompressedVertex
+{
+	uint32_t position;  // x x2
+	uint32_t color;     // RGBA8
+	uint32_t texcoord;  // x x2
+};
+static_assert(sizeof(CompressedVertex) == 12, "CompressedVertex must be tightly packed");
 
 //---------------------------------------------------------------------------
 void Rect::initialize(GfxDevice* gfx_device)
@@ -8,41 +32,94 @@ void Rect::initialize(GfxDevice* gfx_device)
 	createTextureImage_(gfx_device);
 	createTextureImageView_(gfx_device);
 	createTextureSampler_(gfx_device);
-	createVertexBuffer_(gfx_device);
-	createIndexBuffer_(gfx_device);
+	// 쐬eNX`̓oChX̔zɓo^ĔԍŎQƂ
+	auto& bindless = getBindlessDescriptors();
+	if (bindless->isEnabled())
+	{
+		mTextureInfo.textureIndex = bindless->registerTexture(mTextureInfo.imageView);
+		mTextureInfo.samplerIndex = bindless->registerSampler(mTextureInfo.sampler);
+	}
+	createMesh_();
+	if (getGeometryPool()->isVertexAddressEnabled())
+	{
+		createPulledMeshes_();
+	}
 }
 //---------------------------------------------------------------------------
 void Rect::render(VkCommandBuffer commandBuffer)
 {
-	VkDeviceSize offsets[] = { 0 };
-	vkCmdBindVertexBuffers(commandBuffer, 0, 1, &mVertexBufferInfo.buffer, offsets);
-	vkCmdBindIndexBuffer(commandBuffer, mIndexBufferInfo.buffer, 0, VK_INDEX_TYPE_UINT16);
+	// lߒňʒuς邱Ƃ̂ŁA`̓xɈ蒼
+	const GeometryDrawArgs args = getGeometryPool()->getDrawArgs(mMeshInfo.mesh);
+	vkCmdDrawIndexed(commandBuffer, args.indexCount, 1, args.firstIndex, args.vertexOffset, 0);
+}
+//---------------------------------------------------------------------------
+void Rect::renderPulled(VkCommandBuffer commandBuffer, VkPipelineLayout layout, VertexStreamLayout streamLayout)
+{
+	auto& pool = getGeometryPool();
+	const GeometryPool::MeshHandle mesh = mMeshInfo.pulledMeshes[size_t(streamLayout)];
+	// AhX̓bV̐擪ŵŁA_̔ԍ̓bV̒ł̔ԍɂȂ
+	const VkDeviceAddress address = pool->getVertexAddress(mesh);
+	const VkDeviceSize vertex_count = mMeshInfo.vertices.size();
+
+	VertexPullConstants constants{ .draw = getDrawConstants() };
+	switch (streamLayout)
+	{
+	case VertexStreamLayout::Interleaved:
+		constants.position = { address + offsetof(Vertex, position), sizeof(Vertex), VertexStreamFormat::Float2 };
+		constants.color = { address + offsetof(Vertex, color), sizeof(Vertex), VertexStreamFormat::Float3 };
+		constants.texcoord = { address + offsetof(Vertex, texcoord), sizeof(Vertex), VertexStreamFormat::Float2 };
+		break;
+	case VertexStreamLayout::Deinterleaved:
+		constants.position = { address, sizeof(glm::vec2), VertexStreamFormat::Float2 };
+		constants.color = { address + vertex_count * sizeof(glm::vec2), sizeof(glm::vec3), VertexStreamFormat::Float3 };
+		constants.texcoord = { address + vertex_count * (sizeof(glm::vec2) + sizeof(glm::vec3)), sizeof(glm::vec2), VertexStreamFormat::Float2 };
+		break;
+	default:
+		constants.position = { address + offsetof(CompressedVertex, position), sizeof(CompressedVertex), VertexStreamFormat::Half2 };
+		constants.color = { address + offsetof(CompressedVertex, color), sizeof(CompressedVertex), VertexStreamFormat::Unorm8x4 };
+		constants.texcoord = { address + offsetof(CompressedVertex, texcoord), sizeof(CompressedVertex), VertexStreamFormat::Half2 };
+		break;
+	}
+	vkCmdPushConstants(commandBuffer, layout, BindlessDescriptors::getPushConstantRange().stageFlags, 0, sizeof(constants), &constants);
 
-	vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(mIndexBufferInfo.indices.size()), 1, 0, 0, 0);
+	const GeometryDrawArgs args = pool->getDrawArgs(mesh);
+	vkCmdDrawIndexed(commandBuffer, args.indexCount, 1, args.firstIndex, 0, 0);
 }
 //---------------------------------------------------------------------------
 void Rect::destroy(GfxDevice* gfx_device)
 {
 	auto device = gfx_device->getVkDevice();
+	auto& tracker = getVkObjectTracker();
+
+	auto& bindless = getBindlessDescriptors();
+	if (bindless->isEnabled())
+	{
+		bindless->releaseTexture(mTextureInfo.textureIndex);
+		bindless->releaseSampler(mTextureInfo.samplerIndex);
+	}
+	mTextureInfo.textureIndex = BindlessDescriptors::sInvalidIndex;
+	mTextureInfo.samplerIndex = BindlessDescriptors::sInvalidIndex;
 
 	vkDestroyImage(device, mTextureInfo.image, nullptr);
 	vkFreeMemory(device, mTextureInfo.memory, nullptr);
 	vkDestroyImageView(device, mTextureInfo.imageView, nullptr);
 	vkDestroySampler(device, mTextureInfo.sampler, nullptr);
+	tracker->onDestroy(mTextureInfo.image, VK_OBJECT_TYPE_IMAGE);
+	tracker->onDestroy(mTextureInfo.memory, VK_OBJECT_TYPE_DEVICE_MEMORY);
+	tracker->onDestroy(mTextureInfo.imageView, VK_OBJECT_TYPE_IMAGE_VIEW);
+	tracker->onDestroy(mTextureInfo.sampler, VK_OBJECT_TYPE_SAMPLER);
 	mTextureInfo.image = VK_NULL_HANDLE;
 	mTextureInfo.memory = VK_NULL_HANDLE;
 	mTextureInfo.imageView = VK_NULL_HANDLE;
 	mTextureInfo.sampler = VK_NULL_HANDLE;
 
-	vkDestroyBuffer(device, mIndexBufferInfo.buffer, nullptr);
-	vkFreeMemory(device, mIndexBufferInfo.memory, nullptr);
-	mIndexBufferInfo.buffer = VK_NULL_HANDLE;
-	mIndexBufferInfo.memory = VK_NULL_HANDLE;
-
-	vkDestroyBuffer(device, mVertexBufferInfo.buffer, nullptr);
-	vkFreeMemory(device, mVertexBufferInfo.memory, nullptr);
-	mVertexBufferInfo.buffer = VK_NULL_HANDLE;
-	mVertexBufferInfo.memory = VK_NULL_HANDLE;
+	auto& pool = getGeometryPool();
+	// Interleaved  mesh ƓȂ̂œdɉȂ
+	pool->free(mMeshInfo.pulledMeshes[size_t(VertexStreamLayout::Deinterleaved)]);
+	pool->free(mMeshInfo.pulledMeshes[size_t(VertexStreamLayout::Compressed)]);
+	pool->free(mMeshInfo.mesh);
+	mMeshInfo.mesh = GeometryPool::sInvalidMesh;
+	mMeshInfo.pulledMeshes.fill(GeometryPool::sInvalidMesh);
 }
 //---------------------------------------------------------------------------
 void Rect::createTextureImage_(GfxDevice* gfx_device)
@@ -56,8 +133,7 @@ void Rect::createTextureImage_(GfxDevice* gfx_device)
 
 	VkBuffer staging_buffer;
 	VkDeviceMemory staging_buffer_memory;
-	createBuffer_(
-		gfx_device,
+	gfx_device->createBuffer(
 		image_size,
 		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
@@ -87,6 +163,8 @@ void Rect::createTextureImage_(GfxDevice* gfx_device)
 		mTextureInfo.image,
 		static_cast<uint32_t>(tex_width),
 		static_cast<uint32_t>(tex_height));
+
+	gfx_device->destroyBuffer(staging_buffer, staging_buffer_memory);
 }
 //---------------------------------------------------------------------------
 void Rect::createImage_(GfxDevice* gfx_device, uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory)
@@ -112,6 +190,7 @@ void Rect::createImage_(GfxDevice* gfx_device, uint32_t width, uint32_t height,
 	if (vkCreateImage(gfx_device->getVkDevice(), &image_info, nullptr, &image) != VK_SUCCESS) {
 		throw std::runtime_error("failed to create image!");
 	}
+	getVkObjectTracker()->onCreate(image, VK_OBJECT_TYPE_IMAGE);
 
 	VkMemoryRequirements requirements;
 	vkGetImageMemoryRequirements(gfx_device->getVkDevice(), image, &requirements);
@@ -125,12 +204,14 @@ void Rect::createImage_(GfxDevice* gfx_device, uint32_t width, uint32_t height,
 	if (vkAllocateMemory(gfx_device->getVkDevice(), &allocate_info, nullptr, &imageMemory) != VK_SUCCESS) {
 		throw std::runtime_error("failed to allocate image memory!");
 	}
+	getVkObjectTracker()->onCreate(imageMemory, VK_OBJECT_TYPE_DEVICE_MEMORY, allocate_info.allocationSize);
 
 	vkBindImageMemory(gfx_device->getVkDevice(), image, imageMemory, 0);
 }
 //---------------------------------------------------------------------------
 void Rect::copyBufferToImage_(GfxDevice* gfx_device, VkBuffer buffer, VkImage image, uint32_t width, uint32_t height)
 {
+	const auto start_time = std::chrono::steady_clock::now();
 	VkCommandBuffer command_buffer = beginSingleTimeCommands_(gfx_device);
 
 	VkBufferImageCopy copy_region{
@@ -160,6 +241,8 @@ void Rect::copyBufferToImage_(GfxDevice* gfx_device, VkBuffer buffer, VkImage im
 		&copy_region);
 
 	endSingleTimeCommands_(gfx_device, command_buffer);
+	// RGBA8 ̃eNX`݈̂Ă
+	recordUpload(VkDeviceSize(width) * height * 4, start_time);
 }
 //---------------------------------------------------------------------------
 void Rect::createTextureImageView_(GfxDevice* gfx_device)
@@ -181,6 +264,7 @@ void Rect::createTextureImageView_(GfxDevice* gfx_device)
 	if (vkCreateImageView(gfx_device->getVkDevice(), &view_info, nullptr, &mTextureInfo.imageView) != VK_SUCCESS) {
 		throw std::runtime_error("failed to create texture image view!");
 	}
+	getVkObjectTracker()->onCreate(mTextureInfo.imageView, VK_OBJECT_TYPE_IMAGE_VIEW);
 }
 //---------------------------------------------------------------------------
 void Rect::createTextureSampler_(GfxDevice* gfx_device)
@@ -205,6 +289,7 @@ void Rect::createTextureSampler_(GfxDevice* gfx_device)
 	};
 
 	vkCreateSampler(gfx_device->getVkDevice(), &sampler_info, nullptr, &mTextureInfo.sampler);
+	getVkObjectTracker()->onCreate(mTextureInfo.sampler, VK_OBJECT_TYPE_SAMPLER);
 }
 //---------------------------------------------------------------------------
 void Rect::transitionImageLayout_(GfxDevice* gfx_device, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout)
@@ -257,106 +342,48 @@ void Rect::transitionImageLayout_(GfxDevice* gfx_device, VkImage image, VkFormat
 	endSingleTimeCommands_(gfx_device, commandBuffer);
 }
 //---------------------------------------------------------------------------
-void Rect::createVertexBuffer_(GfxDevice* gfx_device)
+void Rect::createMesh_()
 {
-	auto device = gfx_device->getVkDevice();
-
-	VkDeviceSize buffer_size = sizeof(mVertexBufferInfo.vertices[0]) * mVertexBufferInfo.vertices.size();
-
-	createBuffer_(
-		gfx_device,
-		buffer_size,
-		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-		mVertexBufferInfo.buffer,
-		mVertexBufferInfo.memory);
-
-	void* data;
-	vkMapMemory(device, mVertexBufferInfo.memory, 0, buffer_size, 0, &data);
-	memcpy(data, mVertexBufferInfo.vertices.data(), buffer_size);
-	vkUnmapMemory(device, mVertexBufferInfo.memory);
+	mMeshInfo.mesh = getGeometryPool()->allocate(
+		mMeshInfo.vertices.data(),
+		static_cast<uint32_t>(mMeshInfo.vertices.size()),
+		sizeof(Vertex),
+		std::span<const uint16_t>(mMeshInfo.indices));
 }
 //---------------------------------------------------------------------------
-void Rect::createIndexBuffer_(GfxDevice* gfx_device)
+void Rect::createPulledMeshes_()
 {
-	auto device = gfx_device->getVkDevice();
-
-	VkDeviceSize buffer_size = sizeof(mIndexBufferInfo.indices[0]) * mIndexBufferInfo.indices.size();
-
-	VkBuffer staging_buffer;
-	VkDeviceMemory staging_buffer_memory;
-	createBuffer_(
-		gfx_device,
-		buffer_size,
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-		staging_buffer,
-		staging_buffer_memory);
-
-	void* data;
-	vkMapMemory(device, staging_buffer_memory, 0, buffer_size, 0, &data);
-	memcpy(data, mIndexBufferInfo.indices.data(), buffer_size);
-	vkUnmapMemory(device, staging_buffer_memory);
-
-	createBuffer_(
-		gfx_device,
-		buffer_size,
-		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-		mIndexBufferInfo.buffer,
-		mIndexBufferInfo.memory);
-
-	copyBuffer_(gfx_device, staging_buffer, mIndexBufferInfo.buffer, buffer_size);
-
-	vkDestroyBuffer(device, staging_buffer, nullptr);
-	vkFreeMemory(device, staging_buffer_memory, nullptr);
-}
-//---------------------------------------------------------------------------
-void Rect::createBuffer_(GfxDevice* gfx_device, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory)
-{
-	auto device = gfx_device->getVkDevice();
-	VkBufferCreateInfo buffer_create_info{
-		.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-		.size = size,
-		.usage = usage,
-		.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-	};
-	if (vkCreateBuffer(device, &buffer_create_info, nullptr, &buffer) != VK_SUCCESS)
+	auto& pool = getGeometryPool();
+	const std::span<const uint16_t> indices(mMeshInfo.indices);
+	const std::vector<Vertex>& vertices = mMeshInfo.vertices;
+	const uint32_t vertex_count = static_cast<uint32_t>(vertices.size());
+
+	// SĂ̒_̈ʒuASĂ̒_̐FASĂ̒_̃eNX`W̏ɕׂ
+	// 1_̑傫 Vertex ƓȂ̂ŁA_̑傫 sizeof(Vertex) Ƃēo^
+	std::vector<uint8_t> deinterleaved(vertices.size() * sizeof(Vertex));
+	uint8_t* positions = deinterleaved.data();
+	uint8_t* colors = positions + vertices.size() * sizeof(glm::vec2);
+	uint8_t* texcoords = colors + vertices.size() * sizeof(glm::vec3);
+	for (size_t i = 0; i < vertices.size(); ++i)
 	{
-		throw std::runtime_error("failed to create vertex buffer!");
+		memcpy(positions + i * sizeof(glm::vec2), &vertices[i].position, sizeof(glm::vec2));
+		memcpy(colors + i * sizeof(glm::vec3), &vertices[i].color, sizeof(glm::vec3));
+		memcpy(texcoords + i * sizeof(glm::vec2), &vertices[i].texcoord, sizeof(glm::vec2));
 	}
-	// 蓖
+
+	std::vector<CompressedVertex> compressed(vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i)
 	{
-		VkMemoryRequirements requirements;
-		vkGetBufferMemoryRequirements(device, buffer, &requirements);
-		VkMemoryAllocateInfo allocate_info{
-			.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-			.allocationSize = requirements.size,
-			.memoryTypeIndex = gfx_device->getMemoryTypeIndex(requirements, properties),
+		compressed[i] = CompressedVertex{
+			.position = glm::packHalf2x16(vertices[i].position),
+			.color = glm::packUnorm4x8(glm::vec4(vertices[i].color, 1.0f)),
+			.texcoord = glm::packHalf2x16(vertices[i].texcoord),
 		};
-		if (vkAllocateMemory(device, &allocate_info, nullptr, &bufferMemory) != VK_SUCCESS) {
-			throw std::runtime_error("failed to allocate buffer memory!");
-		}
-		if (vkBindBufferMemory(device, buffer, bufferMemory, 0) != VK_SUCCESS) {
-			throw std::runtime_error("failed to allocate buffer memory!");
-		}
 	}
-}
-//---------------------------------------------------------------------------
-void Rect::copyBuffer_(GfxDevice* gfx_device, VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
-{
-	auto device = gfx_device->getVkDevice();
-
-	VkCommandBuffer command_buffer = beginSingleTimeCommands_(gfx_device);
 
-	VkBufferCopy copy_region{
-		.srcOffset = 0,
-		.dstOffset = 0,
-		.size = size,
-	};
-	vkCmdCopyBuffer(command_buffer, srcBuffer, dstBuffer, 1, &copy_region);
-
-	endSingleTimeCommands_(gfx_device, command_buffer);
+	mMeshInfo.pulledMeshes[size_t(VertexStreamLayout::Interleaved)] = mMeshInfo.mesh;
+	mMeshInfo.pulledMeshes[size_t(VertexStreamLayout::Deinterleaved)] = pool->allocate(deinterleaved.data(), vertex_count, sizeof(Vertex), indices);
+	mMeshInfo.pulledMeshes[size_t(VertexStreamLayout::Compressed)] = pool->allocate(compressed.data(), vertex_count, sizeof(CompressedVertex), indices);
 }
 //---------------------------------------------------------------------------
 VkCommandBuffer Rect::beginSingleTimeCommands_(GfxDevice* gfx_device)
@@ -5,6 +5,8 @@
 #include "glm/glm.hpp"
 #include <Volk/volk.h>
 #include "GfxDevice.h"
+#include "BindlessDescriptors.h"
+#include "GeometryPool.h"
 
 //---------------------------------------------------------------------------
 struct Vertex
@@ -16,7 +18,7 @@ struct Vertex
     static VkVertexInputBindingDescription getBindingDescription()
     {
         VkVertexInputBindingDescription bindingDescription{};
-        bindingDescription.binding = 1;
+        bindingDescription.binding = 0;
         bindingDescription.stride = sizeof(Vertex);
         bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
         return bindingDescription;
@@ -41,6 +43,17 @@ struct Vertex
     }
 };
 //---------------------------------------------------------------------------
+/*
+ * _vŕ`悷ꍇ̒_̒u (ǂpCvCŕ`)
+ */
+enum class VertexStreamLayout
+{
+	Interleaved,    // Vertex ̂܂ܕׂ (_obt@Ƌp)
+	Deinterleaved,  // ʒuEFEeNX`Wꂼʂ̔zɕׂ
+	Compressed,     // ʒuƃeNX`W͔xAF RGBA8 ɋl߂ (1_ 12 oCg)
+	Count,
+};
+//---------------------------------------------------------------------------
 class Rect
 {
 public:
@@ -49,15 +62,35 @@ public:
 
     void initialize(GfxDevice* gfx_device);
 
+	/*
+	 * GeometryPool ̃obt@͌ĂяoŌĂ
+	 */
 	void render(VkCommandBuffer commandBuffer);
+	/*
+	 * _VF[_[AhXœǂރpCvC (res/vertex_pull.vert) ŕ`悷
+	 * vbV萔 VertexPullConstants Őݒ肷
+	 * GeometryPool ̃CfbNXobt@͌ĂяoŌĂ
+	 */
+	void renderPulled(VkCommandBuffer commandBuffer, VkPipelineLayout layout, VertexStreamLayout streamLayout);
+	// _v̒u GeometryPool ɗpӂ (obt@̃foCXAhXgꍇ̂)
+	inline bool isVertexPullingSupported() const { return mMeshInfo.pulledMeshes[0] != GeometryPool::sInvalidMesh; }
+
+	/*
+	 * oChXŕ`悷ꍇɃvbV萔œneNX`ƃTv[̔ԍ
+	 */
+	inline BindlessDrawConstants getDrawConstants() const {
+		return BindlessDrawConstants{ .textureIndex = mTextureInfo.textureIndex, .samplerIndex = mTextureInfo.samplerIndex };
+	}
+	inline VkImageView getTextureImageView() const { return mTextureInfo.imageView; }
+	inline VkSampler getTextureSampler() const { return mTextureInfo.sampler; }
 
 	void destroy(GfxDevice* gfx_device);
 
 private:
-    void createVertexBuffer_(GfxDevice* gfx_device);
-    void createIndexBuffer_(GfxDevice* gfx_device);
-	void createBuffer_(GfxDevice* gfx_device, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);
-	void copyBuffer_(GfxDevice* gfx_device, VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
+	// _ƃCfbNX GeometryPool ɒu
+	void createMesh_();
+	// _vpɒuς_ GeometryPool ɒu
+	void createPulledMeshes_();
 
     // 摜̓ǂݍ
 	void createTextureImage_(GfxDevice* gfx_device);
@@ -71,7 +104,7 @@ private:
 	VkCommandBuffer beginSingleTimeCommands_(GfxDevice* gfx_device);
 	void endSingleTimeCommands_(GfxDevice* gfx_device, VkCommandBuffer commandBuffer);
 
-    struct VertexBufferInfo
+    struct MeshInfo
     {
         const std::vector<Vertex> vertices = {
     {{-0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
@@ -79,16 +112,12 @@ private:
     {{0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},
     {{-0.5f, 0.5f}, {1.0f, 1.0f, 1.0f}, {1.0f, 1.0f}}
         };
-        VkBuffer buffer = nullptr;
-        VkDeviceMemory memory = nullptr;
-    } mVertexBufferInfo;
-
-    struct IndexBufferInfo
-    {
         const std::vector<uint16_t> indices = { 0, 1, 2, 2, 3, 0 };
-        VkBuffer buffer = nullptr;
-        VkDeviceMemory memory = nullptr;
-    } mIndexBufferInfo;
+        GeometryPool::MeshHandle mesh = GeometryPool::sInvalidMesh;
+        // VertexStreamLayout ̃bV (Interleaved  mesh Ɠ)
+        std::array<GeometryPool::MeshHandle, size_t(VertexStreamLayout::Count)> pulledMeshes = {
+            GeometryPool::sInvalidMesh, GeometryPool::sInvalidMesh, GeometryPool::sInvalidMesh };
+    } mMeshInfo;
 
     struct TextureInfo
     {
@@ -96,6 +125,9 @@ private:
         VkDeviceMemory memory = nullptr;
         VkImageView imageView = nullptr;
         VkSampler sampler = nullptr;
+        // oChX̔zł̔ԍ (쐬ɓo^)
+        uint32_t textureIndex = BindlessDescriptors::sInvalidIndex;
+        uint32_t samplerIndex = BindlessDescriptors::sInvalidIndex;
 	} mTextureInfo;
 };
 //---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include "RectBatch.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "OverdrawView.h"
+#include "VkObjectTracker.h"
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+// Llp`̒_ (res/rect_batch.vert  inCorner, inTexCoord)
+struct CornerVertex
+{
+    glm::vec2 corner;
+    glm::vec2 texcoord;
+};
+static const std::array<CornerVertex, 4> sQuadVertices = { {
+    { { -0.5f, -0.5f }, { 0.0f, 0.0f } },
+    { { 0.5f, -0.5f }, { 1.0f, 0.0f } },
+    { { 0.5f, 0.5f }, { 1.0f, 1.0f } },
+    { { -0.5f, 0.5f }, { 0.0f, 1.0f } },
+} };
+static const std::array<uint16_t, 6> sQuadIndices = { 0, 1, 2, 2, 3, 0 };
+//---------------------------------------------------------------------------
+void RectBatch::initialize(GfxDevice* gfx_device, uint32_t frameCount)
+{
+    mGfxDevice = gfx_device;
+    createMesh_();
+    mFrames.assign(frameCount, FrameContext{});
+    for (auto& frame : mFrames)
+    {
+        reserveInstances_(frame, sInitialCapacity);
+    }
+    mFrameIndex = 0;
+    mStats = Stats{};
+}
+//---------------------------------------------------------------------------
+void RectBatch::shutdown()
+{
+    if (mGfxDevice == nullptr)
+    {
+        return;
+    }
+    for (auto& frame : mFrames)
+    {
+        destroyInstances_(frame);
+    }
+    mFrames.clear();
+    mBuckets.clear();
+    mGfxDevice->destroyBuffer(mVertexBuffer, mVertexMemory);
+    mGfxDevice->destroyBuffer(mIndexBuffer, mIndexMemory);
+    mGfxDevice = nullptr;
+}
+//---------------------------------------------------------------------------
+uint32_t RectBatch::addPipeline(const GraphicsPipelineDesc& base, VkPipelineLayout overdrawLayout)
+{
+    GraphicsPipelineDesc desc = base;
+    desc.vertexShader = "res/rect_batch.vert.spv";
+    desc.fragmentShader = "res/rect_batch.frag.spv";
+    desc.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    // binding 0: L̎lp`Abinding 1: `
+    desc.vertexBindings = {
+        VkVertexInputBindingDescription{ .binding = 0, .stride = sizeof(CornerVertex), .inputRate = VK_VERTEX_INPUT_RATE_VERTEX },
+        VkVertexInputBindingDescription{ .binding = 1, .stride = sizeof(RectInstance), .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE },
+    };
+    desc.vertexAttributes = {
+        VkVertexInputAttributeDescription{ .location = 0, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT, .offset = offsetof(CornerVertex, corner) },
+        VkVertexInputAttributeDescription{ .location = 1, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT, .offset = offsetof(CornerVertex, texcoord) },
+        // ʒuƑ傫ׂ͗荇Ă̂ vec4 1œǂ
+        VkVertexInputAttributeDescription{ .location = 2, .binding = 1, .format = VK_FORMAT_R32G32B32A32_SFLOAT, .offset = offsetof(RectInstance, position) },
+        VkVertexInputAttributeDescription{ .location = 3, .binding = 1, .format = VK_FORMAT_R32_SFLOAT, .offset = offsetof(RectInstance, rotation) },
+        VkVertexInputAttributeDescription{ .location = 4, .binding = 1, .format = VK_FORMAT_R8G8B8A8_UNORM, .offset = offsetof(RectInstance, color) },
+        VkVertexInputAttributeDescription{ .location = 5, .binding = 1, .format = VK_FORMAT_R32G32_UINT, .offset = offsetof(RectInstance, textureIndex) },
+    };
+    if (desc.debugName.empty())
+    {
+        desc.debugName = "RectBatchPipeline" + std::to_string(mBuckets.size());
+    }
+
+    Bucket bucket;
+    if (overdrawLayout != VK_NULL_HANDLE)
+    {
+        bucket.overdrawDesc = OverdrawView::makePipelineDesc(desc, overdrawLayout);
+        bucket.overdrawPipeline = getPipelineManager()->requestPipeline(bucket.overdrawDesc);
+    }
+    bucket.pipeline = getPipelineManager()->requestPipeline(desc);
+    bucket.desc = std::move(desc);
+    mBuckets.push_back(std::move(bucket));
+    return static_cast<uint32_t>(mBuckets.size() - 1);
+}
+//---------------------------------------------------------------------------
+void RectBatch::beginFrame(uint32_t frameIndex)
+{
+    if (frameIndex >= mFrames.size())
+    {
+        return;
+    }
+    mFrameIndex = frameIndex;
+    // z̗eʂ͎cĂÃt[ŊmۂȂ悤ɂ
+    for (auto& bucket : mBuckets)
+    {
+        bucket.instances.clear();
+    }
+}
+//---------------------------------------------------------------------------
+void RectBatch::add(uint32_t pipeline, const RectInstance& instance)
+{
+    mBuckets[pipeline].instances.push_back(instance);
+}
+//---------------------------------------------------------------------------
+void RectBatch::record(VkCommandBuffer commandBuffer, DynamicStateCache& dynamicState, VkExtent2D extent, bool isOverdraw)
+{
+    const auto upload_start = std::chrono::steady_clock::now();
+    FrameContext& frame = mFrames[mFrameIndex];
+
+    uint32_t total_count = 0;
+    for (const auto& bucket : mBuckets)
+    {
+        total_count += static_cast<uint32_t>(bucket.instances.size());
+    }
+    reserveInstances_(frame, total_count);
+
+    // pCvCɘAĕׂ (` firstInstance Ŕ͈͂w肷)
+    uint32_t offset = 0;
+    for (const auto& bucket : mBuckets)
+    {
+        if (!bucket.instances.empty())
+        {
+            memcpy(frame.mapped + offset, bucket.instances.data(), bucket.instances.size() * sizeof(RectInstance));
+            offset += static_cast<uint32_t>(bucket.instances.size());
+        }
+    }
+    const auto record_start = std::chrono::steady_clock::now();
+
+    mStats.instanceCount = 0;
+    mStats.drawCount = 0;
+    if (total_count > 0)
+    {
+        const VkBuffer vertex_buffers[] = { mVertexBuffer, frame.buffer };
+        const VkDeviceSize offsets[] = { 0, 0 };
+        vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertex_buffers, offsets);
+        vkCmdBindIndexBuffer(commandBuffer, mIndexBuffer, 0, VK_INDEX_TYPE_UINT16);
+
+        uint32_t first_instance = 0;
+        for (const auto& bucket : mBuckets)
+        {
+            const uint32_t instance_count = static_cast<uint32_t>(bucket.instances.size());
+            VkPipeline pipeline = isOverdraw ? bucket.overdrawPipeline.get() : bucket.pipeline.get();
+            if (instance_count > 0 && pipeline != VK_NULL_HANDLE)
+            {
+                dynamicState.bindPipeline(pipeline);
+                dynamicState.setPipelineState(isOverdraw ? bucket.overdrawDesc : bucket.desc, extent);
+                vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(sQuadIndices.size()), instance_count, 0, 0, first_instance);
+                mStats.instanceCount += instance_count;
+                mStats.drawCount++;
+            }
+            first_instance += instance_count;
+        }
+    }
+
+    const auto record_end = std::chrono::steady_clock::now();
+    mStats.capacity = frame.capacity;
+    mStats.uploadUs = std::chrono::duration<double, std::micro>(record_start - upload_start).count();
+    mStats.recordUs = std::chrono::duration<double, std::micro>(record_end - record_start).count();
+}
+//---------------------------------------------------------------------------
+uint32_t RectBatch::packColor(const glm::vec4& color)
+{
+    const glm::vec4 clamped = glm::clamp(color, glm::vec4(0.0f), glm::vec4(1.0f)) * 255.0f + 0.5f;
+    return uint32_t(clamped.r) | (uint32_t(clamped.g) << 8) | (uint32_t(clamped.b) << 16) | (uint32_t(clamped.a) << 24);
+}
+//---------------------------------------------------------------------------
+void RectBatch::createMesh_()
+{
+    // Ȃ̂ŁAzXg猩郁ɒڒu
+    auto device = mGfxDevice->getVkDevice();
+    void* data = nullptr;
+
+    mGfxDevice->createBuffer(sizeof(sQuadVertices), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mVertexBuffer, mVertexMemory);
+    mGfxDevice->setObjectName(uint64_t(mVertexBuffer), "RectBatchQuadVertices", VK_OBJECT_TYPE_BUFFER);
+    vkMapMemory(device, mVertexMemory, 0, sizeof(sQuadVertices), 0, &data);
+    memcpy(data, sQuadVertices.data(), sizeof(sQuadVertices));
+    vkUnmapMemory(device, mVertexMemory);
+
+    mGfxDevice->createBuffer(sizeof(sQuadIndices), VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mIndexBuffer, mIndexMemory);
+    mGfxDevice->setObjectName(uint64_t(mIndexBuffer), "RectBatchQuadIndices", VK_OBJECT_TYPE_BUFFER);
+    vkMapMemory(device, mIndexMemory, 0, sizeof(sQuadIndices), 0, &data);
+    memcpy(data, sQuadIndices.data(), sizeof(sQuadIndices));
+    vkUnmapMemory(device, mIndexMemory);
+}
+//---------------------------------------------------------------------------
+void RectBatch::reserveInstances_(FrameContext& frame, uint32_t count)
+{
+    if (count <= frame.capacity)
+    {
+        return;
+    }
+    uint32_t capacity = std::max(frame.capacity, sInitialCapacity);
+    while (capacity < count)
+    {
+        capacity *= 2;
+    }
+    destroyInstances_(frame);
+
+    // `̐ɍ킹čL̂͑z肵Ȃ̂ŁAԂɓłsĂ悢
+    VkObjectTracker::SteadyStateExemption exemption;
+    const VkDeviceSize size = VkDeviceSize(capacity) * sizeof(RectInstance);
+    mGfxDevice->createBuffer(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, frame.buffer, frame.memory);
+    mGfxDevice->setObjectName(uint64_t(frame.buffer), "RectBatchInstances", VK_OBJECT_TYPE_BUFFER);
+    void* data = nullptr;
+    if (vkMapMemory(mGfxDevice->getVkDevice(), frame.memory, 0, size, 0, &data) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to map rect instance buffer!");
+    }
+    frame.mapped = static_cast<RectInstance*>(data);
+    frame.capacity = capacity;
+}
+//---------------------------------------------------------------------------
+void RectBatch::destroyInstances_(FrameContext& frame)
+{
+    if (frame.buffer == VK_NULL_HANDLE)
+    {
+        return;
+    }
+    vkUnmapMemory(mGfxDevice->getVkDevice(), frame.memory);
+    mGfxDevice->destroyBuffer(frame.buffer, frame.memory);
+    frame.mapped = nullptr;
+    frame.capacity = 0;
+}
+//---------------------------------------------------------------------------
+void RectBatch::drawImGui()
+{
+    ImGui::SeparatorText("Rect batch");
+    ImGui::Text("Rects: %u  Draws: %u  Capacity: %u", mStats.instanceCount, mStats.drawCount, mStats.capacity);
+    ImGui::Text("Upload: %.2f us  Record: %.2f us", mStats.uploadUs, mStats.recordUs);
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+#include <vector>
+#include "glm/glm.hpp"
+#include "GfxDevice.h"
+#include "PipelineManager.h"
+#include "DynamicStateCache.h"
+
+//---------------------------------------------------------------------------
+/*
+ * CX^Xobt@ɕׂ`1 (res/rect_batch.vert ̓͂ƍ킹邱)
+ */
+struct RectInstance
+{
+	glm::vec2 position{ 0.0f };   // S (Nbv)
+	glm::vec2 size{ 0.0f };
+	float rotation = 0.0f;        // WA
+	uint32_t color = 0xffffffff;  // RGBA8 (R ŉʃoCg)
+	// BindlessDescriptors ɓo^ԍ
+	uint32_t textureIndex = 0;
+	uint32_t samplerIndex = 0;
+};
+static_assert(sizeof(RectInstance) == 32, "RectInstance must match the instance attributes");
+
+//---------------------------------------------------------------------------
+/*
+ * ʂ̋`CX^VOł܂Ƃ߂ĕ`悷
+ * lp`̃bV͑SĂ̋`ŋLA`̈ʒuE傫E]EFEeNX`̔ԍCX^Xobt@ɗ
+ * Rect::render ̂悤ɋ`Ƀobt@ĕ`悵Ȃ̂ŁA`̐Ă CPU ׂ͂̕قƂǑȂ
+ *
+ * `̓pCvC1 vkCmdDrawIndexed ɂȂ
+ * eNX`̓oChX̔ԍŎQƂ̂ŁAeNX`Ă`𕪂Kv͂Ȃ
+ * pCvC̒ł add ɕ`悷 (̏dȂ菇͕ۂ)
+ *
+ * CX^Xobt@̓t[ReLXgɎAiIɃ}bvĂ
+ * ȂȂꍇ͔{̑傫ō蒼 (̃t[̃tFX҂Ȃ̂ GPU ͎QƂĂȂ)
+ * R}hL^ƓXbhg
+ */
+class RectBatch
+{
+public:
+	static constexpr uint32_t sInitialCapacity = 4096;
+
+	struct Stats
+	{
+		uint32_t instanceCount = 0;  // OɋL^`̐
+		uint32_t drawCount = 0;      // OɋL^`̐
+		uint32_t capacity = 0;       // ݂̃t[̃CX^Xobt@ɓ`̐
+		double uploadUs = 0.0;       // CX^Xobt@ւ݂̏ɂ CPU 
+		double recordUs = 0.0;       // `R}h̋L^ɂ CPU 
+	};
+
+public:
+	void initialize(GfxDevice* gfx_device, uint32_t frameCount);
+	void shutdown();
+	inline bool isInitialized() const { return mGfxDevice != nullptr; }
+
+	/*
+	 * base ̃VF[_[ƒ_͂`pɍւpCvCo^Aadd Ŏw肷ԍԂ
+	 * base ̃pCvCCAEg̓Zbg 0  BindlessDescriptors ̃Zbgł邱
+	 * overdrawLayout nƃI[o[h[vp̃oAg (OverdrawView::makePipelineDesc)
+	 */
+	uint32_t addPipeline(const GraphicsPipelineDesc& base, VkPipelineLayout overdrawLayout = VK_NULL_HANDLE);
+
+	/*
+	 * frameIndex ̃t[̋L^n߂ (Õt[ add `͎̂Ă)
+	 * ̃t[̃CtCgtFX҂ɌĂԂ
+	 */
+	void beginFrame(uint32_t frameIndex);
+	void add(uint32_t pipeline, const RectInstance& instance);
+	/*
+	 * add `CX^Xobt@ɏ݁ApCvC1񂸂`悷
+	 * oChX̃Zbg͌ς݂ł邱
+	 * RpCIĂȂpCvC̋`͕`悵Ȃ
+	 * isOverdraw ̏ꍇ̓I[o[h[vp̃oAgŕ` (I[o[h[̃Zbg͌ς݂ł邱)
+	 */
+	void record(VkCommandBuffer commandBuffer, DynamicStateCache& dynamicState, VkExtent2D extent, bool isOverdraw = false);
+
+	static uint32_t packColor(const glm::vec4& color);
+
+	inline const Stats& getStats() const { return mStats; }
+	void drawImGui();
+
+private:
+	struct Bucket
+	{
+		GraphicsPipelineDesc desc;
+		PipelineHandle pipeline;
+		GraphicsPipelineDesc overdrawDesc;
+		PipelineHandle overdrawPipeline;
+		std::vector<RectInstance> instances;
+	};
+	struct FrameContext
+	{
+		VkBuffer buffer = VK_NULL_HANDLE;
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		RectInstance* mapped = nullptr;
+		uint32_t capacity = 0;
+	};
+
+	void createMesh_();
+	void reserveInstances_(FrameContext& frame, uint32_t count);
+	void destroyInstances_(FrameContext& frame);
+
+private:
+	GfxDevice* mGfxDevice = nullptr;
+	// L̎lp` (p̈ʒuƃeNX`W)
+	VkBuffer mVertexBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory mVertexMemory = VK_NULL_HANDLE;
+	VkBuffer mIndexBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory mIndexMemory = VK_NULL_HANDLE;
+
+	std::vector<Bucket> mBuckets;
+	std::vector<FrameContext> mFrames;
+	uint32_t mFrameIndex = 0;
+	Stats mStats;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,291 @@
+#include "ShaderHotReload.h"
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include "PipelineManager.h"
+#include "ShaderObjectRenderer.h"
+#include "ShaderSource.h"
+
+#include "imgui.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#define popen _popen
+#define pclose _pclose
+#endif
+
+//---------------------------------------------------------------------------
+ShaderHotReload::~ShaderHotReload()
+{
+    stop();
+}
+//---------------------------------------------------------------------------
+void ShaderHotReload::start(const char* directory)
+{
+    stop();
+
+    // FileLoader ƓAƃfBNgɖΈT
+    mShaderDirectory = directory;
+    mDirectory = directory;
+    if (!std::filesystem::is_directory(mDirectory))
+    {
+        mDirectory = std::filesystem::path("..") / directory;
+    }
+    if (!std::filesystem::is_directory(mDirectory))
+    {
+        fprintf(stderr, "[ShaderHotReload] %s not found, hot reload disabled\n", directory);
+        return;
+    }
+
+    // |[OpɌ݂̍XVL^Ă
+    mWriteTimes.clear();
+    std::vector<std::string> changed;
+    pollChanges_(changed);
+
+    mIsRunning = true;
+    mWatchThread = std::thread([this]() { watchThread_(); });
+}
+//---------------------------------------------------------------------------
+void ShaderHotReload::stop()
+{
+    mIsRunning = false;
+    if (mWatchThread.joinable())
+    {
+        mWatchThread.join();
+    }
+}
+//---------------------------------------------------------------------------
+void ShaderHotReload::addReloadCallback(ReloadCallback callback)
+{
+    mReloadCallbacks.push_back(std::move(callback));
+}
+//---------------------------------------------------------------------------
+bool ShaderHotReload::isShaderSource_(const std::string& fileName)
+{
+    // compileShader.bat RpĈƍ킹
+    const auto extension = std::filesystem::path(fileName).extension();
+    return extension == ".vert" || extension == ".frag" || extension == ".comp";
+}
+//---------------------------------------------------------------------------
+void ShaderHotReload::watchThread_()
+{
+#if defined(_WIN32)
+    // ~vmFł悤AdȂ I/O ŗvă^CAEgtő҂
+    const HANDLE directory = CreateFileW(mDirectory.c_str(), FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    const HANDLE event = directory != INVALID_HANDLE_VALUE ? CreateEventW(nullptr, TRUE, FALSE, nullptr) : nullptr;
+    OVERLAPPED overlapped{};
+    overlapped.hEvent = event;
+    alignas(DWORD) char buf[4096];
+
+    // GfB^͏㏑ꍇƈꎞt@C疼Oςꍇ̂ŗ
+    auto request_changes = [&]() {
+        ResetEvent(event);
+        return ReadDirectoryChangesW(directory, buf, sizeof(buf), FALSE,
+            FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, nullptr, &overlapped, nullptr) != FALSE;
+    };
+    bool is_watching = event != nullptr && request_changes();
+    if (!is_watching)
+    {
+        fprintf(stderr, "[ShaderHotReload] ReadDirectoryChangesW unavailable, falling back to polling\n");
+    }
+
+    // ͂ʒmVF[_[\[X̃t@CW߁A̒ʒmv
+    auto read_events = [&](std::set<std::string>& names) {
+        DWORD length = 0;
+        if (!GetOverlappedResult(directory, &overlapped, &length, FALSE))
+        {
+            return false;
+        }
+        for (DWORD offset = 0; length > 0;)
+        {
+            const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buf + offset);
+            const std::string name = std::filesystem::path(std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR))).string();
+            if (info->Action != FILE_ACTION_REMOVED && info->Action != FILE_ACTION_RENAMED_OLD_NAME && isShaderSource_(name))
+            {
+                names.insert(name);
+            }
+            if (info->NextEntryOffset == 0)
+            {
+                break;
+            }
+            offset += info->NextEntryOffset;
+        }
+        return request_changes();
+    };
+#endif
+
+    while (mIsRunning)
+    {
+        std::set<std::string> names;
+#if defined(_WIN32)
+        if (is_watching)
+        {
+            if (WaitForSingleObject(event, 100) != WAIT_OBJECT_0)
+            {
+                continue;
+            }
+            is_watching = read_events(names);
+            // ۑɑėʒm܂Ƃ߂
+            std::this_thread::sleep_for(std::chrono::milliseconds(sDebounceMs));
+            if (is_watching && WaitForSingleObject(event, 0) == WAIT_OBJECT_0)
+            {
+                is_watching = read_events(names);
+            }
+        }
+        else
+#endif
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            std::vector<std::string> changed;
+            pollChanges_(changed);
+            names.insert(changed.begin(), changed.end());
+        }
+
+        for (const auto& name : names)
+        {
+            compileShader_(name);
+        }
+    }
+
+#if defined(_WIN32)
+    if (directory != INVALID_HANDLE_VALUE)
+    {
+        // v I/O  buf ɏ܂ȂȂĂ
+        DWORD length = 0;
+        if (is_watching && CancelIoEx(directory, &overlapped))
+        {
+            GetOverlappedResult(directory, &overlapped, &length, TRUE);
+        }
+        CloseHandle(directory);
+    }
+    if (event != nullptr)
+    {
+        CloseHandle(event);
+    }
+#endif
+}
+//---------------------------------------------------------------------------
+void ShaderHotReload::pollChanges_(std::vector<std::string>& changed)
+{
+    std::error_code ec;
+    for (const auto& file : std::filesystem::directory_iterator(mDirectory, ec))
+    {
+        const std::string name = file.path().filename().string();
+        if (!file.is_regular_file() || !isShaderSource_(name))
+        {
+            continue;
+        }
+        const auto write_time = file.last_write_time(ec);
+        auto [it, inserted] = mWriteTimes.try_emplace(name, write_time);
+        if (!inserted && it->second != write_time)
+        {
+            it->second = write_time;
+            changed.push_back(name);
+        }
+    }
+}
+//---------------------------------------------------------------------------
+void ShaderHotReload::compileShader_(const std::string& fileName)
+{
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto source_path = mDirectory / fileName;
+    const auto output_path = mDirectory / (fileName + ".spv");
+    auto temp_path = output_path;
+    temp_path += ".tmp";
+    const std::string stage = std::filesystem::path(fileName).extension().string().substr(1);
+
+    // compileShader.bat ƓIvVŃRpC
+    // pCvC̃[J[ݓr SPIR-V ǂ܂Ȃ悤ꎞt@Cɏo͂
+    const std::string command = std::string(sCompilerCommand) +
+        " -S " + stage +
+        " \"" + source_path.string() + "\"" +
+        " --target-env vulkan1.0" +
+        " -o \"" + temp_path.string() + "\" 2>&1";
+
+    std::string output;
+    int exit_code = -1;
+    if (FILE* pipe = popen(command.c_str(), "r"))
+    {
+        char buf[256];
+        while (fgets(buf, sizeof(buf), pipe) != nullptr)
+        {
+            output += buf;
+        }
+        exit_code = pclose(pipe);
+    }
+
+    std::error_code ec;
+    if (exit_code == 0)
+    {
+        std::filesystem::rename(temp_path, output_path, ec);
+    }
+    const bool is_succeeded = exit_code == 0 && !ec;
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+    {
+        std::lock_guard<std::mutex> lock(mStatusMutex);
+        mStatus.lastFile = fileName;
+        mStatus.lastCompileMs = elapsed_ms;
+        if (is_succeeded)
+        {
+            mStatus.lastError.clear();
+            mStatus.reloadCount++;
+        }
+        else
+        {
+            mStatus.lastError = output;
+            mStatus.errorCount++;
+        }
+    }
+
+    if (!is_succeeded)
+    {
+        std::filesystem::remove(temp_path, ec);
+        fprintf(stderr, "[ShaderHotReload] failed to compile %s\n%s", fileName.c_str(), output.c_str());
+        return;
+    }
+    fprintf(stderr, "[ShaderHotReload] %s compiled in %.1f ms\n", fileName.c_str(), elapsed_ms);
+
+    // pCvC̓VF[_[ "<start ɓnfBNg>/<name>.spv" ŎQƂĂ
+    // ȍ~͖ߍݍς݂̂̂ł͂ȂARpCfBXN̂̂g
+    const std::string spv_path = (mShaderDirectory / (fileName + ".spv")).generic_string();
+    getShaderSource()->setDiskOverride(spv_path);
+    getPipelineManager()->reloadShader(spv_path);
+    getShaderObjectRenderer()->reloadShader(spv_path);
+    for (const auto& callback : mReloadCallbacks)
+    {
+        callback(spv_path);
+    }
+}
+//---------------------------------------------------------------------------
+ShaderHotReload::Status ShaderHotReload::getStatus()
+{
+    std::lock_guard<std::mutex> lock(mStatusMutex);
+    return mStatus;
+}
+//---------------------------------------------------------------------------
+void ShaderHotReload::drawImGui()
+{
+    const Status status = getStatus();
+
+    ImGui::SeparatorText("Shader hot reload");
+    if (!mIsRunning)
+    {
+        ImGui::Text("Disabled");
+        return;
+    }
+    ImGui::Text("Reloads: %u  Errors: %u", status.reloadCount, status.errorCount);
+    if (!status.lastFile.empty())
+    {
+        ImGui::Text("Last: %s (%.1f ms)", status.lastFile.c_str(), status.lastCompileMs);
+    }
+    if (!status.lastError.empty())
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", status.lastError.c_str());
+    }
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
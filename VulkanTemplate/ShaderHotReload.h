@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//---------------------------------------------------------------------------
+/*
+ * res/ ȉ̃VF[_[\[X (.vert, .frag, .comp) ̕ύXĎASPIR-V ɍăRpC
+ * PipelineManager Ɋ֘ApCvC̍蒼˗
+ * Windows ł ReadDirectoryChangesWAȊOł͍XṼ|[OŕύXo
+ */
+class ShaderHotReload
+{
+public:
+	// VF[_[̃RpC (PATH T)
+	static constexpr const char* sCompilerCommand = "glslangValidator";
+	// GfB^̘A݂܂Ƃ߂邽߂̑҂
+	static constexpr int sDebounceMs = 50;
+
+	// RpC SPIR-V ̃pX ("res/<name>.spv") 󂯎
+	using ReloadCallback = std::function<void(const std::string& spvPath)>;
+
+	struct Status
+	{
+		std::string lastFile;
+		std::string lastError;
+		uint32_t reloadCount = 0;
+		uint32_t errorCount = 0;
+		double lastCompileMs = 0.0;
+	};
+
+public:
+	~ShaderHotReload();
+
+	/*
+	 * ĎJn (res Ȃꍇ ../res g)
+	 */
+	void start(const char* directory = "res");
+	void stop();
+
+	/*
+	 * PipelineManager  ShaderObjectRenderer ȊOŃVF[_[g (Rs[gpCvCȂ) ɍăRpCm点
+	 * ĎXbhĂ΂Bstart Oɓo^邱
+	 */
+	void addReloadCallback(ReloadCallback callback);
+
+	Status getStatus();
+	void drawImGui();
+
+	inline bool isRunning() const { return mIsRunning; }
+
+private:
+	void watchThread_();
+	void pollChanges_(std::vector<std::string>& changed);
+	void compileShader_(const std::string& fileName);
+	static bool isShaderSource_(const std::string& fileName);
+
+private:
+	// pCvCVF[_[QƂ鎞̃fBNg (start ɓn)
+	std::filesystem::path mShaderDirectory;
+	// ۂɊĎfBNg (ȂΈ)
+	std::filesystem::path mDirectory;
+	std::thread mWatchThread;
+	std::atomic<bool> mIsRunning = false;
+
+	// |[ȎO̍XV
+	std::unordered_map<std::string, std::filesystem::file_time_type> mWriteTimes;
+	std::vector<ReloadCallback> mReloadCallbacks;
+
+	std::mutex mStatusMutex;
+	Status mStatus;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
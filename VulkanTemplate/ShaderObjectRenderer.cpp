@@ -0,0 +1,380 @@
+#include "ShaderObjectRenderer.h"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include "PipelineLayoutCache.h"
+#include "ShaderSource.h"
+#include "VkObjectTracker.h"
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+static std::unique_ptr<ShaderObjectRenderer> shaderObjectRenderer = nullptr;
+std::unique_ptr<ShaderObjectRenderer>& getShaderObjectRenderer()
+{
+    if (shaderObjectRenderer == nullptr)
+    {
+        shaderObjectRenderer = std::make_unique<ShaderObjectRenderer>();
+    }
+    return shaderObjectRenderer;
+}
+//---------------------------------------------------------------------------
+void ShaderObjectRenderer::initialize(GfxDevice* gfx_device)
+{
+    mGfxDevice = gfx_device;
+    mIsRunning = true;
+    mWorker = std::thread([this]() { workerThread_(); });
+}
+//---------------------------------------------------------------------------
+void ShaderObjectRenderer::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsRunning = false;
+        mQueue.clear();
+    }
+    mQueueCondition.notify_all();
+    if (mWorker.joinable())
+    {
+        mWorker.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto& [key, programs] : mPrograms)
+    {
+        for (auto& program : programs)
+        {
+            destroyProgram_(program);
+        }
+    }
+    mPrograms.clear();
+    for (auto& retired : mRetiredPrograms)
+    {
+        destroyProgram_(retired.program);
+    }
+    mRetiredPrograms.clear();
+    mGfxDevice = nullptr;
+}
+//---------------------------------------------------------------------------
+bool ShaderObjectRenderer::prepare(const GraphicsPipelineDesc& desc)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (const Program* found = findProgram_(desc); found != nullptr && found->vertexShader != VK_NULL_HANDLE)
+        {
+            return true;
+        }
+    }
+
+    // NɌĂԂ̂Ȃ̂ŁȀŐ
+    Program program;
+    const bool is_created = createProgram_(desc, program);
+    std::lock_guard<std::mutex> lock(mMutex);
+    storeProgram_(std::move(program));
+    return is_created;
+}
+//---------------------------------------------------------------------------
+bool ShaderObjectRenderer::bind(DynamicStateCache& state, const GraphicsPipelineDesc& desc, VkExtent2D extent)
+{
+    VkShaderEXT vertex_shader = VK_NULL_HANDLE;
+    VkShaderEXT fragment_shader = VK_NULL_HANDLE;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const Program* found = findProgram_(desc);
+        if (found == nullptr)
+        {
+            // R}h̋L^ɐƃqb`ɂȂ̂ŁA[J[Őďo܂ł̓XLbv
+            mPrograms[getProgramKey_(desc)].push_back(Program{ .desc = desc });
+            mQueue.push_back(CompileJob{ .desc = desc });
+            mQueueCondition.notify_one();
+            return false;
+        }
+        if (found->vertexShader == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+        vertex_shader = found->vertexShader;
+        fragment_shader = found->fragmentShader;
+    }
+
+    // OƓVF[_[l̐ݒ DynamicStateCache Ȃ
+    state.bindShaders(vertex_shader, fragment_shader);
+    state.setShaderObjectState(desc, extent);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mBindCount++;
+    return true;
+}
+//---------------------------------------------------------------------------
+void ShaderObjectRenderer::reloadShader(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const auto& [key, programs] : mPrograms)
+    {
+        for (const auto& program : programs)
+        {
+            if (program.desc.vertexShader == path || program.desc.fragmentShader == path)
+            {
+                // oオ܂ł͌Â̂g (ւ storeProgram_)
+                mQueue.push_back(CompileJob{ .desc = program.desc, .isReload = true });
+            }
+        }
+    }
+    mQueueCondition.notify_one();
+}
+//---------------------------------------------------------------------------
+void ShaderObjectRenderer::workerThread_()
+{
+    while (true)
+    {
+        CompileJob job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mQueueCondition.wait(lock, [this]() { return !mIsRunning || !mQueue.empty(); });
+            if (!mIsRunning)
+            {
+                break;
+            }
+            job = std::move(mQueue.front());
+            mQueue.pop_front();
+        }
+
+        Program program;
+        bool is_created = false;
+        {
+            // `~߂ɐ̂ŁAԂɓłsĂ悢
+            VkObjectTracker::SteadyStateExemption exemption;
+            is_created = createProgram_(job.desc, program);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (job.isReload && !is_created)
+        {
+            // 蒼Ɏsꍇ͌ÂVF[_[g
+            continue;
+        }
+        if (job.isReload)
+        {
+            mReloadCount++;
+        }
+        storeProgram_(std::move(program));
+    }
+}
+//---------------------------------------------------------------------------
+void ShaderObjectRenderer::beginFrame()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFrameNumber++;
+    std::erase_if(mRetiredPrograms, [&](RetiredProgram& retired) {
+        if (mFrameNumber - retired.retireFrame < sRetireFrameDelay)
+        {
+            return false;
+        }
+        destroyProgram_(retired.program);
+        return true;
+    });
+
+    mLastFrameStats.bindCount = mBindCount;
+    mBindCount = 0;
+}
+//---------------------------------------------------------------------------
+ShaderObjectRenderer::Stats ShaderObjectRenderer::getStats()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    Stats stats = mLastFrameStats;
+    for (const auto& [key, programs] : mPrograms)
+    {
+        stats.programCount += static_cast<uint32_t>(programs.size());
+    }
+    stats.createCount = mCreateCount;
+    stats.createMs = mCreateMs;
+    stats.reloadCount = mReloadCount;
+    return stats;
+}
+//---------------------------------------------------------------------------
+void ShaderObjectRenderer::drawImGui()
+{
+    const Stats stats = getStats();
+
+    ImGui::SeparatorText("Shader objects");
+    ImGui::Text("Programs: %u  Created: %llu (%.2f ms)  Reloaded: %llu",
+        stats.programCount,
+        static_cast<unsigned long long>(stats.createCount),
+        stats.createMs,
+        static_cast<unsigned long long>(stats.reloadCount));
+    ImGui::Text("Binds: %u", stats.bindCount);
+}
+//---------------------------------------------------------------------------
+ShaderObjectRenderer::Program* ShaderObjectRenderer::findProgram_(const GraphicsPipelineDesc& desc)
+{
+    auto it = mPrograms.find(getProgramKey_(desc));
+    if (it == mPrograms.end())
+    {
+        return nullptr;
+    }
+    for (auto& program : it->second)
+    {
+        if (isSameProgram_(program.desc, desc))
+        {
+            return &program;
+        }
+    }
+    return nullptr;
+}
+//---------------------------------------------------------------------------
+void ShaderObjectRenderer::storeProgram_(Program&& program)
+{
+    Program* found = findProgram_(program.desc);
+    if (found == nullptr)
+    {
+        mPrograms[getProgramKey_(program.desc)].push_back(std::move(program));
+        return;
+    }
+    if (program.vertexShader == VK_NULL_HANDLE)
+    {
+        // sꍇAɏoĂ̂΂c
+        return;
+    }
+    if (found->vertexShader != VK_NULL_HANDLE)
+    {
+        // gp̃R}hobt@̂ŁAɂ͔jȂ
+        mRetiredPrograms.push_back(RetiredProgram{ .program = *found, .retireFrame = mFrameNumber });
+    }
+    *found = std::move(program);
+}
+//---------------------------------------------------------------------------
+bool ShaderObjectRenderer::createProgram_(const GraphicsPipelineDesc& desc, Program& program)
+{
+    // VF[_[IuWFNg̓pCvCCAEgł͂ȂA̍\𒼐ڎ󂯎
+    std::vector<VkDescriptorSetLayout> set_layouts;
+    std::vector<VkPushConstantRange> push_constant_ranges;
+    if (!getPipelineLayoutCache()->findPipelineLayout(desc.layout, set_layouts, push_constant_ranges))
+    {
+        fprintf(stderr, "[ShaderObjectRenderer] %s: pipeline layout is not from PipelineLayoutCache\n", desc.debugName.c_str());
+        program = Program{ .desc = desc };
+        return false;
+    }
+
+    std::vector<uint32_t> vertex_storage;
+    std::vector<uint32_t> fragment_storage;
+    auto vertex_code = getShaderSource()->load(desc.vertexShader, vertex_storage);
+    auto fragment_code = getShaderSource()->load(desc.fragmentShader, fragment_storage);
+    if (vertex_code.empty() || fragment_code.empty())
+    {
+        fprintf(stderr, "[ShaderObjectRenderer] failed to load %s / %s\n", desc.vertexShader.c_str(), desc.fragmentShader.c_str());
+        program = Program{ .desc = desc };
+        return false;
+    }
+
+    VkSpecializationInfo specialization_info{};
+    std::vector<VkSpecializationMapEntry> specialization_entries;
+    desc.permutation.getSpecializationInfo(specialization_info, specialization_entries);
+    const VkSpecializationInfo* specialization = desc.permutation.empty() ? nullptr : &specialization_info;
+
+    // 2̃Xe[WNĐƁApCvCƓ̃Xe[WԍœK
+    const std::array<VkShaderCreateInfoEXT, 2> create_infos = {
+        VkShaderCreateInfoEXT{
+            .sType = VK_STRUCTURE_TYPE_SHADER_CREATE_INFO_EXT,
+            .flags = VK_SHADER_CREATE_LINK_STAGE_BIT_EXT,
+            .stage = VK_SHADER_STAGE_VERTEX_BIT,
+            .nextStage = VK_SHADER_STAGE_FRAGMENT_BIT,
+            .codeType = VK_SHADER_CODE_TYPE_SPIRV_EXT,
+            .codeSize = vertex_code.size_bytes(),
+            .pCode = vertex_code.data(),
+            .pName = "main",
+            .setLayoutCount = static_cast<uint32_t>(set_layouts.size()),
+            .pSetLayouts = set_layouts.data(),
+            .pushConstantRangeCount = static_cast<uint32_t>(push_constant_ranges.size()),
+            .pPushConstantRanges = push_constant_ranges.data(),
+            .pSpecializationInfo = specialization,
+        },
+        VkShaderCreateInfoEXT{
+            .sType = VK_STRUCTURE_TYPE_SHADER_CREATE_INFO_EXT,
+            .flags = VK_SHADER_CREATE_LINK_STAGE_BIT_EXT,
+            .stage = VK_SHADER_STAGE_FRAGMENT_BIT,
+            .nextStage = 0,
+            .codeType = VK_SHADER_CODE_TYPE_SPIRV_EXT,
+            .codeSize = fragment_code.size_bytes(),
+            .pCode = fragment_code.data(),
+            .pName = "main",
+            .setLayoutCount = static_cast<uint32_t>(set_layouts.size()),
+            .pSetLayouts = set_layouts.data(),
+            .pushConstantRangeCount = static_cast<uint32_t>(push_constant_ranges.size()),
+            .pPushConstantRanges = push_constant_ranges.data(),
+            .pSpecializationInfo = specialization,
+        },
+    };
+
+    const auto start_time = std::chrono::steady_clock::now();
+    std::array<VkShaderEXT, 2> shaders = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+    VkResult result = vkCreateShadersEXT(mGfxDevice->getVkDevice(), static_cast<uint32_t>(create_infos.size()), create_infos.data(), nullptr, shaders.data());
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+    if (result != VK_SUCCESS)
+    {
+        // sĂꕔĂꍇ
+        for (auto shader : shaders)
+        {
+            if (shader != VK_NULL_HANDLE)
+            {
+                vkDestroyShaderEXT(mGfxDevice->getVkDevice(), shader, nullptr);
+            }
+        }
+        fprintf(stderr, "[ShaderObjectRenderer] failed to create shader objects for %s (%d)\n", desc.debugName.c_str(), static_cast<int>(result));
+        program = Program{ .desc = desc };
+        return false;
+    }
+
+    auto& tracker = getVkObjectTracker();
+    tracker->onCreate(shaders[0], VK_OBJECT_TYPE_SHADER_EXT);
+    tracker->onCreate(shaders[1], VK_OBJECT_TYPE_SHADER_EXT);
+    const std::string vertex_name = desc.debugName + "VertexShaderObject";
+    const std::string fragment_name = desc.debugName + "FragmentShaderObject";
+    mGfxDevice->setObjectName(uint64_t(shaders[0]), vertex_name.c_str(), VK_OBJECT_TYPE_SHADER_EXT);
+    mGfxDevice->setObjectName(uint64_t(shaders[1]), fragment_name.c_str(), VK_OBJECT_TYPE_SHADER_EXT);
+
+    program = Program{
+        .desc = desc,
+        .vertexShader = shaders[0],
+        .fragmentShader = shaders[1],
+    };
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCreateCount++;
+    mCreateMs += elapsed_ms;
+    return true;
+}
+//---------------------------------------------------------------------------
+void ShaderObjectRenderer::destroyProgram_(Program& program)
+{
+    auto device = mGfxDevice->getVkDevice();
+    auto& tracker = getVkObjectTracker();
+    for (auto* shader : { &program.vertexShader, &program.fragmentShader })
+    {
+        if (*shader != VK_NULL_HANDLE)
+        {
+            vkDestroyShaderEXT(device, *shader, nullptr);
+            tracker->onDestroy(*shader, VK_OBJECT_TYPE_SHADER_EXT);
+            *shader = VK_NULL_HANDLE;
+        }
+    }
+}
+//---------------------------------------------------------------------------
+uint64_t ShaderObjectRenderer::getProgramKey_(const GraphicsPipelineDesc& desc)
+{
+    // VF[_[̐ɉê (̑̏Ԃ͑SēIɐݒ肷)
+    StateHasher hasher;
+    hasher.add(desc.vertexShader);
+    hasher.add(desc.fragmentShader);
+    hasher.add(desc.permutation.getKey());
+    hasher.add(desc.layout);
+    return hasher.get();
+}
+//---------------------------------------------------------------------------
+bool ShaderObjectRenderer::isSameProgram_(const GraphicsPipelineDesc& a, const GraphicsPipelineDesc& b)
+{
+    // getProgramKey_ nbVɊ܂߂ׂ̂
+    return a.vertexShader == b.vertexShader &&
+        a.fragmentShader == b.fragmentShader &&
+        a.permutation == b.permutation &&
+        a.layout == b.layout;
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "DynamicStateCache.h"
+#include "GfxDevice.h"
+#include "PipelineState.h"
+
+//---------------------------------------------------------------------------
+class ShaderObjectRenderer;
+std::unique_ptr<ShaderObjectRenderer>& getShaderObjectRenderer();
+
+//---------------------------------------------------------------------------
+/*
+ * VK_EXT_shader_object ɂ`
+ * pCvC炸ɒ_EtOgVF[_[Nς݂̃VF[_[IuWFNgƂĐA
+ * GraphicsPipelineDesc ̏Ԃ͑SēIXe[gƂăR}hobt@ɋL^ (DynamicStateCache)
+ * pCvCoR̕`ƓLq󂯎̂ŁAV[ CPU ׂƋNԂrł
+ *
+ * VF[_[IuWFNg̓_[pXȂ߁ADynamic Rendering ̒ł̂ݎg
+ *
+ * N prepare ̈ȊO (߂ĎgꂽoAgzbg[h) ̓[J[XbhŐA
+ * o܂ł͕`XLbv (zbg[h̏ꍇ͌ÂVF[_[ŕ`𑱂)
+ */
+class ShaderObjectRenderer
+{
+public:
+	// zbg[hŕsvɂȂVF[_[j܂ł̃t[
+	static constexpr uint32_t sRetireFrameDelay = 3;
+
+	struct Stats
+	{
+		uint32_t programCount = 0;
+		uint64_t createCount = 0;
+		double createMs = 0.0;         // ɂԂ̍v
+		uint64_t reloadCount = 0;
+		// Õt[̋L^e
+		uint32_t bindCount = 0;
+	};
+
+public:
+	void initialize(GfxDevice* gfx_device);
+	void shutdown();
+
+	/*
+	 * desc ̃VF[_[̃VF[_[IuWFNg𐶐Ă (܂ő҂A̕`ł̃qb`)
+	 * sꍇ false
+	 */
+	bool prepare(const GraphicsPipelineDesc& desc);
+	/*
+	 * desc Ɠ`ɂȂ悤ɃVF[_[IuWFNgASĂ̓IXe[gݒ肷
+	 * r[|[gƃVU[ extent ŜɂȂ
+	 * VF[_[AɎsĂꍇ false Ԃ̂ŁAĂяo͕`XLbv
+	 */
+	bool bind(DynamicStateCache& state, const GraphicsPipelineDesc& desc, VkExtent2D extent);
+
+	/*
+	 * w肵VF[_[ (SPIR-V ̃pX) gVF[_[IuWFNg[J[ō蒼
+	 * oオ܂ł͌Â̂g
+	 */
+	void reloadShader(const std::string& path);
+	/*
+	 * t[̋E (CtCgtFX̑ҋ@AR}hL^O) ŌĂяo
+	 */
+	void beginFrame();
+
+	Stats getStats();
+	void drawImGui();
+
+private:
+	struct Program
+	{
+		// VF[_[̐ɎgLq (nbV̂ isSameProgram_ ŋʂ)
+		GraphicsPipelineDesc desc;
+		// AɎsꍇ (̃zbg[h܂ō蒼Ȃ) ͗Ƃ VK_NULL_HANDLE
+		VkShaderEXT vertexShader = VK_NULL_HANDLE;
+		VkShaderEXT fragmentShader = VK_NULL_HANDLE;
+	};
+	struct RetiredProgram
+	{
+		Program program;
+		uint64_t retireFrame = 0;
+	};
+	struct CompileJob
+	{
+		GraphicsPipelineDesc desc;
+		bool isReload = false;
+	};
+
+	void workerThread_();
+	Program* findProgram_(const GraphicsPipelineDesc& desc);
+	//  Program o^A蒼̏ꍇ͌Â̂xjɉ (mMutex bNČĂ)
+	void storeProgram_(Program&& program);
+	bool createProgram_(const GraphicsPipelineDesc& desc, Program& program);
+	void destroyProgram_(Program& program);
+	static uint64_t getProgramKey_(const GraphicsPipelineDesc& desc);
+	static bool isSameProgram_(const GraphicsPipelineDesc& a, const GraphicsPipelineDesc& b);
+
+private:
+	GfxDevice* mGfxDevice = nullptr;
+
+	// zbg[h̓t@CĎXbhĂ΂
+	std::mutex mMutex;
+	std::unordered_map<uint64_t, std::vector<Program>> mPrograms;
+	std::vector<RetiredProgram> mRetiredPrograms;
+	uint64_t mFrameNumber = 0;
+
+	std::deque<CompileJob> mQueue;
+	std::condition_variable mQueueCondition;
+	std::thread mWorker;
+	bool mIsRunning = false;
+
+	uint64_t mCreateCount = 0;
+	double mCreateMs = 0.0;
+	uint64_t mReloadCount = 0;
+	uint32_t mBindCount = 0;
+	Stats mLastFrameStats;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <vector>
+#include "GfxDevice.h"
+
+//---------------------------------------------------------------------------
+/*
+ * ꉻ萔1̒l (VF[_[ layout(constant_id = N) ƑΉ)
+ * bool  VkBool32Afloat ̓rbĝ܂ 32bit Ŏ
+ */
+struct SpecializationConstant
+{
+	uint32_t constantId;
+	uint32_t value;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * ꉻ萔ɂVF[_[̃oAg
+ * s̕ł͂ȂpCvC̃RpCɒ萔Ƃďݍ܂AgȂR[h͏
+ * 萔 constantId ɕׂĎ̂ŁAeȂ瓯L[ɂȂ
+ */
+class ShaderPermutation
+{
+public:
+	inline ShaderPermutation& set(uint32_t constantId, uint32_t value)
+	{
+		auto it = std::lower_bound(mConstants.begin(), mConstants.end(), constantId, [](const SpecializationConstant& constant, uint32_t id) {
+			return constant.constantId < id;
+		});
+		if (it != mConstants.end() && it->constantId == constantId)
+		{
+			it->value = value;
+		}
+		else
+		{
+			mConstants.insert(it, SpecializationConstant{ .constantId = constantId, .value = value });
+		}
+		return *this;
+	}
+	inline ShaderPermutation& set(uint32_t constantId, bool value) { return set(constantId, uint32_t(value ? VK_TRUE : VK_FALSE)); }
+	inline ShaderPermutation& set(uint32_t constantId, float value) { return set(constantId, std::bit_cast<uint32_t>(value)); }
+
+	/*
+	 * pCvC PipelineManager ̏dɎgL[
+	 */
+	inline uint64_t getKey() const
+	{
+		uint64_t hash = 0xcbf29ce484222325ull;
+		for (const auto& constant : mConstants)
+		{
+			for (uint32_t word : { constant.constantId, constant.value })
+			{
+				hash ^= word;
+				hash *= 0x100000001b3ull;
+			}
+		}
+		return hash;
+	}
+
+	/*
+	 * VkSpecializationInfo  (f[^ this QƂ̂ŁAgI܂ this 𐶂Ă)
+	 */
+	inline void getSpecializationInfo(VkSpecializationInfo& info, std::vector<VkSpecializationMapEntry>& mapEntries) const
+	{
+		mapEntries.clear();
+		for (size_t i = 0; i < mConstants.size(); ++i)
+		{
+			mapEntries.push_back(VkSpecializationMapEntry{
+				.constantID = mConstants[i].constantId,
+				.offset = static_cast<uint32_t>(i * sizeof(SpecializationConstant) + offsetof(SpecializationConstant, value)),
+				.size = sizeof(uint32_t),
+			});
+		}
+		info = VkSpecializationInfo{
+			.mapEntryCount = static_cast<uint32_t>(mapEntries.size()),
+			.pMapEntries = mapEntries.data(),
+			.dataSize = mConstants.size() * sizeof(SpecializationConstant),
+			.pData = mConstants.data(),
+		};
+	}
+
+	inline bool empty() const { return mConstants.empty(); }
+	inline const std::vector<SpecializationConstant>& getConstants() const { return mConstants; }
+
+	inline bool operator==(const ShaderPermutation& other) const
+	{
+		return std::equal(mConstants.begin(), mConstants.end(), other.mConstants.begin(), other.mConstants.end(),
+			[](const SpecializationConstant& a, const SpecializationConstant& b) { return a.constantId == b.constantId && a.value == b.value; });
+	}
+
+private:
+	std::vector<SpecializationConstant> mConstants;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * C̃VF[_[ (res/shader.vert, res/shader.frag) ̃oAg
+ * constant_id ̓VF[_[̐錾ƍ킹邱
+ */
+struct MainShaderPermutation
+{
+	static constexpr uint32_t sUseTextureId = 0;
+	static constexpr uint32_t sUseVertexColorId = 1;
+	static constexpr uint32_t sUseAlphaTestId = 2;
+	static constexpr uint32_t sAlphaCutoffId = 3;
+
+	bool useTexture = true;
+	bool useVertexColor = true;
+	bool useAlphaTest = false;
+	float alphaCutoff = 0.5f;
+
+	inline ShaderPermutation build() const
+	{
+		ShaderPermutation permutation;
+		permutation.set(sUseTextureId, useTexture);
+		permutation.set(sUseVertexColorId, useVertexColor);
+		permutation.set(sUseAlphaTestId, useAlphaTest);
+		// At@eXggȂꍇ臒l̈ႢŃoAgȂ悤ɂ
+		permutation.set(sAlphaCutoffId, useAlphaTest ? alphaCutoff : 0.0f);
+		return permutation;
+	}
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,530 @@
+#include "ShaderReflection.h"
+#include <algorithm>
+#include <cstdio>
+#include <unordered_map>
+#include "ShaderSource.h"
+
+//---------------------------------------------------------------------------
+namespace
+{
+    // gp SPIR-V ̒萔 (spirv.h )
+    constexpr uint32_t sSpirvMagic = 0x07230203;
+
+    enum SpvOp : uint32_t
+    {
+        OpEntryPoint = 15,
+        OpTypeInt = 21,
+        OpTypeFloat = 22,
+        OpTypeVector = 23,
+        OpTypeMatrix = 24,
+        OpTypeImage = 25,
+        OpTypeSampler = 26,
+        OpTypeSampledImage = 27,
+        OpTypeArray = 28,
+        OpTypeRuntimeArray = 29,
+        OpTypeStruct = 30,
+        OpTypePointer = 32,
+        OpConstant = 43,
+        OpSpecConstantTrue = 48,
+        OpSpecConstantFalse = 49,
+        OpSpecConstant = 50,
+        OpVariable = 59,
+        OpDecorate = 71,
+        OpMemberDecorate = 72,
+        OpTypeAccelerationStructureKHR = 5341,
+    };
+    enum SpvDecoration : uint32_t
+    {
+        DecorationSpecId = 1,
+        DecorationBlock = 2,
+        DecorationBufferBlock = 3,
+        DecorationArrayStride = 6,
+        DecorationBuiltIn = 11,
+        DecorationLocation = 30,
+        DecorationBinding = 33,
+        DecorationDescriptorSet = 34,
+        DecorationOffset = 35,
+    };
+    enum SpvStorageClass : uint32_t
+    {
+        StorageClassUniformConstant = 0,
+        StorageClassInput = 1,
+        StorageClassUniform = 2,
+        StorageClassPushConstant = 9,
+        StorageClassStorageBuffer = 12,
+    };
+    enum SpvExecutionModel : uint32_t
+    {
+        ExecutionModelVertex = 0,
+        ExecutionModelFragment = 4,
+        ExecutionModelGLCompute = 5,
+    };
+    constexpr uint32_t sDimBuffer = 5;
+    constexpr uint32_t sDimSubpassData = 6;
+
+    struct SpvType
+    {
+        uint32_t op = 0;
+        // ߖ̃Iyh (Int: /, Vector: vf^/, Image: /sampled, Pointer: Xg[W/^ Ȃ)
+        uint32_t operand0 = 0;
+        uint32_t operand1 = 0;
+        uint32_t operand2 = 0;
+        std::vector<uint32_t> members;
+    };
+    struct SpvDecorations
+    {
+        uint32_t set = 0;
+        uint32_t binding = 0;
+        uint32_t location = 0;
+        uint32_t arrayStride = 0;
+        uint32_t specId = 0;
+        bool hasSpecId = false;
+        bool hasBinding = false;
+        bool hasLocation = false;
+        bool isBufferBlock = false;
+        bool isBuiltIn = false;
+        std::vector<uint32_t> memberOffsets;
+    };
+    struct SpvVariable
+    {
+        uint32_t id;
+        uint32_t typeId;
+        uint32_t storageClass;
+    };
+
+    //---------------------------------------------------------------------------
+    class SpirvParser
+    {
+    public:
+        std::unordered_map<uint32_t, SpvType> types;
+        std::unordered_map<uint32_t, SpvDecorations> decorations;
+        std::unordered_map<uint32_t, uint32_t> constants;
+        std::vector<uint32_t> specConstants;
+        std::vector<SpvVariable> variables;
+        uint32_t executionModel = UINT32_MAX;
+
+        bool parse(const uint32_t* code, size_t wordCount)
+        {
+            if (wordCount < 5 || code[0] != sSpirvMagic)
+            {
+                return false;
+            }
+            for (size_t i = 5; i < wordCount;)
+            {
+                const uint32_t op = code[i] & 0xffff;
+                const uint32_t count = code[i] >> 16;
+                if (count == 0 || i + count > wordCount)
+                {
+                    return false;
+                }
+                parseInstruction_(op, &code[i + 1], count - 1);
+                i += count;
+            }
+            return true;
+        }
+
+        /*
+         * ^̃oCgTCY (vbV萔͈̔͂߂pAstd430 ŊTZ)
+         */
+        uint32_t getTypeSize(uint32_t typeId) const
+        {
+            auto it = types.find(typeId);
+            if (it == types.end())
+            {
+                return 0;
+            }
+            const auto& type = it->second;
+            switch (type.op)
+            {
+            case OpTypeInt:
+            case OpTypeFloat:
+                return type.operand0 / 8;
+            case OpTypeVector:
+                return getTypeSize(type.operand0) * type.operand1;
+            case OpTypeMatrix:
+                // xNg16oCgEɑ
+                return ((getTypeSize(type.operand0) + 15) & ~15u) * type.operand1;
+            case OpTypeArray:
+            {
+                const uint32_t length = getConstant(type.operand1);
+                auto decoration = decorations.find(typeId);
+                const uint32_t stride = decoration != decorations.end() && decoration->second.arrayStride > 0
+                    ? decoration->second.arrayStride
+                    : getTypeSize(type.operand0);
+                return stride * length;
+            }
+            case OpTypeStruct:
+            {
+                uint32_t size = 0;
+                auto decoration = decorations.find(typeId);
+                for (size_t m = 0; m < type.members.size(); ++m)
+                {
+                    uint32_t offset = 0;
+                    if (decoration != decorations.end() && m < decoration->second.memberOffsets.size())
+                    {
+                        offset = decoration->second.memberOffsets[m];
+                    }
+                    size = std::max(size, offset + getTypeSize(type.members[m]));
+                }
+                return size;
+            }
+            default:
+                return 0;
+            }
+        }
+
+        uint32_t getConstant(uint32_t id) const
+        {
+            auto it = constants.find(id);
+            return it != constants.end() ? it->second : 1;
+        }
+
+        const SpvType* getType(uint32_t id) const
+        {
+            auto it = types.find(id);
+            return it != types.end() ? &it->second : nullptr;
+        }
+
+        const SpvDecorations* getDecorations(uint32_t id) const
+        {
+            auto it = decorations.find(id);
+            return it != decorations.end() ? &it->second : nullptr;
+        }
+
+    private:
+        void parseInstruction_(uint32_t op, const uint32_t* operands, uint32_t count)
+        {
+            switch (op)
+            {
+            case OpEntryPoint:
+                if (count >= 1 && executionModel == UINT32_MAX)
+                {
+                    executionModel = operands[0];
+                }
+                break;
+            case OpTypeInt:
+            case OpTypeFloat:
+            case OpTypeVector:
+            case OpTypeMatrix:
+            case OpTypeSampler:
+            case OpTypeSampledImage:
+            case OpTypeArray:
+            case OpTypeRuntimeArray:
+            case OpTypePointer:
+            case OpTypeAccelerationStructureKHR:
+            {
+                if (count < 1)
+                {
+                    break;
+                }
+                auto& type = types[operands[0]];
+                type.op = op;
+                type.operand0 = count > 1 ? operands[1] : 0;
+                type.operand1 = count > 2 ? operands[2] : 0;
+                break;
+            }
+            case OpTypeImage:
+                if (count >= 7)
+                {
+                    // Result, SampledType, Dim, Depth, Arrayed, MS, Sampled, Format
+                    auto& type = types[operands[0]];
+                    type.op = op;
+                    type.operand0 = operands[1];
+                    type.operand1 = operands[2];
+                    type.operand2 = operands[6];
+                }
+                break;
+            case OpTypeStruct:
+                if (count >= 1)
+                {
+                    auto& type = types[operands[0]];
+                    type.op = op;
+                    type.members.assign(operands + 1, operands + count);
+                }
+                break;
+            case OpConstant:
+                if (count >= 3)
+                {
+                    constants[operands[1]] = operands[2];
+                }
+                break;
+            case OpSpecConstantTrue:
+            case OpSpecConstantFalse:
+            case OpSpecConstant:
+                if (count >= 2)
+                {
+                    // z̒ȂǂɎgꂽꍇ͊lŌvZ
+                    if (op == OpSpecConstant && count >= 3)
+                    {
+                        constants[operands[1]] = operands[2];
+                    }
+                    specConstants.push_back(operands[1]);
+                }
+                break;
+            case OpVariable:
+                if (count >= 3)
+                {
+                    variables.push_back(SpvVariable{ .id = operands[1], .typeId = operands[0], .storageClass = operands[2] });
+                }
+                break;
+            case OpDecorate:
+                if (count >= 2)
+                {
+                    auto& decoration = decorations[operands[0]];
+                    const uint32_t value = count >= 3 ? operands[2] : 0;
+                    switch (operands[1])
+                    {
+                    case DecorationSpecId: decoration.specId = value; decoration.hasSpecId = true; break;
+                    case DecorationBufferBlock: decoration.isBufferBlock = true; break;
+                    case DecorationArrayStride: decoration.arrayStride = value; break;
+                    case DecorationBuiltIn: decoration.isBuiltIn = true; break;
+                    case DecorationLocation: decoration.location = value; decoration.hasLocation = true; break;
+                    case DecorationBinding: decoration.binding = value; decoration.hasBinding = true; break;
+                    case DecorationDescriptorSet: decoration.set = value; break;
+                    default: break;
+                    }
+                }
+                break;
+            case OpMemberDecorate:
+                if (count >= 4 && operands[2] == DecorationOffset)
+                {
+                    auto& offsets = decorations[operands[0]].memberOffsets;
+                    if (offsets.size() <= operands[1])
+                    {
+                        offsets.resize(operands[1] + 1, 0);
+                    }
+                    offsets[operands[1]] = operands[3];
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    };
+
+    //---------------------------------------------------------------------------
+    VkShaderStageFlagBits toShaderStage(uint32_t executionModel)
+    {
+        switch (executionModel)
+        {
+        case ExecutionModelVertex: return VK_SHADER_STAGE_VERTEX_BIT;
+        case ExecutionModelFragment: return VK_SHADER_STAGE_FRAGMENT_BIT;
+        case ExecutionModelGLCompute: return VK_SHADER_STAGE_COMPUTE_BIT;
+        default: return VK_SHADER_STAGE_ALL;
+        }
+    }
+    //---------------------------------------------------------------------------
+    VkFormat toVertexFormat(const SpirvParser& parser, uint32_t typeId, uint32_t& size)
+    {
+        const SpvType* type = parser.getType(typeId);
+        if (type == nullptr)
+        {
+            return VK_FORMAT_UNDEFINED;
+        }
+        uint32_t component_count = 1;
+        if (type->op == OpTypeVector)
+        {
+            component_count = type->operand1;
+            type = parser.getType(type->operand0);
+            if (type == nullptr)
+            {
+                return VK_FORMAT_UNDEFINED;
+            }
+        }
+        // _͂̌`4܂
+        if (component_count < 1 || component_count > 4)
+        {
+            return VK_FORMAT_UNDEFINED;
+        }
+        size = (type->operand0 / 8) * component_count;
+        if (type->op == OpTypeFloat && type->operand0 == 32)
+        {
+            constexpr VkFormat formats[] = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+            return formats[component_count - 1];
+        }
+        if (type->op == OpTypeInt && type->operand0 == 32)
+        {
+            constexpr VkFormat sint_formats[] = { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+            constexpr VkFormat uint_formats[] = { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+            return type->operand1 != 0 ? sint_formats[component_count - 1] : uint_formats[component_count - 1];
+        }
+        return VK_FORMAT_UNDEFINED;
+    }
+}
+//---------------------------------------------------------------------------
+bool ShaderReflection::loadFromFile(const std::string& path)
+{
+    std::vector<uint32_t> storage;
+    const auto code = getShaderSource()->load(path, storage);
+    if (code.empty())
+    {
+        fprintf(stderr, "[ShaderReflection] failed to load %s\n", path.c_str());
+        return false;
+    }
+    if (!reflect(code.data(), code.size()))
+    {
+        fprintf(stderr, "[ShaderReflection] %s is not a valid SPIR-V binary\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+//---------------------------------------------------------------------------
+bool ShaderReflection::reflect(const uint32_t* code, size_t wordCount)
+{
+    mBindings.clear();
+    mPushConstantRanges.clear();
+    mVertexInputs.clear();
+    mSpecializationConstantIds.clear();
+
+    SpirvParser parser;
+    if (!parser.parse(code, wordCount))
+    {
+        return false;
+    }
+    mStage = toShaderStage(parser.executionModel);
+
+    for (const auto& variable : parser.variables)
+    {
+        const SpvType* pointer_type = parser.getType(variable.typeId);
+        if (pointer_type == nullptr || pointer_type->op != OpTypePointer)
+        {
+            continue;
+        }
+        const uint32_t type_id = pointer_type->operand1;
+        const SpvDecorations* decoration = parser.getDecorations(variable.id);
+
+        switch (variable.storageClass)
+        {
+        case StorageClassUniformConstant:
+        case StorageClassUniform:
+        case StorageClassStorageBuffer:
+        {
+            if (decoration == nullptr || !decoration->hasBinding)
+            {
+                continue;
+            }
+            ReflectedBinding binding{
+                .set = decoration->set,
+                .binding = decoration->binding,
+                .stages = VkShaderStageFlags(mStage),
+            };
+
+            // z͗vf̌^Ŕ肷
+            uint32_t element_type_id = type_id;
+            const SpvType* type = parser.getType(type_id);
+            if (type != nullptr && type->op == OpTypeArray)
+            {
+                binding.count = parser.getConstant(type->operand1);
+                element_type_id = type->operand0;
+            }
+            else if (type != nullptr && type->op == OpTypeRuntimeArray)
+            {
+                binding.count = sRuntimeArrayCount;
+                binding.isRuntimeArray = true;
+                element_type_id = type->operand0;
+            }
+            type = parser.getType(element_type_id);
+            if (type == nullptr)
+            {
+                continue;
+            }
+
+            if (variable.storageClass == StorageClassStorageBuffer)
+            {
+                binding.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            }
+            else if (variable.storageClass == StorageClassUniform)
+            {
+                const SpvDecorations* type_decoration = parser.getDecorations(element_type_id);
+                binding.type = type_decoration != nullptr && type_decoration->isBufferBlock
+                    ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+                    : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            }
+            else
+            {
+                switch (type->op)
+                {
+                case OpTypeSampledImage: binding.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER; break;
+                case OpTypeSampler: binding.type = VK_DESCRIPTOR_TYPE_SAMPLER; break;
+                case OpTypeAccelerationStructureKHR: binding.type = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR; break;
+                case OpTypeImage:
+                {
+                    // operand1: Dim, operand2: Sampled (1 = TvO, 2 = Xg[W)
+                    const bool is_storage = type->operand2 == 2;
+                    if (type->operand1 == sDimBuffer)
+                    {
+                        binding.type = is_storage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                    }
+                    else if (type->operand1 == sDimSubpassData)
+                    {
+                        binding.type = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                    }
+                    else
+                    {
+                        binding.type = is_storage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                    }
+                    break;
+                }
+                default:
+                    continue;
+                }
+            }
+            mBindings.push_back(binding);
+            break;
+        }
+        case StorageClassPushConstant:
+        {
+            // o[̍ŏItZbg\̂̏I[܂ł͈͂Ƃ
+            const SpvType* type = parser.getType(type_id);
+            const SpvDecorations* type_decoration = parser.getDecorations(type_id);
+            uint32_t offset = 0;
+            if (type_decoration != nullptr && !type_decoration->memberOffsets.empty())
+            {
+                offset = *std::min_element(type_decoration->memberOffsets.begin(), type_decoration->memberOffsets.end());
+            }
+            const uint32_t size = type != nullptr ? parser.getTypeSize(type_id) : 0;
+            if (size > offset)
+            {
+                mPushConstantRanges.push_back(VkPushConstantRange{
+                    .stageFlags = VkShaderStageFlags(mStage),
+                    .offset = offset,
+                    .size = size - offset,
+                });
+            }
+            break;
+        }
+        case StorageClassInput:
+        {
+            if (mStage != VK_SHADER_STAGE_VERTEX_BIT || decoration == nullptr || decoration->isBuiltIn || !decoration->hasLocation)
+            {
+                continue;
+            }
+            ReflectedVertexInput input{ .location = decoration->location };
+            input.format = toVertexFormat(parser, type_id, input.size);
+            mVertexInputs.push_back(input);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    for (uint32_t id : parser.specConstants)
+    {
+        const SpvDecorations* decoration = parser.getDecorations(id);
+        if (decoration != nullptr && decoration->hasSpecId)
+        {
+            mSpecializationConstantIds.push_back(decoration->specId);
+        }
+    }
+    std::sort(mSpecializationConstantIds.begin(), mSpecializationConstantIds.end());
+
+    std::sort(mBindings.begin(), mBindings.end(), [](const ReflectedBinding& a, const ReflectedBinding& b) {
+        return a.set != b.set ? a.set < b.set : a.binding < b.binding;
+    });
+    std::sort(mVertexInputs.begin(), mVertexInputs.end(), [](const ReflectedVertexInput& a, const ReflectedVertexInput& b) {
+        return a.location < b.location;
+    });
+    return true;
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "GfxDevice.h"
+
+//---------------------------------------------------------------------------
+/*
+ * SPIR-V ǂݎfBXNv^̃oCfBO
+ */
+struct ReflectedBinding
+{
+	uint32_t set = 0;
+	uint32_t binding = 0;
+	VkDescriptorType type = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+	uint32_t count = 1;
+	VkShaderStageFlags stages = 0;
+	bool isRuntimeArray = false;   // vfw̔z (uniform sampler2D textures[] Ȃ)
+};
+//---------------------------------------------------------------------------
+/*
+ * _VF[_[̓ (location )
+ */
+struct ReflectedVertexInput
+{
+	uint32_t location = 0;
+	VkFormat format = VK_FORMAT_UNDEFINED;
+	uint32_t size = 0;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * SPIR-V ̃oCi͂ApCvCCAEg̐ɕKvȏo
+ * OCu͎g킸AKvȖ (^EfR[VEϐ) ǂ
+ */
+class ShaderReflection
+{
+public:
+	// vfw̔zɊ蓖ĂfBXNv^
+	static constexpr uint32_t sRuntimeArrayCount = 1024;
+
+public:
+	/*
+	 * SPIR-V ͂ (sȃoCȉꍇ false)
+	 */
+	bool reflect(const uint32_t* code, size_t wordCount);
+	bool loadFromFile(const std::string& path);
+
+	inline VkShaderStageFlagBits getStage() const { return mStage; }
+	inline const std::vector<ReflectedBinding>& getBindings() const { return mBindings; }
+	inline const std::vector<VkPushConstantRange>& getPushConstantRanges() const { return mPushConstantRanges; }
+	inline const std::vector<ReflectedVertexInput>& getVertexInputs() const { return mVertexInputs; }
+	// 錾Ăꉻ萔 constant_id ()
+	inline const std::vector<uint32_t>& getSpecializationConstantIds() const { return mSpecializationConstantIds; }
+
+private:
+	VkShaderStageFlagBits mStage = VK_SHADER_STAGE_ALL;
+	std::vector<ReflectedBinding> mBindings;
+	std::vector<VkPushConstantRange> mPushConstantRanges;
+	std::vector<ReflectedVertexInput> mVertexInputs;
+	std::vector<uint32_t> mSpecializationConstantIds;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "ShaderSource.h"
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include "FileLoader.h"
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+namespace
+{
+    struct EmbeddedShader
+    {
+        std::string_view path;
+        std::span<const uint32_t> code;
+    };
+}
+
+// EmbeddedShaders.inl ̓rh cmake/EmbedSpirv.cmake 
+// (CMake ̓JX^R}hAVisual Studio ̓rhOCxg $(IntDir) ɏo͂)
+// ĂȂꍇ͑SăfBXNǂ
+#if __has_include("EmbeddedShaders.inl")
+#include "EmbeddedShaders.inl"
+static constexpr std::span<const EmbeddedShader> sEmbeddedShaders = sEmbeddedShaderTable;
+#else
+static constexpr std::span<const EmbeddedShader> sEmbeddedShaders;
+#endif
+
+//---------------------------------------------------------------------------
+static std::span<const uint32_t> findEmbeddedShader(std::string_view path)
+{
+    for (const auto& shader : sEmbeddedShaders)
+    {
+        if (shader.path == path)
+        {
+            return shader.code;
+        }
+    }
+    return {};
+}
+//---------------------------------------------------------------------------
+static std::unique_ptr<ShaderSource> shaderSource = nullptr;
+std::unique_ptr<ShaderSource>& getShaderSource()
+{
+    if (shaderSource == nullptr)
+    {
+        shaderSource = std::make_unique<ShaderSource>();
+        fprintf(stderr, "[ShaderSource] %zu shaders embedded\n", sEmbeddedShaders.size());
+    }
+    return shaderSource;
+}
+//---------------------------------------------------------------------------
+std::span<const uint32_t> ShaderSource::load(const std::string& path, std::vector<uint32_t>& storage)
+{
+    bool is_overridden = false;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        is_overridden = mDiskOverrides.contains(path);
+    }
+    if (!is_overridden)
+    {
+        if (auto code = findEmbeddedShader(path); !code.empty())
+        {
+            mEmbeddedLoadCount++;
+            return code;
+        }
+    }
+
+    std::vector<char> data;
+    if (!getFileLoader()->Load(path, data) || data.empty() || data.size() % sizeof(uint32_t) != 0)
+    {
+        return {};
+    }
+    mDiskLoadCount++;
+    storage.resize(data.size() / sizeof(uint32_t));
+    memcpy(storage.data(), data.data(), data.size());
+    return storage;
+}
+//---------------------------------------------------------------------------
+void ShaderSource::setDiskOverride(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mDiskOverrides.insert(path);
+}
+//---------------------------------------------------------------------------
+bool ShaderSource::isEmbedded(const std::string& path) const
+{
+    return !findEmbeddedShader(path).empty();
+}
+//---------------------------------------------------------------------------
+size_t ShaderSource::getEmbeddedCount() const
+{
+    return sEmbeddedShaders.size();
+}
+//---------------------------------------------------------------------------
+ShaderSource::Stats ShaderSource::getStats() const
+{
+    return Stats{
+        .embeddedCount = static_cast<uint32_t>(sEmbeddedShaders.size()),
+        .embeddedLoadCount = mEmbeddedLoadCount.load(),
+        .diskLoadCount = mDiskLoadCount.load(),
+    };
+}
+//---------------------------------------------------------------------------
+void ShaderSource::drawImGui()
+{
+    const Stats stats = getStats();
+
+    ImGui::SeparatorText("Shader source");
+    ImGui::Text("Embedded shaders: %u", stats.embeddedCount);
+    ImGui::Text("Loads: %llu embedded, %llu disk",
+        static_cast<unsigned long long>(stats.embeddedLoadCount),
+        static_cast<unsigned long long>(stats.diskLoadCount));
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+//---------------------------------------------------------------------------
+class ShaderSource;
+std::unique_ptr<ShaderSource>& getShaderSource();
+
+//---------------------------------------------------------------------------
+/*
+ * VF[_[ SPIR-V ̎擾
+ * res/ ̃VF[_[̓rhɎst@Cɖߍ܂Ă (CMake  cmake/EmbedSpirv.cmakeA
+ * Visual Studio ̓rhOCxgœXNvgĂ)AfBXNǂ܂ɍς
+ * zbg[hō蒼̂▄ߍ܂ĂȂ̂̓fBXNǂݍ
+ */
+class ShaderSource
+{
+public:
+	struct Stats
+	{
+		uint32_t embeddedCount = 0;     // ߍ܂ĂVF[_[̐
+		uint64_t embeddedLoadCount = 0; // ߍ݂Ԃ
+		uint64_t diskLoadCount = 0;     // fBXNǂ񂾉
+	};
+
+public:
+	/*
+	 * path ("res/shader.vert.spv" Ȃ)  SPIR-V 擾
+	 * ߍݍς݂̂̂̓Rs[ɂ̂܂ܕԂAfBXNǂ񂾏ꍇ storage Ɋi[
+	 * Ȃꍇ͋Ԃ
+	 */
+	std::span<const uint32_t> load(const std::string& path, std::vector<uint32_t>& storage);
+
+	/*
+	 * ȍ~ path ̓fBXNǂݍ (zbg[hōăRpCꍇɎg)
+	 */
+	void setDiskOverride(const std::string& path);
+
+	bool isEmbedded(const std::string& path) const;
+	size_t getEmbeddedCount() const;
+
+	Stats getStats() const;
+	void drawImGui();
+
+private:
+	std::mutex mMutex;
+	std::set<std::string> mDiskOverrides;
+	std::atomic<uint64_t> mEmbeddedLoadCount = 0;
+	std::atomic<uint64_t> mDiskLoadCount = 0;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
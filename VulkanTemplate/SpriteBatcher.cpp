@@ -0,0 +1,334 @@
+#include "SpriteBatcher.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "BindlessDescriptors.h"
+#include "OverdrawView.h"
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+static const char* getBlendName(SpriteBlend blend)
+{
+    switch (blend)
+    {
+    case SpriteBlend::Additive: return "Additive";
+    case SpriteBlend::Opaque: return "Opaque";
+    default: return "Alpha";
+    }
+}
+//---------------------------------------------------------------------------
+static VkPipelineColorBlendAttachmentState getBlendState(SpriteBlend blend)
+{
+    const VkColorComponentFlags write_mask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    switch (blend)
+    {
+    case SpriteBlend::Additive:
+        return VkPipelineColorBlendAttachmentState{
+            .blendEnable = VK_TRUE,
+            .srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+            .dstColorBlendFactor = VK_BLEND_FACTOR_ONE,
+            .colorBlendOp = VK_BLEND_OP_ADD,
+            .srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
+            .dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+            .alphaBlendOp = VK_BLEND_OP_ADD,
+            .colorWriteMask = write_mask,
+        };
+    case SpriteBlend::Opaque:
+        return VkPipelineColorBlendAttachmentState{
+            .blendEnable = VK_FALSE,
+            .colorWriteMask = write_mask,
+        };
+    default:
+        return VkPipelineColorBlendAttachmentState{
+            .blendEnable = VK_TRUE,
+            .srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+            .dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+            .colorBlendOp = VK_BLEND_OP_ADD,
+            .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+            .dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+            .alphaBlendOp = VK_BLEND_OP_ADD,
+            .colorWriteMask = write_mask,
+        };
+    }
+}
+//---------------------------------------------------------------------------
+void SpriteBatcher::initialize(GfxDevice* gfx_device, uint32_t frameCount, const GraphicsPipelineDesc& base, VkPipelineLayout overdrawLayout)
+{
+    mGfxDevice = gfx_device;
+    createIndexBuffer_();
+    createVertexRing_(frameCount);
+    mQuads.resize(sMaxSprites);
+    mSortKeys.reserve(sMaxSprites);
+    mQuadCount = 0;
+    mDroppedCount = 0;
+    mFrameIndex = 0;
+    mStats = Stats{};
+
+    GraphicsPipelineDesc desc = base;
+    desc.vertexShader = "res/sprite.vert.spv";
+    desc.fragmentShader = "res/sprite.frag.spv";
+    desc.permutation = ShaderPermutation{};
+    desc.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    // Cӂ̎lp`󂯕t̂ŕ\͋CɂȂ
+    desc.cullMode = VK_CULL_MODE_NONE;
+    desc.vertexBindings = {
+        VkVertexInputBindingDescription{ .binding = 0, .stride = sizeof(SpriteVertex), .inputRate = VK_VERTEX_INPUT_RATE_VERTEX },
+    };
+    desc.vertexAttributes = {
+        VkVertexInputAttributeDescription{ .location = 0, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT, .offset = offsetof(SpriteVertex, position) },
+        VkVertexInputAttributeDescription{ .location = 1, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT, .offset = offsetof(SpriteVertex, texcoord) },
+        VkVertexInputAttributeDescription{ .location = 2, .binding = 0, .format = VK_FORMAT_R8G8B8A8_UNORM, .offset = offsetof(SpriteVertex, color) },
+    };
+    auto& pipeline_manager = getPipelineManager();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(SpriteBlend::Count); ++i)
+    {
+        const SpriteBlend blend = static_cast<SpriteBlend>(i);
+        desc.colorBlend = getBlendState(blend);
+        desc.debugName = std::string("Sprite") + getBlendName(blend) + "Pipeline";
+        mDescs[i] = desc;
+        mPipelines[i] = pipeline_manager->requestPipeline(desc);
+        // uh͖ɂ̂Œg͓ɂȂAPipelineManager 1ɂ܂Ƃ߂
+        if (overdrawLayout != VK_NULL_HANDLE)
+        {
+            mOverdrawDescs[i] = OverdrawView::makePipelineDesc(desc, overdrawLayout);
+            mOverdrawPipelines[i] = pipeline_manager->requestPipeline(mOverdrawDescs[i]);
+        }
+    }
+}
+//---------------------------------------------------------------------------
+void SpriteBatcher::shutdown()
+{
+    if (mGfxDevice == nullptr)
+    {
+        return;
+    }
+    vkUnmapMemory(mGfxDevice->getVkDevice(), mVertexMemory);
+    mVertices = nullptr;
+    mGfxDevice->destroyBuffer(mVertexBuffer, mVertexMemory);
+    mGfxDevice->destroyBuffer(mIndexBuffer, mIndexMemory);
+    mQuads.clear();
+    mSortKeys.clear();
+    mGfxDevice = nullptr;
+}
+//---------------------------------------------------------------------------
+void SpriteBatcher::beginFrame(uint32_t frameIndex)
+{
+    mFrameIndex = frameIndex;
+    mQuadCount.store(0, std::memory_order_relaxed);
+    mDroppedCount.store(0, std::memory_order_relaxed);
+}
+//---------------------------------------------------------------------------
+bool SpriteBatcher::draw(const Sprite& sprite)
+{
+    // ]͌ĂяoXbhŌvZĂ
+    const float s = std::sin(sprite.rotation);
+    const float c = std::cos(sprite.rotation);
+    const glm::vec2 half = sprite.size * 0.5f;
+    auto to_world = [&](float x, float y) {
+        return sprite.position + glm::vec2(x * c - y * s, x * s + y * c);
+    };
+    const glm::vec4& uv = sprite.uvRect;
+    return draw(SpriteQuad{
+        .positions = { to_world(-half.x, -half.y), to_world(half.x, -half.y), to_world(half.x, half.y), to_world(-half.x, half.y) },
+        .texcoords = { glm::vec2(uv.x, uv.y), glm::vec2(uv.z, uv.y), glm::vec2(uv.z, uv.w), glm::vec2(uv.x, uv.w) },
+        .color = sprite.color,
+        .textureIndex = sprite.textureIndex,
+        .samplerIndex = sprite.samplerIndex,
+        .blend = sprite.blend,
+        .layer = sprite.layer,
+    });
+}
+//---------------------------------------------------------------------------
+bool SpriteBatcher::draw(const SpriteQuad& quad)
+{
+    const uint32_t index = mQuadCount.fetch_add(1, std::memory_order_relaxed);
+    if (index >= sMaxSprites)
+    {
+        mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    mQuads[index] = quad;
+    return true;
+}
+//---------------------------------------------------------------------------
+void SpriteBatcher::flush(VkCommandBuffer commandBuffer, DynamicStateCache& dynamicState, VkPipelineLayout layout, VkExtent2D extent, bool isOverdraw)
+{
+    const auto flush_start = std::chrono::steady_clock::now();
+    const uint32_t count = std::min(mQuadCount.load(std::memory_order_acquire), sMaxSprites);
+
+    mStats = Stats{};
+    mStats.droppedCount = mDroppedCount.load(std::memory_order_relaxed);
+    if (count == 0)
+    {
+        return;
+    }
+
+    mSortKeys.clear();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        mSortKeys.emplace_back(makeSortKey_(mQuads[i]), i);
+    }
+    std::sort(mSortKeys.begin(), mSortKeys.end());
+
+    // ̃t[̗̈ɕבւŏ (}bv͐擪珇ɏɂ)
+    const uint32_t frame_first_vertex = mFrameIndex * sMaxSprites * 4;
+    SpriteVertex* dst = mVertices + frame_first_vertex;
+    for (const auto& [key, index] : mSortKeys)
+    {
+        const SpriteQuad& quad = mQuads[index];
+        for (uint32_t corner = 0; corner < 4; ++corner)
+        {
+            *dst++ = SpriteVertex{ .position = quad.positions[corner], .texcoord = quad.texcoords[corner], .color = quad.color };
+        }
+    }
+
+    const VkDeviceSize vertex_offset = VkDeviceSize(frame_first_vertex) * sizeof(SpriteVertex);
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &mVertexBuffer, &vertex_offset);
+    vkCmdBindIndexBuffer(commandBuffer, mIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+    // uhƃeNX`͈̂͂1ŕ` (C[ςĂԂȂ瑱Ă悢)
+    SpriteBlend bound_blend = SpriteBlend::Count;
+    BindlessDrawConstants bound_constants{ .textureIndex = UINT32_MAX, .samplerIndex = UINT32_MAX };
+    uint32_t run_start = 0;
+    while (run_start < count)
+    {
+        const SpriteQuad& first = mQuads[mSortKeys[run_start].second];
+        uint32_t run_end = run_start + 1;
+        while (run_end < count)
+        {
+            const SpriteQuad& next = mQuads[mSortKeys[run_end].second];
+            if (next.blend != first.blend || next.textureIndex != first.textureIndex || next.samplerIndex != first.samplerIndex)
+            {
+                break;
+            }
+            run_end++;
+        }
+
+        const uint32_t blend_index = static_cast<uint32_t>(first.blend);
+        VkPipeline pipeline = isOverdraw ? mOverdrawPipelines[blend_index].get() : mPipelines[blend_index].get();
+        if (pipeline != VK_NULL_HANDLE)
+        {
+            if (first.blend != bound_blend)
+            {
+                dynamicState.bindPipeline(pipeline);
+                dynamicState.setPipelineState(isOverdraw ? mOverdrawDescs[blend_index] : mDescs[blend_index], extent);
+                bound_blend = first.blend;
+                mStats.pipelineBindCount++;
+            }
+            if (first.textureIndex != bound_constants.textureIndex || first.samplerIndex != bound_constants.samplerIndex)
+            {
+                bound_constants.textureIndex = first.textureIndex;
+                bound_constants.samplerIndex = first.samplerIndex;
+                vkCmdPushConstants(commandBuffer, layout, BindlessDescriptors::getPushConstantRange().stageFlags, 0, sizeof(bound_constants), &bound_constants);
+                mStats.textureChangeCount++;
+            }
+            const uint32_t sprite_count = run_end - run_start;
+            vkCmdDrawIndexed(commandBuffer, sprite_count * 6, 1, run_start * 6, 0, 0);
+            mStats.spriteCount += sprite_count;
+            mStats.drawCount++;
+        }
+        run_start = run_end;
+    }
+
+    mStats.flushUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - flush_start).count();
+}
+//---------------------------------------------------------------------------
+uint64_t SpriteBatcher::makeSortKey_(const SpriteQuad& quad)
+{
+    // C[ 16bit | uh 4bit | Tv[ 12bit | eNX` 32bit
+    return (uint64_t(quad.layer) << 48) |
+        (uint64_t(static_cast<uint32_t>(quad.blend) & 0xf) << 44) |
+        (uint64_t(quad.samplerIndex & 0xfff) << 32) |
+        uint64_t(quad.textureIndex);
+}
+//---------------------------------------------------------------------------
+void SpriteBatcher::createIndexBuffer_()
+{
+    // _4Ԃ̂ŁACfbNX͖t[ɂȂ
+    std::vector<uint32_t> indices(size_t(sMaxSprites) * 6);
+    for (uint32_t i = 0; i < sMaxSprites; ++i)
+    {
+        const uint32_t base = i * 4;
+        uint32_t* dst = &indices[size_t(i) * 6];
+        dst[0] = base + 0;
+        dst[1] = base + 1;
+        dst[2] = base + 2;
+        dst[3] = base + 2;
+        dst[4] = base + 3;
+        dst[5] = base + 0;
+    }
+    const VkDeviceSize size = indices.size() * sizeof(uint32_t);
+    auto device = mGfxDevice->getVkDevice();
+
+    VkBuffer staging_buffer = VK_NULL_HANDLE;
+    VkDeviceMemory staging_memory = VK_NULL_HANDLE;
+    mGfxDevice->createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, staging_buffer, staging_memory);
+    void* data = nullptr;
+    vkMapMemory(device, staging_memory, 0, size, 0, &data);
+    memcpy(data, indices.data(), size);
+    vkUnmapMemory(device, staging_memory);
+
+    mGfxDevice->createBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mIndexBuffer, mIndexMemory);
+    mGfxDevice->setObjectName(uint64_t(mIndexBuffer), "SpriteIndices", VK_OBJECT_TYPE_BUFFER);
+
+    // N1xȂ̂ŁA]̊҂Ă܂
+    VkCommandBufferAllocateInfo allocate_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .commandPool = mGfxDevice->getCommandPool(),
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = 1,
+    };
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    vkAllocateCommandBuffers(device, &allocate_info, &command_buffer);
+    VkCommandBufferBeginInfo begin_info{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+    VkBufferCopy copy_region{
+        .srcOffset = 0,
+        .dstOffset = 0,
+        .size = size,
+    };
+    vkCmdCopyBuffer(command_buffer, staging_buffer, mIndexBuffer, 1, &copy_region);
+    vkEndCommandBuffer(command_buffer);
+    VkSubmitInfo submit_info{
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &command_buffer,
+    };
+    vkQueueSubmit(mGfxDevice->getGraphicsQueue(), 1, &submit_info, VK_NULL_HANDLE);
+    vkQueueWaitIdle(mGfxDevice->getGraphicsQueue());
+    vkFreeCommandBuffers(device, mGfxDevice->getCommandPool(), 1, &command_buffer);
+
+    mGfxDevice->destroyBuffer(staging_buffer, staging_memory);
+}
+//---------------------------------------------------------------------------
+void SpriteBatcher::createVertexRing_(uint32_t frameCount)
+{
+    const VkDeviceSize size = VkDeviceSize(frameCount) * sMaxSprites * 4 * sizeof(SpriteVertex);
+    mGfxDevice->createBuffer(size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, mVertexBuffer, mVertexMemory);
+    mGfxDevice->setObjectName(uint64_t(mVertexBuffer), "SpriteVertexRing", VK_OBJECT_TYPE_BUFFER);
+    void* data = nullptr;
+    if (vkMapMemory(mGfxDevice->getVkDevice(), mVertexMemory, 0, size, 0, &data) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to map sprite vertex buffer!");
+    }
+    mVertices = static_cast<SpriteVertex*>(data);
+}
+//---------------------------------------------------------------------------
+void SpriteBatcher::drawImGui()
+{
+    ImGui::SeparatorText("Sprite batcher");
+    ImGui::Text("Sprites: %u  Dropped: %u", mStats.spriteCount, mStats.droppedCount);
+    ImGui::Text("Draws: %u  Pipeline binds: %u  Texture changes: %u", mStats.drawCount, mStats.pipelineBindCount, mStats.textureChangeCount);
+    ImGui::Text("Flush: %.2f us", mStats.flushUs);
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
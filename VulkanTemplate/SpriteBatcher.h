@@ -0,0 +1,158 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <utility>
+#include <vector>
+#include "glm/glm.hpp"
+#include "GfxDevice.h"
+#include "PipelineManager.h"
+#include "DynamicStateCache.h"
+
+//---------------------------------------------------------------------------
+/*
+ * XvCg̃uh (ޖɃpCvC1)
+ */
+enum class SpriteBlend : uint32_t
+{
+	Alpha,     // ʏ̔
+	Additive,  // Z
+	Opaque,    // uhȂ
+	Count,
+};
+
+//---------------------------------------------------------------------------
+/*
+ * _obt@ɏޒ_ (res/sprite.vert ̓͂ƍ킹邱)
+ */
+struct SpriteVertex
+{
+	glm::vec2 position;  // Nbv
+	glm::vec2 texcoord;
+	uint32_t color;      // RGBA8 (R ŉʃoCg)
+};
+
+//---------------------------------------------------------------------------
+/*
+ * Cӂ̎lp` (p͍, E, E, ̏)
+ */
+struct SpriteQuad
+{
+	std::array<glm::vec2, 4> positions;
+	std::array<glm::vec2, 4> texcoords;
+	uint32_t color = 0xffffffff;
+	// BindlessDescriptors ɓo^ԍ
+	uint32_t textureIndex = 0;
+	uint32_t samplerIndex = 0;
+	SpriteBlend blend = SpriteBlend::Alpha;
+	// ɕ` (C[̒ł̓eNX`ƃuhɂ܂Ƃ߂̂ŏ͕ۏ؂Ȃ)
+	uint16_t layer = 0;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * ]Eg債XvCg (eNX`̈ꕔ؂o)
+ */
+struct Sprite
+{
+	glm::vec2 position{ 0.0f };  // S (Nbv)
+	glm::vec2 size{ 0.0f };
+	float rotation = 0.0f;       // WA
+	glm::vec4 uvRect{ 0.0f, 0.0f, 1.0f, 1.0f };  // u0, v0, u1, v1
+	uint32_t color = 0xffffffff;
+	uint32_t textureIndex = 0;
+	uint32_t samplerIndex = 0;
+	SpriteBlend blend = SpriteBlend::Alpha;
+	uint16_t layer = 0;
+};
+
+//---------------------------------------------------------------------------
+/*
+ * c[ HUD ̑[h 2D `
+ * XvCgɃobt@炸At[_ݒ
+ *
+ * draw ͂ǂ̃XbhłĂׂ (ݐ̓Ag~bNȃJE^Ŋmۂ邾ŃbNȂ)
+ * ]Ȃǂ̒_̌vZ͌ĂяoXbhōς܂Ă
+ * flush ŃC[EuhETv[EeNX`̏ɕבւÂ͈͂1 vkCmdDrawIndexed ŕ`
+ * pCvC̓uhς鎞AeNX`̔ԍ (vbV萔) ͔ԍς鎞ݒ肷
+ *
+ * _obt@̓t[ReLXgɕOŁAiIɃ}bvĂ
+ * בւɏނ̂ŁA`斈͈̔͂͏ɘAACfbNXobt@͋NɍŒ̂̂g񂹂
+ * 1t[ɕ`̂ sMaxSprites ܂łŁAꂽ͕`Ȃ (getStats  droppedCount)
+ */
+class SpriteBatcher
+{
+public:
+	static constexpr uint32_t sMaxSprites = 65536;
+
+	struct Stats
+	{
+		uint32_t spriteCount = 0;    // Oɕ`XvCg
+		uint32_t droppedCount = 0;   // Õt[ňꂽXvCg
+		uint32_t drawCount = 0;
+		uint32_t pipelineBindCount = 0;
+		uint32_t textureChangeCount = 0;
+		double flushUs = 0.0;        // בւƒ_̏݁AL^ɂ CPU 
+	};
+
+public:
+	/*
+	 * base ̃VF[_[ƒ_́AuhւpCvCuh̎ޖɍ
+	 * base ̃pCvCCAEg̓Zbg 0  BindlessDescriptors ̃ZbgŁABindlessDrawConstants ̃vbV萔
+	 * overdrawLayout nƃI[o[h[vp̃oAg (OverdrawView::makePipelineDesc)
+	 */
+	void initialize(GfxDevice* gfx_device, uint32_t frameCount, const GraphicsPipelineDesc& base, VkPipelineLayout overdrawLayout = VK_NULL_HANDLE);
+	void shutdown();
+	inline bool isInitialized() const { return mGfxDevice != nullptr; }
+
+	/*
+	 * frameIndex ̃t[̎󂯕tn߂
+	 * ̃t[̃CtCgtFX҂Adraw ĂԃXbhĂȂɌĂԂ
+	 */
+	void beginFrame(uint32_t frameIndex);
+	/*
+	 * XbhZ[t (t̏ꍇ false Ԃ)
+	 */
+	bool draw(const Sprite& sprite);
+	bool draw(const SpriteQuad& quad);
+	/*
+	 * 󂯕tXvCg`悷
+	 * SẴXbh draw IɌĂԂ (oChX̃Zbg͌ς݂ł邱)
+	 * isOverdraw ̏ꍇ̓I[o[h[vp̃oAgŕ` (I[o[h[̃Zbg͌ς݂ł邱)
+	 */
+	void flush(VkCommandBuffer commandBuffer, DynamicStateCache& dynamicState, VkPipelineLayout layout, VkExtent2D extent, bool isOverdraw = false);
+
+	inline const Stats& getStats() const { return mStats; }
+	// SpriteVertex 𒸓_͂ɂpCvC̋Lq (̕`ŃXvCg̃VF[_[gꍇ)
+	inline const GraphicsPipelineDesc& getPipelineDesc(SpriteBlend blend) const { return mDescs[static_cast<size_t>(blend)]; }
+	void drawImGui();
+
+private:
+	void createIndexBuffer_();
+	void createVertexRing_(uint32_t frameCount);
+	static uint64_t makeSortKey_(const SpriteQuad& quad);
+
+private:
+	GfxDevice* mGfxDevice = nullptr;
+	std::array<GraphicsPipelineDesc, static_cast<size_t>(SpriteBlend::Count)> mDescs;
+	std::array<PipelineHandle, static_cast<size_t>(SpriteBlend::Count)> mPipelines;
+	std::array<GraphicsPipelineDesc, static_cast<size_t>(SpriteBlend::Count)> mOverdrawDescs;
+	std::array<PipelineHandle, static_cast<size_t>(SpriteBlend::Count)> mOverdrawPipelines;
+
+	// SẴXvCgŋL 0,1,2, 2,3,0 ̌JԂ
+	VkBuffer mIndexBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory mIndexMemory = VK_NULL_HANDLE;
+	// t[ReLXg sMaxSprites * 4 _̗̈
+	VkBuffer mVertexBuffer = VK_NULL_HANDLE;
+	VkDeviceMemory mVertexMemory = VK_NULL_HANDLE;
+	SpriteVertex* mVertices = nullptr;
+	uint32_t mFrameIndex = 0;
+
+	// 󂯕tXvCg (draw  mQuadCount i߂ċ󂢂Ăvfɏ)
+	std::vector<SpriteQuad> mQuads;
+	std::atomic<uint32_t> mQuadCount = 0;
+	std::atomic<uint32_t> mDroppedCount = 0;
+	// בւp (\[gL[ mQuads ̓Y̑g)
+	std::vector<std::pair<uint64_t, uint32_t>> mSortKeys;
+	Stats mStats;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
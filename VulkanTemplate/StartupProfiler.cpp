@@ -0,0 +1,123 @@
+#include "StartupProfiler.h"
+#include <cstdio>
+#include <sstream>
+#include "FileLoader.h"
+
+//---------------------------------------------------------------------------
+static std::unique_ptr<StartupProfiler> startupProfiler = nullptr;
+std::unique_ptr<StartupProfiler>& getStartupProfiler()
+{
+    if (startupProfiler == nullptr)
+    {
+        startupProfiler = std::make_unique<StartupProfiler>();
+    }
+    return startupProfiler;
+}
+//---------------------------------------------------------------------------
+StartupProfiler::StartupProfiler()
+    : mStartTime(Clock::now())
+{
+}
+//---------------------------------------------------------------------------
+void StartupProfiler::beginPhase(const char* name)
+{
+    if (mIsFinished)
+    {
+        return;
+    }
+    Phase phase{
+        .name = name,
+        .depth = static_cast<uint32_t>(mPhaseStack.size()),
+        .startMs = getElapsedMs(),
+    };
+    mPhaseStack.push_back(mPhases.size());
+    mPhases.push_back(std::move(phase));
+}
+//---------------------------------------------------------------------------
+void StartupProfiler::endPhase()
+{
+    if (mIsFinished || mPhaseStack.empty())
+    {
+        return;
+    }
+    auto& phase = mPhases[mPhaseStack.back()];
+    phase.durationMs = getElapsedMs() - phase.startMs;
+    mPhaseStack.pop_back();
+}
+//---------------------------------------------------------------------------
+void StartupProfiler::addReportSection(const char* key, SectionWriter writer)
+{
+    mSections.push_back(ReportSection{ .key = key, .writer = std::move(writer) });
+}
+//---------------------------------------------------------------------------
+double StartupProfiler::getElapsedMs() const
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - mStartTime).count();
+}
+//---------------------------------------------------------------------------
+void StartupProfiler::finish(bool isBenchmark)
+{
+    if (mIsFinished)
+    {
+        return;
+    }
+    // ĂȂtF[Y͂ŏI
+    while (!mPhaseStack.empty())
+    {
+        endPhase();
+    }
+    mTotalMs = getElapsedMs();
+    mIsFinished = true;
+
+    writeLog_();
+    writeJson_(isBenchmark);
+}
+//---------------------------------------------------------------------------
+void StartupProfiler::writeLog_() const
+{
+    for (const auto& phase : mPhases)
+    {
+        fprintf(stderr, "[startup] phase=\"%s\" depth=%u start_ms=%.3f duration_ms=%.3f share=%.1f%%\n",
+            phase.name.c_str(),
+            phase.depth,
+            phase.startMs,
+            phase.durationMs,
+            mTotalMs > 0.0 ? phase.durationMs * 100.0 / mTotalMs : 0.0);
+    }
+    fprintf(stderr, "[startup] total_ms=%.3f\n", mTotalMs);
+}
+//---------------------------------------------------------------------------
+void StartupProfiler::writeJson_(bool isBenchmark) const
+{
+    std::ostringstream out;
+    char buf[512];
+    out << "{\n";
+    snprintf(buf, sizeof(buf), "  \"benchmark\": %s,\n  \"total_ms\": %.3f,\n", isBenchmark ? "true" : "false", mTotalMs);
+    out << buf;
+    out << "  \"phases\": [\n";
+    for (size_t i = 0; i < mPhases.size(); ++i)
+    {
+        const auto& phase = mPhases[i];
+        snprintf(buf, sizeof(buf), "    { \"name\": \"%s\", \"depth\": %u, \"start_ms\": %.3f, \"duration_ms\": %.3f }%s\n",
+            phase.name.c_str(),
+            phase.depth,
+            phase.startMs,
+            phase.durationMs,
+            i + 1 < mPhases.size() ? "," : "");
+        out << buf;
+    }
+    out << "  ]";
+    for (const auto& section : mSections)
+    {
+        out << ",\n  \"" << section.key << "\": ";
+        section.writer(out);
+    }
+    out << "\n}\n";
+
+    // ݓr̃t@Cǂ܂Ȃ悤ꎞt@Cu
+    if (!getFileLoader()->WriteAtomic(sReportPath, out.str()))
+    {
+        fprintf(stderr, "[startup] failed to write %s\n", sReportPath);
+    }
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//---------------------------------------------------------------------------
+class StartupProfiler;
+std::unique_ptr<StartupProfiler>& getStartupProfiler();
+
+//---------------------------------------------------------------------------
+/*
+ * ÑtF[Y̏vԂv
+ * ʂ̓O JSON t@C(startup_report.json)ɏo͂
+ */
+class StartupProfiler
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Phase
+	{
+		std::string name;
+		uint32_t depth = 0;
+		double startMs = 0.0;
+		double durationMs = 0.0;
+	};
+
+	/*
+	 * XR[v𔲂ƃtF[YI
+	 */
+	class ScopedPhase
+	{
+	public:
+		ScopedPhase(StartupProfiler* profiler, const char* name) : mProfiler(profiler) { mProfiler->beginPhase(name); }
+		~ScopedPhase() { mProfiler->endPhase(); }
+		ScopedPhase(const ScopedPhase&) = delete;
+		ScopedPhase& operator=(const ScopedPhase&) = delete;
+	private:
+		StartupProfiler* mProfiler;
+	};
+
+public:
+	StartupProfiler();
+
+	void beginPhase(const char* name);
+	void endPhase();
+	inline ScopedPhase scopedPhase(const char* name) { return ScopedPhase(this, name); }
+
+	/*
+	 * ̃W[̌vʂ JSON ɒǉ
+	 * writer  finish ɌĂ΂A"key": ɑl
+	 */
+	using SectionWriter = std::function<void(std::ostream& out)>;
+	void addReportSection(const char* key, SectionWriter writer);
+
+	/*
+	 * vIăO JSON o
+	 */
+	void finish(bool isBenchmark);
+
+	inline bool isFinished() const { return mIsFinished; }
+	inline const std::vector<Phase>& getPhases() const { return mPhases; }
+	double getElapsedMs() const;
+
+	static constexpr const char* sReportPath = "startup_report.json";
+
+private:
+	void writeLog_() const;
+	void writeJson_(bool isBenchmark) const;
+
+private:
+	struct ReportSection
+	{
+		std::string key;
+		SectionWriter writer;
+	};
+
+	Clock::time_point mStartTime;
+	std::vector<Phase> mPhases;
+	std::vector<ReportSection> mSections;
+	std::vector<size_t> mPhaseStack;
+	double mTotalMs = 0.0;
+	bool mIsFinished = false;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
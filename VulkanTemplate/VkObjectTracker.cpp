@@ -0,0 +1,286 @@
+#include "VkObjectTracker.h"
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include "imgui.h"
+
+//---------------------------------------------------------------------------
+static std::unique_ptr<VkObjectTracker> objectTracker = nullptr;
+std::unique_ptr<VkObjectTracker>& getVkObjectTracker()
+{
+    if (objectTracker == nullptr)
+    {
+        objectTracker = std::make_unique<VkObjectTracker>();
+    }
+    return objectTracker;
+}
+//---------------------------------------------------------------------------
+// SteadyStateExemption ̓q̐[
+static thread_local uint32_t exemptionDepth = 0;
+
+VkObjectTracker::SteadyStateExemption::SteadyStateExemption()
+{
+    exemptionDepth++;
+}
+VkObjectTracker::SteadyStateExemption::~SteadyStateExemption()
+{
+    exemptionDepth--;
+}
+//---------------------------------------------------------------------------
+void VkObjectTracker::onCreateImpl_(uint64_t handle, VkObjectType type, uint64_t bytes, const std::source_location& site)
+{
+    if (handle == 0)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto& stats = mTypeStats[type];
+    auto [it, inserted] = mObjects.try_emplace(ObjectKey{ handle, type });
+    auto& object = it->second;
+    if (!inserted)
+    {
+        // jL^Ȃ܂ܓnhėpꂽ
+        stats.liveCount--;
+        stats.liveBytes -= object.bytes;
+    }
+    object.type = type;
+    object.bytes = bytes;
+    object.createdFrame = mFrameIndex;
+    object.site = site;
+    object.name.clear();
+    object.isExempt = exemptionDepth > 0;
+
+    stats.liveCount++;
+    stats.liveBytes += bytes;
+    stats.createdThisFrame++;
+    mCreatedThisFrame++;
+    if (object.isExempt)
+    {
+        mExemptThisFrame++;
+    }
+}
+//---------------------------------------------------------------------------
+void VkObjectTracker::onDestroyImpl_(uint64_t handle, VkObjectType type)
+{
+    if (handle == 0)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto it = mObjects.find(ObjectKey{ handle, type });
+    if (it == mObjects.end())
+    {
+        // gbLOΏۊOŐꂽ
+        return;
+    }
+    auto& stats = mTypeStats[type];
+    stats.liveCount--;
+    stats.liveBytes -= it->second.bytes;
+    stats.destroyedThisFrame++;
+    mDestroyedThisFrame++;
+    mObjects.erase(it);
+}
+//---------------------------------------------------------------------------
+void VkObjectTracker::setName(uint64_t handle, const char* name, VkObjectType type)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto it = mObjects.find(ObjectKey{ handle, type });
+    if (it != mObjects.end())
+    {
+        it->second.name = name != nullptr ? name : "";
+    }
+}
+//---------------------------------------------------------------------------
+void VkObjectTracker::beginFrame()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mCreatedThisFrame = 0;
+    mExemptThisFrame = 0;
+    mDestroyedThisFrame = 0;
+    for (auto& [type, stats] : mTypeStats)
+    {
+        stats.createdThisFrame = 0;
+        stats.destroyedThisFrame = 0;
+    }
+}
+//---------------------------------------------------------------------------
+void VkObjectTracker::endFrame()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    const bool is_steady_state = mFrameIndex >= mSteadyStateFrame;
+    const uint64_t frame_index = mFrameIndex++;
+    if (!is_steady_state || mCreatedThisFrame == mExemptThisFrame)
+    {
+        return;
+    }
+
+    // Ԃ̃t[ŐꂽIuWFNgo
+    for (const auto& [key, object] : mObjects)
+    {
+        if (object.createdFrame != frame_index || object.isExempt)
+        {
+            continue;
+        }
+        fprintf(stderr, "[VkObjectTracker] frame %llu: %s 0x%llx \"%s\" created at %s:%u\n",
+            static_cast<unsigned long long>(frame_index),
+            getTypeName(object.type),
+            static_cast<unsigned long long>(key.handle),
+            object.name.c_str(),
+            object.site.file_name(),
+            object.site.line());
+    }
+    if (mThrowOnViolation)
+    {
+        throw std::runtime_error("vulkan objects were created in a steady-state frame!");
+    }
+}
+//---------------------------------------------------------------------------
+void VkObjectTracker::setThrowOnViolation(bool isEnabled)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mThrowOnViolation = isEnabled;
+}
+//---------------------------------------------------------------------------
+void VkObjectTracker::resetSteadyState()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSteadyStateFrame = mFrameIndex + sWarmupFrames;
+}
+//---------------------------------------------------------------------------
+void VkObjectTracker::drawImGui()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    ImGui::Begin("Vulkan Objects");
+    ImGui::Text("Frame: %llu (%s)",
+        static_cast<unsigned long long>(mFrameIndex),
+        mFrameIndex >= mSteadyStateFrame ? "steady" : "warmup");
+    ImGui::Text("Churn: +%u (exempt %u) / -%u", mCreatedThisFrame, mExemptThisFrame, mDestroyedThisFrame);
+
+    if (ImGui::BeginTable("types", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("Type");
+        ImGui::TableSetupColumn("Live");
+        ImGui::TableSetupColumn("KiB");
+        ImGui::TableSetupColumn("+/frame");
+        ImGui::TableSetupColumn("-/frame");
+        ImGui::TableHeadersRow();
+        for (const auto& [type, stats] : mTypeStats)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(getTypeName(type));
+            ImGui::TableNextColumn(); ImGui::Text("%u", stats.liveCount);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", stats.liveBytes / 1024.0);
+            ImGui::TableNextColumn(); ImGui::Text("%u", stats.createdThisFrame);
+            ImGui::TableNextColumn(); ImGui::Text("%u", stats.destroyedThisFrame);
+        }
+        ImGui::EndTable();
+    }
+
+    if (ImGui::TreeNode("Live objects"))
+    {
+        for (const auto& [key, object] : mObjects)
+        {
+            ImGui::Text("%s 0x%llx \"%s\" %s:%u",
+                getTypeName(object.type),
+                static_cast<unsigned long long>(key.handle),
+                object.name.c_str(),
+                object.site.file_name(),
+                object.site.line());
+        }
+        ImGui::TreePop();
+    }
+    ImGui::End();
+}
+//---------------------------------------------------------------------------
+void VkObjectTracker::reportLiveObjects()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (mObjects.empty())
+    {
+        return;
+    }
+
+    // ӏł܂Ƃ߂ďo͂
+    std::vector<std::pair<uint64_t, const ObjectInfo*>> objects;
+    objects.reserve(mObjects.size());
+    for (const auto& [key, object] : mObjects)
+    {
+        objects.emplace_back(key.handle, &object);
+    }
+    std::sort(objects.begin(), objects.end(), [](const auto& a, const auto& b) {
+        if (a.second->type != b.second->type)
+        {
+            return a.second->type < b.second->type;
+        }
+        return a.second->createdFrame < b.second->createdFrame;
+    });
+
+    fprintf(stderr, "[VkObjectTracker] %zu vulkan objects still alive\n", objects.size());
+    for (const auto& [handle, object] : objects)
+    {
+        fprintf(stderr, "  %s 0x%llx \"%s\" %llu bytes, created at %s:%u (frame %llu)\n",
+            getTypeName(object->type),
+            static_cast<unsigned long long>(handle),
+            object->name.c_str(),
+            static_cast<unsigned long long>(object->bytes),
+            object->site.file_name(),
+            object->site.line(),
+            static_cast<unsigned long long>(object->createdFrame));
+    }
+}
+//---------------------------------------------------------------------------
+uint64_t VkObjectTracker::getLiveBytes(VkObjectType type)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto it = mTypeStats.find(type);
+    return it != mTypeStats.end() ? it->second.liveBytes : 0;
+}
+//---------------------------------------------------------------------------
+uint32_t VkObjectTracker::getLiveCount()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return static_cast<uint32_t>(mObjects.size());
+}
+//---------------------------------------------------------------------------
+const char* VkObjectTracker::getTypeName(VkObjectType type)
+{
+    switch (type)
+    {
+    case VK_OBJECT_TYPE_SEMAPHORE: return "Semaphore";
+    case VK_OBJECT_TYPE_COMMAND_BUFFER: return "CommandBuffer";
+    case VK_OBJECT_TYPE_FENCE: return "Fence";
+    case VK_OBJECT_TYPE_DEVICE_MEMORY: return "DeviceMemory";
+    case VK_OBJECT_TYPE_BUFFER: return "Buffer";
+    case VK_OBJECT_TYPE_IMAGE: return "Image";
+    case VK_OBJECT_TYPE_EVENT: return "Event";
+    case VK_OBJECT_TYPE_QUERY_POOL: return "QueryPool";
+    case VK_OBJECT_TYPE_BUFFER_VIEW: return "BufferView";
+    case VK_OBJECT_TYPE_IMAGE_VIEW: return "ImageView";
+    case VK_OBJECT_TYPE_SHADER_MODULE: return "ShaderModule";
+    case VK_OBJECT_TYPE_PIPELINE_CACHE: return "PipelineCache";
+    case VK_OBJECT_TYPE_PIPELINE_LAYOUT: return "PipelineLayout";
+    case VK_OBJECT_TYPE_RENDER_PASS: return "RenderPass";
+    case VK_OBJECT_TYPE_PIPELINE: return "Pipeline";
+    case VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT: return "DescriptorSetLayout";
+    case VK_OBJECT_TYPE_SAMPLER: return "Sampler";
+    case VK_OBJECT_TYPE_DESCRIPTOR_POOL: return "DescriptorPool";
+    case VK_OBJECT_TYPE_DESCRIPTOR_SET: return "DescriptorSet";
+    case VK_OBJECT_TYPE_FRAMEBUFFER: return "Framebuffer";
+    case VK_OBJECT_TYPE_COMMAND_POOL: return "CommandPool";
+    case VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE: return "DescriptorUpdateTemplate";
+    case VK_OBJECT_TYPE_SWAPCHAIN_KHR: return "SwapchainKHR";
+    case VK_OBJECT_TYPE_SHADER_EXT: return "ShaderEXT";
+    default: return "Unknown";
+    }
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
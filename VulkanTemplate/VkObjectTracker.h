@@ -0,0 +1,150 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <source_location>
+#include <type_traits>
+#include <unordered_map>
+#include <Volk/volk.h>
+
+//---------------------------------------------------------------------------
+class VkObjectTracker;
+std::unique_ptr<VkObjectTracker>& getVkObjectTracker();
+
+//---------------------------------------------------------------------------
+/*
+ * VulkanIuWFNg̐ԂƃʂL^gbJ[
+ * /j̉ӏ onCreate / onDestroy ĂяoĎg
+ */
+class VkObjectTracker
+{
+public:
+	// ԂƂ݂Ȃ܂ł̃t[
+	static constexpr uint32_t sWarmupFrames = 120;
+
+	struct TypeStats
+	{
+		uint32_t liveCount = 0;
+		uint64_t liveBytes = 0;
+		uint32_t createdThisFrame = 0;
+		uint32_t destroyedThisFrame = 0;
+	};
+
+	struct ObjectInfo
+	{
+		VkObjectType type = VK_OBJECT_TYPE_UNKNOWN;
+		uint64_t bytes = 0;
+		uint64_t createdFrame = 0;
+		std::source_location site;
+		std::string name;
+		bool isExempt = false;
+	};
+
+	/*
+	 * zbg[h񓯊RpCAeʂ̊gȂǁAԂłӐ}Đ̂
+	 * ̊ԂuĂƒԂ̃`FbNO (uXbhł̂ݗL)
+	 */
+	class SteadyStateExemption
+	{
+	public:
+		SteadyStateExemption();
+		~SteadyStateExemption();
+		SteadyStateExemption(const SteadyStateExemption&) = delete;
+		SteadyStateExemption& operator=(const SteadyStateExemption&) = delete;
+	};
+
+public:
+	/*
+	 * IuWFNg̐/jL^
+	 * bytes ̓ʂ(VkDeviceMemory)̂ݎw肷
+	 */
+	template<typename T>
+	void onCreate(T handle, VkObjectType type, uint64_t bytes = 0, std::source_location site = std::source_location::current())
+	{
+		onCreateImpl_(toHandle_(handle), type, bytes, site);
+	}
+	template<typename T>
+	void onDestroy(T handle, VkObjectType type)
+	{
+		onDestroyImpl_(toHandle_(handle), type);
+	}
+
+	/*
+	 * GfxDevice::setObjectName ŕtO|[gpɕێ
+	 */
+	void setName(uint64_t handle, const char* name, VkObjectType type);
+
+	/*
+	 * t[E̒ʒm
+	 * Ԃ̃t[ŃIuWFNgꂽꍇAsetThrowOnViolation LȂO𓊂
+	 */
+	void beginFrame();
+	void endFrame();
+
+	/*
+	 * Ԃł̐Oɂ邩 (ł NDEBUG łȂrĥ)
+	 * [Xrh̃\[NeXgłoꍇɗLɂ
+	 */
+	void setThrowOnViolation(bool isEnabled);
+
+	/*
+	 * Xbv`FCĐȂǁAӐ}IɃIuWFNg蒼ꍇɌĂ
+	 */
+	void resetSteadyState();
+
+	void drawImGui();
+	void reportLiveObjects();
+
+	uint64_t getLiveBytes(VkObjectType type);
+	uint32_t getLiveCount();
+
+	static const char* getTypeName(VkObjectType type);
+
+private:
+	template<typename T>
+	static uint64_t toHandle_(T handle)
+	{
+		if constexpr (std::is_pointer_v<T>)
+		{
+			return uint64_t(reinterpret_cast<uintptr_t>(handle));
+		}
+		else
+		{
+			return uint64_t(handle);
+		}
+	}
+
+	void onCreateImpl_(uint64_t handle, VkObjectType type, uint64_t bytes, const std::source_location& site);
+	void onDestroyImpl_(uint64_t handle, VkObjectType type);
+
+private:
+	std::mutex mMutex;
+	// fBXpb`unh͌^ႦΒld邽ߌ^ƑgŊǗ
+	struct ObjectKey
+	{
+		uint64_t handle;
+		VkObjectType type;
+		bool operator==(const ObjectKey&) const = default;
+	};
+	struct ObjectKeyHash
+	{
+		size_t operator()(const ObjectKey& key) const
+		{
+			return std::hash<uint64_t>()(key.handle) ^ (size_t(key.type) << 1);
+		}
+	};
+	std::unordered_map<ObjectKey, ObjectInfo, ObjectKeyHash> mObjects;
+	std::unordered_map<VkObjectType, TypeStats> mTypeStats;
+
+	uint64_t mFrameIndex = 0;
+	uint64_t mSteadyStateFrame = sWarmupFrames;
+	uint32_t mCreatedThisFrame = 0;
+	uint32_t mExemptThisFrame = 0;
+	uint32_t mDestroyedThisFrame = 0;
+#ifdef NDEBUG
+	bool mThrowOnViolation = false;
+#else
+	bool mThrowOnViolation = true;
+#endif
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "WorkerGroup.h"
+
+//---------------------------------------------------------------------------
+WorkerGroup::~WorkerGroup()
+{
+    stop();
+}
+//---------------------------------------------------------------------------
+void WorkerGroup::start(uint32_t workerCount)
+{
+    stop();
+
+    mIsRunning = true;
+    for (uint32_t i = 0; i < workerCount; ++i)
+    {
+        mWorkers.emplace_back([this]() { workerThread_(); });
+    }
+}
+//---------------------------------------------------------------------------
+void WorkerGroup::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsRunning = false;
+    }
+    mStartCondition.notify_all();
+    for (auto& worker : mWorkers)
+    {
+        worker.join();
+    }
+    mWorkers.clear();
+}
+//---------------------------------------------------------------------------
+void WorkerGroup::run(uint32_t taskCount, const Task& task)
+{
+    if (taskCount == 0)
+    {
+        return;
+    }
+    // [J[΂̃Xbhŏɏ
+    if (mWorkers.empty())
+    {
+        for (uint32_t i = 0; i < taskCount; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTask = &task;
+        mTaskCount = taskCount;
+        mNextTask = 0;
+        mFinishedCount = 0;
+        mGeneration++;
+    }
+    mStartCondition.notify_all();
+    processTasks_();
+
+    // ̃Xbh̃^XN҂ (task ͌Ăяô̂Ȃ̂ŁA߂OɎQƂO)
+    std::unique_lock<std::mutex> lock(mMutex);
+    mFinishCondition.wait(lock, [this]() { return mFinishedCount == mTaskCount; });
+    mTask = nullptr;
+}
+//---------------------------------------------------------------------------
+void WorkerGroup::processTasks_()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (mTask != nullptr && mNextTask < mTaskCount)
+    {
+        const Task* task = mTask;
+        const uint32_t index = mNextTask++;
+        lock.unlock();
+        (*task)(index);
+        lock.lock();
+        if (++mFinishedCount == mTaskCount)
+        {
+            mFinishCondition.notify_one();
+        }
+    }
+}
+//---------------------------------------------------------------------------
+void WorkerGroup::workerThread_()
+{
+    uint64_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mStartCondition.wait(lock, [this, generation]() { return !mIsRunning || mGeneration != generation; });
+            if (!mIsRunning)
+            {
+                return;
+            }
+            generation = mGeneration;
+        }
+        processTasks_();
+    }
+}
+//---------------------------------------------------------------------------
\ No newline at end of file
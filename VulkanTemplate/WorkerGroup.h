@@ -0,0 +1,53 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//---------------------------------------------------------------------------
+/*
+ * t[̕񏈗Ɏg풓̃[J[Xbh
+ * Xbh start 1xArun ̓xɏϐŋNđSẴ^XNI܂ő҂ (fork/join)
+ */
+class WorkerGroup
+{
+public:
+	// ^XN̔ԍ (0  taskCount - 1) 󂯎
+	using Task = std::function<void(uint32_t index)>;
+
+public:
+	~WorkerGroup();
+
+	void start(uint32_t workerCount);
+	void stop();
+
+	/*
+	 * task ^XN̔ԍ1񂸂ĂсASďIĂ߂
+	 * ĂяoXbh^XNBrun 𓯎ɌĂׂ̂1̃Xbh
+	 */
+	void run(uint32_t taskCount, const Task& task);
+
+	inline uint32_t getWorkerCount() const { return static_cast<uint32_t>(mWorkers.size()); }
+
+private:
+	void workerThread_();
+	// cĂ^XNoď
+	void processTasks_();
+
+private:
+	std::vector<std::thread> mWorkers;
+	std::mutex mMutex;
+	std::condition_variable mStartCondition;
+	std::condition_variable mFinishCondition;
+	bool mIsRunning = false;
+
+	// s run ̓e (mGeneration iނƃ[J[N)
+	const Task* mTask = nullptr;
+	uint32_t mTaskCount = 0;
+	uint32_t mNextTask = 0;
+	uint32_t mFinishedCount = 0;
+	uint64_t mGeneration = 0;
+};
+//---------------------------------------------------------------------------
\ No newline at end of file
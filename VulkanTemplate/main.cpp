@@ -1,24 +1,86 @@
 #include "Application.h"
 #include "Window.h"
+#include "GfxDevice.h"
+#include "StartupProfiler.h"
+#include "Metrics.h"
+#include "DrawQueue.h"
+#include "VkObjectTracker.h"
+#include <cstring>
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 
+//---------------------------------------------------------------------------
+static bool hasCommandLineOption(LPSTR cmdLine, const char* option)
+{
+	return cmdLine != nullptr && strstr(cmdLine, option) != nullptr;
+}
+//---------------------------------------------------------------------------
+
 int __stdcall WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
 {
 	// gpϐ̌x}
 	UNREFERENCED_PARAMETER(hPrevInstance);
-	UNREFERENCED_PARAMETER(lpCmdLine);
+
+	// NԂ̌v̓vZXJnォ
+	auto& profiler = getStartupProfiler();
+
+	// --startup-benchmark: 1t[`悵I
+	const bool startup_benchmark = hasCommandLineOption(lpCmdLine, "--startup-benchmark");
+
+	// --sort-benchmark: `L[ 100 ̕בւ̎ԂvďI (foCX͍Ȃ)
+	if (hasCommandLineOption(lpCmdLine, "--sort-benchmark"))
+	{
+		DrawQueue::runSortBenchmark(1000000);
+		return 0;
+	}
+
+	// --metrics-prom / --metrics-csv: gNXIɃt@C֏o͂
+	auto& metrics = getMetricsRegistry();
+	if (hasCommandLineOption(lpCmdLine, "--metrics-prom"))
+	{
+		metrics->startExport("metrics.prom", MetricsRegistry::ExportFormat::Prometheus, std::chrono::seconds(1));
+	}
+	else if (hasCommandLineOption(lpCmdLine, "--metrics-csv"))
+	{
+		metrics->startExport("metrics.csv", MetricsRegistry::ExportFormat::Csv, std::chrono::seconds(1));
+	}
+
+	// --strict-steady-state: [XrhłԂł̃IuWFNg̐Oɂ
+	if (hasCommandLineOption(lpCmdLine, "--strict-steady-state"))
+	{
+		getVkObjectTracker()->setThrowOnViolation(true);
+	}
 
 	auto app = std::make_unique<Application>();
+	// --shader-object: V[pCvCł͂Ȃ VK_EXT_shader_object ŕ`悷
+	app->requestShaderObject(hasCommandLineOption(lpCmdLine, "--shader-object"));
+	// --descriptor-buffer: oChX̃fBXNv^v[ł͂Ȃ VK_EXT_descriptor_buffer ɒu
+	app->requestDescriptorBuffer(hasCommandLineOption(lpCmdLine, "--descriptor-buffer"));
+	// --vertex-pull: V[̒_𒸓_͂ł͂Ȃobt@̃foCXAhXǂ
+	app->requestVertexPulling(hasCommandLineOption(lpCmdLine, "--vertex-pull"));
 	app->Initialize();
 
 	auto& window = getAppWindow();
-	while (!window->getIsExitRequired()) {
+	{
+		profiler->beginPhase("first_frame");
+		window->processMessages();
+		app->process();
+		if (startup_benchmark)
+		{
+			// GPŮ܂ł1t[ڂɊ܂߂
+			getGfxDevice()->waitForIdle();
+		}
+		profiler->endPhase();
+	}
+	profiler->finish(startup_benchmark);
+
+	while (!startup_benchmark && !window->getIsExitRequired()) {
 		window->processMessages();
 		app->process();
 	}
 
 	app->Shutdown();
+	metrics->stopExport();
 	return 0;
 }
@@ -0,0 +1,42 @@
+# SPIR-V を constexpr uint32_t の配列として C++ のソースに埋め込む
+# 使い方: cmake -DOUTPUT=<出力する .inl> -DSPIRV_FILES=<a.spv|b.spv|...> -P EmbedSpirv.cmake
+#         cmake -DOUTPUT=<出力する .inl> -DSPIRV_DIR=<.spv のあるディレクトリ> -P EmbedSpirv.cmake
+# 生成したファイルは ShaderSource.cpp が include する
+# Visual Studio のプロジェクトはビルド前イベントで compileShader.bat の後に SPIRV_DIR で呼ぶ
+
+# リストは | 区切りで受け取る (コマンドラインで ; が分割されないように)
+string(REPLACE "|" ";" SPIRV_FILES "${SPIRV_FILES}")
+if(SPIRV_DIR)
+  file(GLOB DIR_SPIRV_FILES "${SPIRV_DIR}/*.spv")
+  list(SORT DIR_SPIRV_FILES)
+  list(APPEND SPIRV_FILES ${DIR_SPIRV_FILES})
+endif()
+
+set(CONTENT "// cmake/EmbedSpirv.cmake が生成したファイル (編集しないこと)\n\n")
+set(TABLE "")
+set(INDEX 0)
+foreach(SPIRV ${SPIRV_FILES})
+  get_filename_component(NAME ${SPIRV} NAME)
+  file(READ ${SPIRV} HEX HEX)
+  # SPIR-V はリトルエンディアンの 32bit ワード列
+  string(REGEX REPLACE "([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])([0-9a-f][0-9a-f])" "0x\\4\\3\\2\\1u," WORDS "${HEX}")
+  # 8 ワード毎に改行する (CMake の正規表現は {n} を使えないので並べて書く)
+  set(LINE "")
+  foreach(I RANGE 7)
+    string(APPEND LINE "0x[0-9a-f]+u,")
+  endforeach()
+  string(REGEX REPLACE "(${LINE})" "\\1\n    " WORDS "${WORDS}")
+  string(APPEND CONTENT "// ${NAME}\nalignas(16) static constexpr uint32_t sEmbeddedShader${INDEX}[] = {\n    ${WORDS}\n};\n")
+  # 実行時に参照するパスに合わせる
+  string(APPEND TABLE "    EmbeddedShader{ \"res/${NAME}\", sEmbeddedShader${INDEX} },\n")
+  math(EXPR INDEX "${INDEX} + 1")
+endforeach()
+
+# シェーダーが無くても出力は必ず書く (書かないとカスタムコマンドが毎回のビルドで再実行される)
+# 要素数 0 の配列は作れないので、その場合は空の span にする
+if(INDEX GREATER 0)
+  string(APPEND CONTENT "\nstatic constexpr EmbeddedShader sEmbeddedShaderTable[] = {\n${TABLE}};\n")
+else()
+  string(APPEND CONTENT "static constexpr std::span<const EmbeddedShader> sEmbeddedShaderTable;\n")
+endif()
+file(WRITE ${OUTPUT} "${CONTENT}")
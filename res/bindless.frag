@@ -0,0 +1,39 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+// oChX (BindlessDescriptors ̃oCfBOԍƍ킹邱)
+layout(set = 0, binding = 0) uniform texture2D textures[];
+layout(set = 0, binding = 1) uniform sampler samplers[];
+
+// `斈ɎQƂ郊\[X̔ԍ (BindlessDrawConstants ƍ킹邱)
+layout(push_constant) uniform DrawConstants {
+    uint textureIndex;
+    uint samplerIndex;
+    uint bufferIndex;
+} draw;
+
+// oAg (MainShaderPermutation  constant_id 킹邱)
+layout(constant_id = 0) const bool USE_TEXTURE = true;
+layout(constant_id = 1) const bool USE_VERTEX_COLOR = true;
+layout(constant_id = 2) const bool USE_ALPHA_TEST = false;
+layout(constant_id = 3) const float ALPHA_CUTOFF = 0.5;
+
+void main() {
+    vec4 color = vec4(1.0);
+    if (USE_VERTEX_COLOR) {
+        color.rgb = fragColor;
+    }
+    if (USE_TEXTURE) {
+        // ԍ̓vbV萔Ȃ̂ŕ`ł͈lACX^Xɕςꍇɔ nonuniformEXT t
+        color *= texture(sampler2D(textures[nonuniformEXT(draw.textureIndex)], samplers[nonuniformEXT(draw.samplerIndex)]), fragTexCoord);
+    }
+    if (USE_ALPHA_TEST && color.a < ALPHA_CUTOFF) {
+        discard;
+    }
+    outColor = color;
+}
\ No newline at end of file
@@ -7,5 +7,8 @@ for %%f in (*.*) do (
   if "%%~xf"==".frag" (
     glslangValidator -S frag %%~f --target-env vulkan1.0 -o %%~f.spv
   )
+  if "%%~xf"==".comp" (
+    glslangValidator -S comp %%~f --target-env vulkan1.0 -o %%~f.spv
+  )
 )
 @echo on
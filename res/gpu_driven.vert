@@ -0,0 +1,46 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+// SẴIuWFNgŋLlp` (_)
+layout(location = 0) in vec2 inCorner;
+layout(location = 1) in vec2 inTexCoord;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uvec2 fragTextureSampler;
+
+// GpuDrivenScene.h  GpuDrawObject ƍ킹邱
+struct DrawObject {
+    vec4 boundingSphere;
+    vec4 positionScale;
+    uint indexCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint color;
+    uint textureIndex;
+    uint samplerIndex;
+    uint mesh;  // GeometryPool ̃bV (VF[_[ł͎gȂ)
+    uint padding;
+};
+
+// oChX (BindlessDescriptors ̃oCfBOԍƍ킹邱)
+layout(std430, set = 0, binding = 2) readonly buffer SceneBuffer {
+    mat4 viewProj;
+    DrawObject objects[];
+} scenes[];
+
+layout(push_constant) uniform DrawConstants {
+    uint textureIndex;
+    uint samplerIndex;
+    uint bufferIndex;
+} draw;
+
+void main() {
+    // JÕVF[_[ firstInstance ɃIuWFNg̔ԍĂ
+    DrawObject object = scenes[draw.bufferIndex].objects[gl_InstanceIndex];
+    vec2 world = object.positionScale.xy + inCorner * object.positionScale.zw;
+    gl_Position = scenes[draw.bufferIndex].viewProj * vec4(world, 0.0, 1.0);
+    fragColor = unpackUnorm4x8(object.color);
+    fragTexCoord = inTexCoord;
+    fragTextureSampler = uvec2(object.textureIndex, object.samplerIndex);
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#version 450
+
+layout(set = 0, binding = 0, r32ui) uniform readonly uimage2D overdrawCounter;
+layout(set = 0, binding = 1) buffer OverdrawStats {
+    uint maxCount;
+    uint totalCount;
+    uint coveredPixels;
+} stats;
+
+layout(push_constant) uniform HeatmapParams {
+    float maxScale;
+    float opacity;
+} params;
+
+layout(location = 0) out vec4 outColor;
+
+//  -> VA ->  ->  -> 
+vec3 colorRamp(float t) {
+    const vec3 colors[5] = vec3[](
+        vec3(0.0, 0.0, 1.0),
+        vec3(0.0, 1.0, 1.0),
+        vec3(0.0, 1.0, 0.0),
+        vec3(1.0, 1.0, 0.0),
+        vec3(1.0, 0.0, 0.0));
+    float x = clamp(t, 0.0, 1.0) * 4.0;
+    int i = min(int(x), 3);
+    return mix(colors[i], colors[i + 1], x - float(i));
+}
+
+void main() {
+    uint count = imageLoad(overdrawCounter, ivec2(gl_FragCoord.xy)).r;
+
+    atomicMax(stats.maxCount, count);
+    atomicAdd(stats.totalCount, count);
+    if (count == 0u) {
+        discard;
+    }
+    atomicAdd(stats.coveredPixels, 1u);
+
+    float t = float(count - 1u) / max(params.maxScale - 1.0, 1.0);
+    outColor = vec4(colorRamp(t), params.opacity);
+}
@@ -0,0 +1,8 @@
+#version 450
+
+// I[o[h[vp: J[o͂̑ɃsNZ̎s񐔂Z
+layout(set = 1, binding = 0, r32ui) uniform coherent uimage2D overdrawCounter;
+
+void main() {
+    imageAtomicAdd(overdrawCounter, ivec2(gl_FragCoord.xy), 1u);
+}
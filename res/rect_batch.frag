@@ -0,0 +1,17 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) flat in uvec2 fragTextureSampler;
+
+layout(location = 0) out vec4 outColor;
+
+// oChX (BindlessDescriptors ̃oCfBOԍƍ킹邱)
+layout(set = 0, binding = 0) uniform texture2D textures[];
+layout(set = 0, binding = 1) uniform sampler samplers[];
+
+void main() {
+    // 1̕`̒ŃCX^Xɔԍς̂ nonuniformEXT Kv
+    outColor = fragColor * texture(sampler2D(textures[nonuniformEXT(fragTextureSampler.x)], samplers[nonuniformEXT(fragTextureSampler.y)]), fragTexCoord);
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#version 450
+
+// SĂ̋`ŋLlp` (_)
+layout(location = 0) in vec2 inCorner;
+layout(location = 1) in vec2 inTexCoord;
+
+// ` (RectBatch.h  RectInstance ƍ킹邱)
+layout(location = 2) in vec4 inPositionSize;
+layout(location = 3) in float inRotation;
+layout(location = 4) in vec4 inColor;
+layout(location = 5) in uvec2 inTextureSampler;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uvec2 fragTextureSampler;
+
+void main() {
+    // 傫|Ă]ASɈڂ
+    float s = sin(inRotation);
+    float c = cos(inRotation);
+    vec2 local = inCorner * inPositionSize.zw;
+    vec2 rotated = vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+    gl_Position = vec4(inPositionSize.xy + rotated, 0.0, 1.0);
+    fragColor = inColor;
+    fragTexCoord = inTexCoord;
+    fragTextureSampler = inTextureSampler;
+}
\ No newline at end of file
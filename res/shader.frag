@@ -6,7 +6,23 @@ layout(location = 1) in vec2 fragTexCoord;
 layout(location = 0) out vec4 outColor;
 layout(binding = 1) uniform sampler2D texSampler;
 
-#texture(texSampler, fragTexCoord)
+// oAg (MainShaderPermutation  constant_id 킹邱)
+// pCvCɒ萔Ƃďݍ܂AgȂ͏
+layout(constant_id = 0) const bool USE_TEXTURE = true;
+layout(constant_id = 1) const bool USE_VERTEX_COLOR = true;
+layout(constant_id = 2) const bool USE_ALPHA_TEST = false;
+layout(constant_id = 3) const float ALPHA_CUTOFF = 0.5;
+
 void main() {
-    vec4(fragColor, 1.0);
+    vec4 color = vec4(1.0);
+    if (USE_VERTEX_COLOR) {
+        color.rgb = fragColor;
+    }
+    if (USE_TEXTURE) {
+        color *= texture(texSampler, fragTexCoord);
+    }
+    if (USE_ALPHA_TEST && color.a < ALPHA_CUTOFF) {
+        discard;
+    }
+    outColor = color;
 }
\ No newline at end of file
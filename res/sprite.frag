@@ -0,0 +1,22 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+// oChX (BindlessDescriptors ̃oCfBOԍƍ킹邱)
+layout(set = 0, binding = 0) uniform texture2D textures[];
+layout(set = 0, binding = 1) uniform sampler samplers[];
+
+// eNX`XvCg܂Ƃ߂ĕ`̂ŁAԍ͕`斈̃vbV萔œn (BindlessDrawConstants ƍ킹邱)
+layout(push_constant) uniform DrawConstants {
+    uint textureIndex;
+    uint samplerIndex;
+    uint bufferIndex;
+} draw;
+
+void main() {
+    outColor = fragColor * texture(sampler2D(textures[draw.textureIndex], samplers[draw.samplerIndex]), fragTexCoord);
+}
\ No newline at end of file
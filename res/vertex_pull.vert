@@ -0,0 +1,62 @@
+#version 450
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_buffer_reference_uvec2 : require
+
+// _͂AvbV萔̃AhX璸_ǂ (_v)
+// _̌`̓vbV萔œn̂ŁA_̌`̃pCvC͗vȂ
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+
+// _̃f[^ 4 oCgPʂœǂ (AhXƒ_̑傫 4 ̔{ł邱)
+layout(buffer_reference, std430, buffer_reference_align = 4) readonly buffer VertexWords {
+    uint words[];
+};
+
+// VertexStream ƍ킹邱 (AhX͉ʂƏʂ 32 rbg)
+struct VertexStream {
+    uvec2 address;
+    uint stride;
+    uint format;
+};
+
+// VertexPullConstants ƍ킹邱 (擪 BindlessDrawConstants)
+layout(push_constant) uniform PullConstants {
+    uint textureIndex;
+    uint samplerIndex;
+    uint bufferIndex;
+    uint padding;
+    VertexStream position;
+    VertexStream color;
+    VertexStream texcoord;
+} draw;
+
+// VertexStreamFormat ƍ킹邱
+const uint FORMAT_FLOAT2 = 0;
+const uint FORMAT_FLOAT3 = 1;
+const uint FORMAT_HALF2 = 2;
+const uint FORMAT_UNORM8X4 = 3;
+
+vec4 fetchAttribute(VertexStream stream, uint vertexIndex) {
+    VertexWords vertex = VertexWords(stream.address);
+    uint base = vertexIndex * (stream.stride / 4);
+    // `͕`ňlȂ̂ŁA͔UȂ
+    switch (stream.format) {
+    case FORMAT_FLOAT2:
+        return vec4(uintBitsToFloat(vertex.words[base]), uintBitsToFloat(vertex.words[base + 1]), 0.0, 1.0);
+    case FORMAT_FLOAT3:
+        return vec4(uintBitsToFloat(vertex.words[base]), uintBitsToFloat(vertex.words[base + 1]), uintBitsToFloat(vertex.words[base + 2]), 1.0);
+    case FORMAT_HALF2:
+        return vec4(unpackHalf2x16(vertex.words[base]), 0.0, 1.0);
+    default:
+        return unpackUnorm4x8(vertex.words[base]);
+    }
+}
+
+void main() {
+    // CfbNXt̕`ł vertexOffset ꂽԍɂȂ
+    uint vertexIndex = uint(gl_VertexIndex);
+    gl_Position = vec4(fetchAttribute(draw.position, vertexIndex).xy, 0.0, 1.0);
+    fragColor = fetchAttribute(draw.color, vertexIndex).rgb;
+    fragTexCoord = fetchAttribute(draw.texcoord, vertexIndex).xy;
+}
\ No newline at end of file